@@ -0,0 +1,104 @@
+/********************************************************************************************************************
+ * @file clock_barrier_bench.cpp
+ * @brief 仿真时钟步进屏障基准测试
+ *
+ * 对比 SimulationClock 的两种屏障实现（Mutex / SpinWait）在 2~16 个参与线程下的每秒步数。
+ * 每个参与线程只做"等待下一步 → 通知完成"，即测量的是纯屏障开销的上限吞吐。
+ *
+ * 编译与运行（在 Benchmarks 目录下）：
+ *   g++ -std=c++20 -O2 -pthread -I../include clock_barrier_bench.cpp -o clock_barrier_bench
+ *   ./clock_barrier_bench [每组测量秒数，默认1.0]
+ *
+ * C++17 下 SpinWait 模式退化为自旋 + yield，结果仅供参考。
+ ********************************************************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+#include "../include/L_Simulation_Settings/simulation_clock.hpp"
+
+using BarrierMode = SimulationClock::BarrierMode;
+
+// 运行一组测量，返回每秒步数
+static double measureStepsPerSecond(BarrierMode mode, int participants, double seconds) {
+    auto& clock = SimulationClock::getInstance();
+    clock.setBarrierMode(mode);
+    clock.setLatencyTracking(false);   // 只测屏障本身，不计每步的延迟记录开销
+
+    std::thread clock_thread([&clock]() {
+        ThreadNaming::set_current_thread_name("SimulationClock");
+        clock.start();
+    });
+    while (!clock.isRunning()) {
+        std::this_thread::yield();
+    }
+
+    std::atomic<int> ready{0};
+    std::vector<std::thread> workers;
+    for (int i = 0; i < participants; ++i) {
+        workers.emplace_back([&clock, &ready, i]() {
+            ThreadNaming::set_current_thread_name("BenchWorker" + std::to_string(i));
+            clock.registerThread();
+            size_t current_step = 0; // 与仿真组件一致：注册后先处理时钟当前所在的步
+
+            ready.fetch_add(1);
+            while (clock.isRunning()) {
+                clock.waitForNextStep(current_step);
+                current_step = clock.getStepCount();
+                if (!clock.isRunning()) break;
+                clock.notifyStepCompleted();
+            }
+            clock.unregisterThread();
+        });
+    }
+    while (ready.load() < participants) {
+        std::this_thread::yield();
+    }
+
+    // 预热后再计时
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const int start_steps = clock.getStepCount();
+    const auto t0 = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    const int end_steps = clock.getStepCount();
+    const auto t1 = std::chrono::steady_clock::now();
+
+    clock.stop();
+    clock_thread.join();
+    for (auto& w : workers) w.join();
+
+    const double elapsed = std::chrono::duration<double>(t1 - t0).count();
+    return (end_steps - start_steps) / elapsed;
+}
+
+int main(int argc, char** argv) {
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 1.0;
+
+    // 基准测试不需要逐步日志
+    Logger::getInstance().disable();
+
+    std::cout << "硬件线程数: " << std::thread::hardware_concurrency()
+              << ", 每组测量: " << seconds << "s" << std::endl;
+    std::cout << std::left << std::setw(14) << "participants"
+              << std::setw(18) << "mutex steps/s"
+              << std::setw(18) << "spin steps/s"
+              << "speedup" << std::endl;
+
+    for (int participants : {2, 4, 8, 16}) {
+        double mutex_rate = measureStepsPerSecond(BarrierMode::Mutex, participants, seconds);
+        double spin_rate = measureStepsPerSecond(BarrierMode::SpinWait, participants, seconds);
+        std::cout << std::left << std::fixed << std::setprecision(0)
+                  << std::setw(14) << participants
+                  << std::setw(18) << mutex_rate
+                  << std::setw(18) << spin_rate
+                  << std::setprecision(2) << (mutex_rate > 0 ? spin_rate / mutex_rate : 0.0) << "x"
+                  << std::endl;
+    }
+    return 0;
+}
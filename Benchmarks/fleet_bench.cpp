@@ -0,0 +1,116 @@
+/********************************************************************************************************************
+ * @file fleet_bench.cpp
+ * @brief 多机结构数组状态（FleetState）基准测试
+ *
+ * 对 1、100、10000 架飞机分别测量：
+ *   - 每架飞机占用的内存：FleetState 每架的列元素字节数与实际分配字节数，
+ *     对比每架飞机一个 SharedStateSpace（原单机状态空间）的 sizeof
+ *   - 每步耗时：
+ *       per-aircraft : 每架飞机一个 SharedStateSpace，逐架调用虚函数 propagate（内部虚调用力学模型）
+ *                      并把结果写回该机的状态原子变量（原单机路径，不含步屏障）
+ *       fleet        : 一次 stepFleet 推进整个机队（力学模型与动力学模型各对各列顺序扫描一次）
+ * 两条路径使用相同的单机公式，测量结束后核对两者的位置、速度逐位一致。
+ *
+ * 编译与运行（在 Benchmarks 目录下）：
+ *   g++ -std=c++17 -O2 -pthread -I../include fleet_bench.cpp -o fleet_bench
+ *   ./fleet_bench [每组的飞机·步总数，默认 20000000]
+ ********************************************************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+
+#include "../include/D_DynamicModel/DynamicsModel_FixedWing_Linear.hpp"
+#include "../include/A_Aircraft_Configuration/AircraftConfig_FixedWin_AC1.hpp"
+#include "../include/A_Aircraft_Configuration/AircraftConfig_FixedWin_AC2.hpp"
+
+constexpr double kTimeStep = 0.01;
+
+// 第 i 架飞机的初始状态：速度、油门、刹车各不相同，部分飞机静止（走静摩擦分支）
+static void initialState(size_t i, double& velocity, double& throttle, double& brake) {
+    velocity = (i % 5 == 0) ? 0.0 : 5.0 + static_cast<double>(i % 60);
+    throttle = (i % 3 == 0) ? 0.0 : 0.2 + 0.1 * static_cast<double>(i % 7);
+    brake = (i % 4 == 0) ? 0.6 : 0.0;
+}
+
+int main(int argc, char** argv) {
+    const size_t work = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+    std::vector<std::shared_ptr<AircraftConfigBase>> configs = {
+        std::make_shared<AircraftConfig_FixedWin_AC1>(), std::make_shared<AircraftConfig_FixedWin_AC2>()};
+    auto forceModel = std::make_shared<ACForceModel>();
+    DynamicsModel_FixedWing_Linear dynamics;
+    const IDynamicsModel& dynamics_interface = dynamics;
+
+    std::cout << "FleetState 每架字节数: " << FleetState::bytesPerAircraft()
+              << ", sizeof(SharedStateSpace): " << sizeof(SharedStateSpace) << std::endl;
+    std::cout << std::left << std::setw(10) << "aircraft"
+              << std::setw(10) << "steps"
+              << std::setw(18) << "fleet B/aircraft"
+              << std::setw(22) << "per-aircraft ns/step"
+              << std::setw(16) << "fleet ns/step"
+              << std::setw(24) << "fleet ns/aircraft-step"
+              << std::setw(10) << "speedup"
+              << "match" << std::endl;
+
+    for (size_t n : {size_t{1}, size_t{100}, size_t{10000}}) {
+        const size_t steps = std::max<size_t>(work / n, 10);
+
+        FleetState fleet(n);
+        std::vector<std::unique_ptr<SharedStateSpace>> states;
+        for (size_t i = 0; i < n; ++i) {
+            const auto& config = configs[i % configs.size()];
+            const size_t id = fleet.addAircraft(*config);
+            double velocity, throttle, brake;
+            initialState(i, velocity, throttle, brake);
+            fleet.at(StateField::Velocity, id) = velocity;
+            fleet.at(StateField::Throttle, id) = throttle;
+            fleet.at(StateField::Brake, id) = brake;
+            states.push_back(std::make_unique<SharedStateSpace>());
+            states.back()->velocity.store(velocity);
+            states.back()->throttle.store(throttle);
+            states.back()->brake.store(brake);
+        }
+
+        // 原单机路径：逐架虚调用 propagate，并写回该机的状态
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t step = 0; step < steps; ++step) {
+            for (size_t i = 0; i < n; ++i) {
+                SharedStateSpace& state = *states[i];
+                const DynamicsStepResult r = dynamics_interface.propagate(state, kTimeStep, configs[i % configs.size()], forceModel);
+                state.position.store(r.position, std::memory_order_release);
+                state.velocity.store(r.velocity, std::memory_order_release);
+                state.acceleration.store(r.acceleration, std::memory_order_release);
+                state.thrust.store(r.forces.thrust, std::memory_order_release);
+                state.drag_force.store(r.forces.drag, std::memory_order_release);
+                state.brake_force.store(r.forces.brake_force, std::memory_order_release);
+            }
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+
+        // 机队路径
+        for (size_t step = 0; step < steps; ++step) dynamics_interface.stepFleet(fleet, kTimeStep, *forceModel);
+        const auto t2 = std::chrono::steady_clock::now();
+
+        bool match = true;
+        for (size_t i = 0; i < n; ++i) {
+            match = match && fleet.at(StateField::Position, i) == states[i]->position.load()
+                          && fleet.at(StateField::Velocity, i) == states[i]->velocity.load();
+        }
+
+        const double per_aircraft_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / steps;
+        const double fleet_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / steps;
+        std::cout << std::left << std::fixed << std::setprecision(1)
+                  << std::setw(10) << n
+                  << std::setw(10) << steps
+                  << std::setw(18) << static_cast<double>(fleet.allocatedBytes()) / n
+                  << std::setw(22) << per_aircraft_ns
+                  << std::setw(16) << fleet_ns
+                  << std::setw(24) << std::setprecision(2) << fleet_ns / n
+                  << std::setw(10) << (fleet_ns > 0 ? per_aircraft_ns / fleet_ns : 0.0)
+                  << (match ? "yes" : "NO") << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,183 @@
+/********************************************************************************************************************
+ * @file force_pipeline_bench.cpp
+ * @brief 编译期组合力学流水线（ForcePipeline）基准测试
+ *
+ * 对比每步力学计算的耗时（ns/step），分两种负载：
+ *   - trajectory : 单架飞机循环加速、刹车，每步速度取决于上一步的合外力（调用之间有数据依赖，
+ *                  耗时以依赖链延迟为主，接近单机仿真的实际情况）
+ *   - sweep      : 对一组预先给定的速度、油门、刹车逐个求合外力并累加（调用之间相互独立，
+ *                  耗时以每次调用的指令开销为主）
+ * 每种负载下比较：
+ *   - virtual : 经 IForceModel 指针虚调用 calculateNetForce（按值传 shared_ptr 构型、构型参数虚 getter、
+ *               从状态空间原子读取油门和刹车）——原单机路径，即 PipelineForceModel 适配器
+ *   - inline  : 直接调用 Pipeline::compute（构型参数按值预先取出，各项策略完全内联）
+ * 分别测量线性（ACForceModel / LinearForcePipeline）与非线性（ACForceModel_Nonlinear / NonlinearForcePipeline）模型，
+ * 另测加入滚动阻力项（RollingResistance<15>，μr = 0.015）后的内联流水线；
+ * virtual 与 inline 两条路径的最终速度、位置应逐位一致。
+ *
+ * 编译与运行（在 Benchmarks 目录下）：
+ *   g++ -std=c++17 -O2 -pthread -I../include force_pipeline_bench.cpp -o force_pipeline_bench
+ *   ./force_pipeline_bench [步数，默认 20000000]
+ ********************************************************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include "../include/B_Aircraft_Forces_Model/ACForceModel.hpp"
+#include "../include/A_Aircraft_Configuration/AircraftConfig_FixedWin_AC2.hpp"
+
+constexpr double kTimeStep = 0.01;
+constexpr size_t kCycle = 4000;   // 每个周期前一半加速、后一半刹车
+
+using RollingForcePipeline = ForcePipeline<ForceTerms::LinearThrust, ForceTerms::QuadraticDrag, ForceTerms::LinearBrake,
+                                           ForceTerms::RollingResistance<15>, ForceTerms::CoulombStaticFriction>;
+
+struct Trajectory {
+    double position = 0.0;
+    double velocity = 0.0;
+    double ns_per_step = 0.0;
+};
+
+constexpr size_t kSweepSize = 1024;
+
+struct SweepInput {
+    double throttle[kSweepSize];
+    double brake[kSweepSize];
+    double velocity[kSweepSize];
+};
+
+static SweepInput makeSweep() {
+    SweepInput in;
+    for (size_t i = 0; i < kSweepSize; ++i) {
+        in.throttle[i] = (i % 3 == 0) ? 0.0 : 0.1 * static_cast<double>(i % 10);
+        in.brake[i] = (i % 4 == 0) ? 0.7 : 0.0;
+        in.velocity[i] = (i % 9 == 0) ? 0.0 : 0.08 * static_cast<double>(i);
+    }
+    return in;
+}
+
+// 第 step 步的油门、刹车
+static void controls(size_t step, double& throttle, double& brake) {
+    const bool accelerating = step % kCycle < kCycle / 2;
+    throttle = accelerating ? 0.8 : 0.0;
+    brake = accelerating ? 0.0 : 0.8;
+}
+
+// 显式欧拉推进一步（速度不为负，与滑跑场景一致）
+static void advance(Trajectory& t, double net_force, double mass) {
+    t.position += t.velocity * kTimeStep;
+    t.velocity += net_force / mass * kTimeStep;
+    if (t.velocity < 0.0) t.velocity = 0.0;
+}
+
+static Trajectory runVirtual(IForceModel& model, const std::shared_ptr<AircraftConfigBase>& config, size_t steps) {
+    SharedStateSpace state;
+    Trajectory t;
+    const double mass = config->getMass();
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t step = 0; step < steps; ++step) {
+        double throttle, brake;
+        controls(step, throttle, brake);
+        state.throttle.store(throttle, std::memory_order_relaxed);
+        state.brake.store(brake, std::memory_order_relaxed);
+        const ForceResult r = model.calculateNetForce(state, t.velocity, config);
+        advance(t, r.net_force, mass);
+    }
+    t.ns_per_step = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / steps;
+    return t;
+}
+
+template <typename Pipeline>
+static Trajectory runInline(const AircraftParams& params, size_t steps) {
+    Trajectory t;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t step = 0; step < steps; ++step) {
+        double throttle, brake;
+        controls(step, throttle, brake);
+        const ForceResult r = Pipeline::compute(throttle, brake, t.velocity, params);
+        advance(t, r.net_force, params.mass);
+    }
+    t.ns_per_step = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / steps;
+    return t;
+}
+
+static Trajectory sweepVirtual(IForceModel& model, const std::shared_ptr<AircraftConfigBase>& config,
+                               const SweepInput& in, size_t steps) {
+    SharedStateSpace state;
+    Trajectory t;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t step = 0; step < steps; ++step) {
+        const size_t i = step % kSweepSize;
+        state.throttle.store(in.throttle[i], std::memory_order_relaxed);
+        state.brake.store(in.brake[i], std::memory_order_relaxed);
+        t.position += model.calculateNetForce(state, in.velocity[i], config).net_force;
+    }
+    t.ns_per_step = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / steps;
+    return t;
+}
+
+template <typename Pipeline>
+static Trajectory sweepInline(const AircraftParams& params, const SweepInput& in, size_t steps) {
+    Trajectory t;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t step = 0; step < steps; ++step) {
+        const size_t i = step % kSweepSize;
+        t.position += Pipeline::compute(in.throttle[i], in.brake[i], in.velocity[i], params).net_force;
+    }
+    t.ns_per_step = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / steps;
+    return t;
+}
+
+static void report(const std::string& name, const Trajectory& t, const Trajectory& reference) {
+    std::cout << std::left << std::fixed << std::setprecision(2)
+              << std::setw(22) << name
+              << std::setw(12) << t.ns_per_step
+              << std::setw(20) << (t.ns_per_step > 0 ? reference.ns_per_step / t.ns_per_step : 0.0)
+              << std::setprecision(1) << std::setw(16) << t.velocity << t.position << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const size_t steps = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+    const std::shared_ptr<AircraftConfigBase> config = std::make_shared<AircraftConfig_FixedWin_AC2>();
+    const AircraftParams params = AircraftParams::from(*config);
+    std::unique_ptr<IForceModel> linear = std::make_unique<ACForceModel>();
+    std::unique_ptr<IForceModel> nonlinear = std::make_unique<ACForceModel_Nonlinear>();
+
+    std::cout << "步数: " << steps << std::endl;
+    bool match = true;
+    for (bool sweep : {false, true}) {
+        const SweepInput in = makeSweep();
+        auto runV = [&](IForceModel& model) { return sweep ? sweepVirtual(model, config, in, steps) : runVirtual(model, config, steps); };
+        auto runI = [&](auto pipeline) {
+            using Pipeline = decltype(pipeline);
+            return sweep ? sweepInline<Pipeline>(params, in, steps) : runInline<Pipeline>(params, steps);
+        };
+
+        std::cout << (sweep ? "\n[sweep] 相互独立的调用（最终 x 为合外力累加和）" : "\n[trajectory] 前后步数据依赖") << std::endl;
+        std::cout << std::left << std::setw(22) << "path"
+                  << std::setw(12) << "ns/step"
+                  << std::setw(20) << "speedup vs virtual"
+                  << std::setw(16) << "final v (m/s)" << "final x" << std::endl;
+
+        const Trajectory linear_virtual = runV(*linear);
+        const Trajectory linear_inline = runI(LinearForcePipeline{});
+        const Trajectory nonlinear_virtual = runV(*nonlinear);
+        const Trajectory nonlinear_inline = runI(NonlinearForcePipeline{});
+        const Trajectory rolling_inline = runI(RollingForcePipeline{});
+
+        report("linear virtual", linear_virtual, linear_virtual);
+        report("linear inline", linear_inline, linear_virtual);
+        report("nonlinear virtual", nonlinear_virtual, nonlinear_virtual);
+        report("nonlinear inline", nonlinear_inline, nonlinear_virtual);
+        report("linear+rolling inline", rolling_inline, linear_virtual);
+
+        match = match && linear_virtual.position == linear_inline.position && linear_virtual.velocity == linear_inline.velocity
+                      && nonlinear_virtual.position == nonlinear_inline.position && nonlinear_virtual.velocity == nonlinear_inline.velocity;
+    }
+    std::cout << "\nvirtual 与 inline 逐位一致: " << (match ? "yes" : "NO") << std::endl;
+    return match ? 0 : 1;
+}
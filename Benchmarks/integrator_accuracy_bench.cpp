@@ -0,0 +1,114 @@
+/********************************************************************************************************************
+ * @file integrator_accuracy_bench.cpp
+ * @brief 积分方法（Integrator）精度与耗时基准测试
+ *
+ * 中止起飞的简化过程：AC2 构型、线性力学模型（ACForceModel），满油门滑跑 15 秒后收油门、全刹车，
+ * 速度降到 0.01 m/s 以下即停止，记录停止距离（停止时的位置）。
+ * 参考解为 RK45（容差 1e-12）以 0.001 秒步长推进的结果，各积分方法与参考解的停止距离之差即误差：
+ *   - ExplicitEuler      dt = 0.01（默认步长，原模型）
+ *   - SemiImplicitEuler  dt = 0.01
+ *   - RK4                dt = 0.1
+ *   - RK45（容差 1e-6） dt = 0.1
+ * 半隐式与显式欧拉的速度序列相同，位置之差累加后为 dt·(末速度 - 初速度)，由静止到停止时几乎为 0，
+ * 两者停止距离相同。
+ * 同时给出各自的步数与整次推进耗时，比较"大步长高阶方法"与"默认步长欧拉法"的精度和开销。
+ * 推进经 DynamicsModel_FixedWing_Linear::propagate，与场景中单机推进、事件定位的路径相同。
+ *
+ * 编译与运行（在 Benchmarks 目录下）：
+ *   g++ -std=c++17 -O2 -pthread -I../include integrator_accuracy_bench.cpp -o integrator_accuracy_bench
+ *   ./integrator_accuracy_bench [每种方法重复次数（计时用），默认 20]
+ ********************************************************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include "../include/D_DynamicModel/DynamicsModel_FixedWing_Linear.hpp"
+#include "../include/A_Aircraft_Configuration/AircraftConfig_FixedWin_AC2.hpp"
+
+constexpr double kBrakeTime = 15.0;      // 开始刹车的时刻（秒）
+constexpr double kStopVelocity = 0.01;   // 低于该速度视为停止（m/s）
+constexpr double kMaxTime = 120.0;       // 推进时间上限（秒）
+
+struct StopResult {
+    double distance = 0.0;   // 停止距离（m）
+    double time = 0.0;       // 停止时刻（秒）
+    size_t steps = 0;        // 推进步数
+};
+
+// 以给定积分方法和步长推进到停止
+static StopResult runToStop(const Integrator& integrator, double dt, const std::shared_ptr<AircraftConfigBase>& config,
+                            const std::shared_ptr<IForceModel>& forceModel) {
+    const DynamicsModel_FixedWing_Linear dynamics(integrator);
+    SharedStateSpace state;
+    state.position.store(0.0);
+    state.velocity.store(0.0);
+    state.throttle.store(1.0);
+    state.brake.store(0.0);
+
+    // 按步数切换，保证各步长都恰好在 15 秒处开始刹车
+    const size_t brake_step = static_cast<size_t>(std::lround(kBrakeTime / dt));
+    const size_t max_steps = static_cast<size_t>(std::lround(kMaxTime / dt));
+    StopResult result;
+    for (size_t step = 0; step < max_steps; ++step) {
+        if (step == brake_step) {
+            state.throttle.store(0.0);
+            state.brake.store(1.0);
+        }
+        const DynamicsStepResult r = dynamics.propagate(state, dt, config, forceModel);
+        state.position.store(r.position, std::memory_order_relaxed);
+        state.velocity.store(r.velocity, std::memory_order_relaxed);
+        result.steps = step + 1;
+        if (step >= brake_step && r.velocity < kStopVelocity) break;
+    }
+    result.distance = state.position.load();
+    result.time = result.steps * dt;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    const size_t repeats = argc > 1 ? std::max<size_t>(1, std::strtoull(argv[1], nullptr, 10)) : 20;
+
+    const std::shared_ptr<AircraftConfigBase> config = std::make_shared<AircraftConfig_FixedWin_AC2>();
+    const std::shared_ptr<IForceModel> forceModel = std::make_shared<ACForceModel>();
+
+    const StopResult reference = runToStop(Integrator(IntegratorType::RK45, 1e-12), 0.001, config, forceModel);
+    std::cout << std::fixed << std::setprecision(4)
+              << "参考解（RK45, tol 1e-12, dt 0.001）: 停止距离 " << reference.distance << " m, 停止时刻 "
+              << std::setprecision(3) << reference.time << " s" << std::endl;
+
+    struct Case {
+        const char* label;
+        Integrator integrator;
+        double dt;
+    };
+    const Case cases[] = {
+        {"ExplicitEuler", Integrator(IntegratorType::ExplicitEuler), 0.01},
+        {"SemiImplicit", Integrator(IntegratorType::SemiImplicitEuler), 0.01},
+        {"RK4", Integrator(IntegratorType::RK4), 0.1},
+        {"RK45", Integrator(IntegratorType::RK45), 0.1},
+    };
+
+    std::cout << std::left << std::setw(16) << "method" << std::setw(8) << "dt" << std::setw(10) << "steps"
+              << std::setw(16) << "stop dist (m)" << std::setw(14) << "error (m)" << "us/run" << std::endl;
+    for (const Case& c : cases) {
+        const StopResult r = runToStop(c.integrator, c.dt, config, forceModel);
+        bool consistent = true;   // 重复推进结果须逐位一致（同时使计时循环的结果被使用）
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < repeats; ++i) consistent &= runToStop(c.integrator, c.dt, config, forceModel).distance == r.distance;
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / repeats;
+        if (!consistent) std::cout << "（重复推进结果不一致）" << std::endl;
+
+        std::cout << std::left << std::setw(16) << c.label
+                  << std::setprecision(2) << std::setw(8) << c.dt
+                  << std::setw(10) << r.steps
+                  << std::setprecision(4) << std::setw(16) << r.distance
+                  << std::setw(14) << (r.distance - reference.distance)
+                  << std::setprecision(1) << us << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/********************************************************************************************************************
+ * @file longitudinal_bench.cpp
+ * @brief 纵向三自由度动力学模型（DynamicsModel_FixedWing_Longitudinal）基准测试
+ *
+ * 起飞：满油门滑跑，速度达到抬头速度 VR 后以 PD 俯仰律（升降舵指令 = kp·(θ目标 - θ) - kd·q，限幅 ±1）
+ * 抬头至目标俯仰角，离地后保持该俯仰角爬升。先打印 AC2 构型的抬头时刻、离地时刻与速度、最大俯仰角、
+ * 结束时的高度与速度，再对比每步耗时（均含俯仰律计算）：
+ *   - scalar : 一个 SharedStateSpace，经 IDynamicsModel 指针虚调用 propagate（内部虚调用力学模型），结果写回状态
+ *   - fleet  : FleetState 机队，每步一次 stepFleet（各机质量不同，其中 0 号机为 AC2 构型）
+ * 最后核对 fleet 中 0 号机与 scalar 的最终状态逐位一致。
+ *
+ * 编译与运行（在 Benchmarks 目录下）：
+ *   g++ -std=c++17 -O2 -pthread -I../include longitudinal_bench.cpp -o longitudinal_bench
+ *   ./longitudinal_bench [机队架数，默认 1024] [scalar 重复次数，默认 50]
+ ********************************************************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+
+#include "../include/D_DynamicModel/DynamicsModel_FixedWing_Longitudinal.hpp"
+#include "../include/A_Aircraft_Configuration/AircraftConfig_FixedWin_AC2.hpp"
+
+constexpr double kTimeStep = 0.01;
+constexpr size_t kSteps = 4000;              // 40 秒
+constexpr double kRotationSpeed = 70.0;      // 抬头速度 VR（m/s）
+constexpr double kTargetPitch = 0.16;        // 目标俯仰角（rad，约 9°）
+
+// PD 俯仰律：达到 VR 之前不抬头
+static double pitchCommand(double velocity, double pitch, double pitch_rate) {
+    if (velocity < kRotationSpeed && pitch <= 0.0) return 0.0;
+    return std::max(-1.0, std::min(1.0, 4.0 * (kTargetPitch - pitch) - 3.0 * pitch_rate));
+}
+
+static void resetState(SharedStateSpace& state) {
+    for (StateField f : {StateField::Position, StateField::Velocity, StateField::Acceleration, StateField::Altitude,
+                         StateField::NormalVelocity, StateField::PitchAngle, StateField::PitchRate, StateField::PitchControlOutput}) {
+        state.field(f).store(0.0);
+    }
+    state.throttle.store(1.0);
+    state.brake.store(0.0);
+}
+
+// 单步推进：计算俯仰律、调用 propagate、结果写回状态
+static void stepScalar(const IDynamicsModel& dynamics, SharedStateSpace& state, const std::shared_ptr<AircraftConfigBase>& config,
+                       const std::shared_ptr<IForceModel>& forceModel) {
+    state.pitch_control_output.store(pitchCommand(state.velocity.load(), state.pitch_angle.load(), state.pitch_rate.load()),
+                                     std::memory_order_relaxed);
+    const DynamicsStepResult r = dynamics.propagate(state, kTimeStep, config, forceModel);
+    state.position.store(r.position, std::memory_order_relaxed);
+    state.velocity.store(r.velocity, std::memory_order_relaxed);
+    state.acceleration.store(r.acceleration, std::memory_order_relaxed);
+    state.altitude.store(r.altitude, std::memory_order_relaxed);
+    state.normal_velocity.store(r.normal_velocity, std::memory_order_relaxed);
+    state.pitch_angle.store(r.pitch_angle, std::memory_order_relaxed);
+    state.pitch_rate.store(r.pitch_rate, std::memory_order_relaxed);
+}
+
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    const size_t repeats = argc > 2 ? std::max<size_t>(1, std::strtoull(argv[2], nullptr, 10)) : 50;
+
+    const std::shared_ptr<AircraftConfigBase> config = std::make_shared<AircraftConfig_FixedWin_AC2>();
+    const std::shared_ptr<IForceModel> forceModel = std::make_shared<ACForceModel>();
+    const std::unique_ptr<IDynamicsModel> dynamics = std::make_unique<DynamicsModel_FixedWing_Longitudinal>();
+
+    // 起飞过程
+    SharedStateSpace state;
+    resetState(state);
+    double rotation_time = -1.0, liftoff_time = -1.0, liftoff_speed = 0.0, max_pitch = 0.0;
+    for (size_t step = 0; step < kSteps; ++step) {
+        stepScalar(*dynamics, state, config, forceModel);
+        const double t = (step + 1) * kTimeStep;
+        if (rotation_time < 0.0 && state.pitch_angle.load() > 0.0) rotation_time = t;
+        if (liftoff_time < 0.0 && state.altitude.load() > 0.0) {
+            liftoff_time = t;
+            liftoff_speed = state.velocity.load();
+        }
+        max_pitch = std::max(max_pitch, state.pitch_angle.load());
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "AC2 起飞: 抬头 " << rotation_time << " s, 离地 " << liftoff_time << " s（u = " << liftoff_speed << " m/s）"
+              << ", 最大俯仰角 " << max_pitch * 180.0 / M_PI << "°"
+              << ", " << kSteps * kTimeStep << " s 时高度 " << state.altitude.load() << " m、u = " << state.velocity.load()
+              << " m/s、俯仰角 " << state.pitch_angle.load() * 180.0 / M_PI << "°" << std::endl;
+    const double scalar_x = state.position.load(), scalar_h = state.altitude.load(), scalar_theta = state.pitch_angle.load();
+
+    // scalar 计时
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; ++r) {
+        resetState(state);
+        for (size_t step = 0; step < kSteps; ++step) stepScalar(*dynamics, state, config, forceModel);
+    }
+    const double scalar_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count()
+                             / (static_cast<double>(repeats) * kSteps);
+
+    // fleet 计时
+    FleetState fleet(n);
+    for (size_t i = 0; i < n; ++i) {
+        AircraftParams params = AircraftParams::from(*config);
+        params.mass *= 1.0 + 0.2 * static_cast<double>(i % 11) / 10.0;   // 0 号机为 AC2 原质量
+        const size_t id = fleet.addAircraft(params);
+        fleet.at(StateField::Throttle, id) = 1.0;
+    }
+    const double* velocity = fleet.column(StateField::Velocity);
+    const double* pitch = fleet.column(StateField::PitchAngle);
+    const double* pitch_rate = fleet.column(StateField::PitchRate);
+    double* command = fleet.column(StateField::PitchControlOutput);
+    const auto t1 = std::chrono::steady_clock::now();
+    for (size_t step = 0; step < kSteps; ++step) {
+        for (size_t i = 0; i < n; ++i) command[i] = pitchCommand(velocity[i], pitch[i], pitch_rate[i]);
+        dynamics->stepFleet(fleet, kTimeStep, *forceModel);
+    }
+    const double fleet_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t1).count()
+                            / (static_cast<double>(n) * kSteps);
+
+    size_t airborne = 0;
+    for (size_t i = 0; i < n; ++i) airborne += fleet.at(StateField::Altitude, i) > 0.0;
+    const bool match = n == 0 || (fleet.at(StateField::Position, 0) == scalar_x && fleet.at(StateField::Altitude, 0) == scalar_h
+                                  && fleet.at(StateField::PitchAngle, 0) == scalar_theta);
+
+    std::cout << std::left << std::setw(10) << "path" << std::setw(22) << "ns/aircraft-step" << "note" << std::endl;
+    std::cout << std::left << std::setw(10) << "scalar" << std::setw(22) << scalar_ns
+              << repeats << " x " << kSteps << " 步" << std::endl;
+    std::cout << std::left << std::setw(10) << "fleet" << std::setw(22) << fleet_ns
+              << n << " 架 x " << kSteps << " 步, " << airborne << " 架已离地" << std::endl;
+    std::cout << "fleet 0 号机与 scalar 逐位一致: " << (match ? "yes" : "NO") << std::endl;
+    return match ? 0 : 1;
+}
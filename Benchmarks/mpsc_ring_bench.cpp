@@ -0,0 +1,152 @@
+/********************************************************************************************************************
+ * @file mpsc_ring_bench.cpp
+ * @brief 无锁 MPSC 环形缓冲基准测试
+ *
+ * 对比三种多生产者单消费者的消息投递方式在 1~8 个生产者下的吞吐（每秒消息数）：
+ *   - mutex queue : 原 StateUpdateQueue 的实现（互斥锁 + std::queue + 每条 notify_one），消费者 try_pop 轮询
+ *   - ring        : MpscRing 逐条 push
+ *   - ring batch  : MpscRing 一次预留推入一步的全部字段更新（原动力学模型每步推送的 5 条消息）
+ * 每个生产者推送固定数量的消息，计时到消费者取完全部消息为止。
+ *
+ * 编译与运行（在 Benchmarks 目录下）：
+ *   g++ -std=c++17 -O2 -pthread -I../include mpsc_ring_bench.cpp -o mpsc_ring_bench
+ *   ./mpsc_ring_bench [每个生产者的消息数，默认 2000000]
+ ********************************************************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <array>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+#include "../include/L_Simulation_Settings/mpsc_ring.hpp"
+
+// 与原 StateUpdateMessage 相同的消息
+enum class UpdateType { Position, Velocity, Acceleration, Throttle, Brake };
+
+struct UpdateMessage {
+    UpdateType type;
+    double value;
+};
+
+constexpr size_t kBatch = 5;   // 每步的字段更新条数
+
+// 原 StateUpdateQueue 的推送/弹出路径
+class MutexQueue {
+public:
+    void push(const UpdateMessage& message) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push(message);
+        }
+        cond_var_.notify_one();
+    }
+
+    bool try_pop(UpdateMessage& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) return false;
+        message = queue_.front();
+        queue_.pop();
+        return true;
+    }
+
+private:
+    std::queue<UpdateMessage> queue_;
+    std::mutex mutex_;
+    std::condition_variable cond_var_;
+};
+
+enum class Variant { MutexQueue, Ring, RingBatch };
+
+// 运行一组测量，返回每秒消息数
+static double measureMessagesPerSecond(Variant variant, int producers, size_t messages_per_producer) {
+    MutexQueue mutex_queue;
+    MpscRing<UpdateMessage> ring(1024);
+    const size_t total = messages_per_producer * producers;
+    std::atomic<bool> go{false};
+    double checksum = 0.0;
+
+    std::thread consumer([&]() {
+        while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+        size_t received = 0;
+        std::array<UpdateMessage, 64> batch;
+        while (received < total) {
+            if (variant == Variant::MutexQueue) {
+                UpdateMessage message;
+                if (mutex_queue.try_pop(message)) {
+                    checksum += message.value;
+                    ++received;
+                } else {
+                    std::this_thread::yield();
+                }
+            } else {
+                const size_t n = ring.popBatch(batch.begin(), batch.size());
+                for (size_t i = 0; i < n; ++i) checksum += batch[i].value;
+                received += n;
+                if (n == 0) std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (int p = 0; p < producers; ++p) {
+        workers.emplace_back([&, p]() {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            std::array<UpdateMessage, kBatch> step;
+            for (size_t i = 0; i < messages_per_producer; i += kBatch) {
+                for (size_t k = 0; k < kBatch; ++k) {
+                    step[k] = UpdateMessage{static_cast<UpdateType>(k), static_cast<double>(p + i + k)};
+                }
+                if (variant == Variant::MutexQueue) {
+                    for (const auto& message : step) mutex_queue.push(message);
+                } else if (variant == Variant::Ring) {
+                    for (const auto& message : step) ring.push(message);
+                } else {
+                    ring.pushBatch(step.begin(), kBatch);
+                }
+            }
+        });
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) w.join();
+    consumer.join();
+    const auto t1 = std::chrono::steady_clock::now();
+
+    if (checksum < 0.0) std::cout << "";   // 防止消费结果被优化掉
+    return total / std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char** argv) {
+    size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    messages = (messages + kBatch - 1) / kBatch * kBatch;
+
+    std::cout << "硬件线程数: " << std::thread::hardware_concurrency()
+              << ", 每个生产者消息数: " << messages << std::endl;
+    std::cout << std::left << std::setw(12) << "producers"
+              << std::setw(18) << "mutex msg/s"
+              << std::setw(18) << "ring msg/s"
+              << std::setw(18) << "batch msg/s"
+              << "speedup(batch)" << std::endl;
+
+    for (int producers : {1, 2, 4, 8}) {
+        double mutex_rate = measureMessagesPerSecond(Variant::MutexQueue, producers, messages);
+        double ring_rate = measureMessagesPerSecond(Variant::Ring, producers, messages);
+        double batch_rate = measureMessagesPerSecond(Variant::RingBatch, producers, messages);
+        std::cout << std::left << std::fixed << std::setprecision(0)
+                  << std::setw(12) << producers
+                  << std::setw(18) << mutex_rate
+                  << std::setw(18) << ring_rate
+                  << std::setw(18) << batch_rate
+                  << std::setprecision(2) << (mutex_rate > 0 ? batch_rate / mutex_rate : 0.0) << "x"
+                  << std::endl;
+    }
+    return 0;
+}
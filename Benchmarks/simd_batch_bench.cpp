@@ -0,0 +1,149 @@
+/********************************************************************************************************************
+ * @file simd_batch_bench.cpp
+ * @brief 蒙特卡洛批量推进 SIMD 内核基准测试
+ *
+ * N 次相互独立的起飞滑跑（质量、推力、刹车力、阻力系数、静摩擦系数各不相同，部分静止、部分刹车），
+ * 对比每架飞机每步的耗时（ns/aircraft-step）：
+ *   - virtual : 每架飞机一个 SharedStateSpace 与一个构型对象，逐架虚调用 IDynamicsModel::propagate
+ *               （内部虚调用 IForceModel::calculateNetForce 与构型参数的虚 getter），结果写回状态原子变量
+ *   - scalar  : FleetSimd::stepLinearEuler 标量路径（FleetState 结构数组）
+ *   - AVX2    : 每次 4 架（编译时启用 AVX2 才测量）
+ *   - AVX-512 : 每次 8 架（编译时启用 AVX-512 才测量）
+ *   - <ISA> tiled : 同一指令集，一次调用推进全部步数（按 FleetSimd::kTile 架分块，块内数据留在缓存中）
+ * 每条路径从相同初始状态推进相同步数，最后报告各路径与 virtual 路径的位置、速度最大相对偏差。
+ *
+ * 编译与运行（在 Benchmarks 目录下）：
+ *   g++ -std=c++17 -O2 -pthread -I../include simd_batch_bench.cpp -o simd_batch_bench                  # 仅标量
+ *   g++ -std=c++17 -O2 -mavx2 -pthread -I../include simd_batch_bench.cpp -o simd_batch_bench_avx2
+ *   g++ -std=c++17 -O2 -mavx2 -mavx512f -pthread -I../include simd_batch_bench.cpp -o simd_batch_bench_avx512
+ *   ./simd_batch_bench [实例数，默认 4096] [步数，默认 2000]
+ ********************************************************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <string>
+
+#include "../include/D_DynamicModel/DynamicsModel_FixedWing_Linear.hpp"
+#include "../include/D_DynamicModel/fleet_simd_kernel.hpp"
+
+constexpr double kTimeStep = 0.01;
+
+// 每个实例一个构型对象（参数扫描）
+class SweepConfig : public AircraftConfigBase {
+public:
+    explicit SweepConfig(const AircraftParams& p) : p_(p) {}
+    double getMass() const override { return p_.mass; }
+    double getMaxThrust() const override { return p_.max_thrust; }
+    double getMinThrust() const override { return 0.0; }
+    double getMaxBrakeForce() const override { return p_.max_brake_force; }
+    double getDragCoefficient() const override { return p_.drag_coefficient; }
+    double getStaticFrictionCoefficient() const override { return p_.static_friction_coefficient; }
+
+private:
+    AircraftParams p_;
+};
+
+// 第 i 个实例的参数与初始状态
+static AircraftParams sweepParams(size_t i) {
+    const double k = static_cast<double>(i % 97) / 97.0;
+    return AircraftParams{70000.0 + 30000.0 * k, 400000.0 + 200000.0 * k, 300000.0 + 150000.0 * (1.0 - k),
+                          0.015 + 0.01 * k, 0.015 + 0.01 * (1.0 - k)};
+}
+
+static void initialState(size_t i, double& velocity, double& throttle, double& brake) {
+    velocity = (i % 5 == 0) ? 0.0 : 5.0 + static_cast<double>(i % 60);
+    throttle = (i % 3 == 0) ? 0.0 : 0.2 + 0.1 * static_cast<double>(i % 7);
+    brake = (i % 4 == 0) ? 0.6 : 0.0;
+}
+
+static FleetState makeFleet(size_t n) {
+    FleetState fleet(n);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t id = fleet.addAircraft(sweepParams(i));
+        initialState(i, fleet.at(StateField::Velocity, id), fleet.at(StateField::Throttle, id), fleet.at(StateField::Brake, id));
+    }
+    return fleet;
+}
+
+static double relativeDiff(double a, double b) {
+    return std::abs(a - b) / std::max(1.0, std::abs(b));
+}
+
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4096;
+    const size_t steps = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+
+    std::cout << "实例数: " << n << ", 步数: " << steps
+              << ", 编译启用的最宽指令集: " << FleetSimd::isaName(FleetSimd::kCompiledIsa) << std::endl;
+
+    // virtual 路径
+    std::vector<std::unique_ptr<SharedStateSpace>> states;
+    std::vector<std::shared_ptr<AircraftConfigBase>> configs;
+    for (size_t i = 0; i < n; ++i) {
+        double velocity, throttle, brake;
+        initialState(i, velocity, throttle, brake);
+        states.push_back(std::make_unique<SharedStateSpace>());
+        states.back()->velocity.store(velocity);
+        states.back()->throttle.store(throttle);
+        states.back()->brake.store(brake);
+        configs.push_back(std::make_shared<SweepConfig>(sweepParams(i)));
+    }
+    std::shared_ptr<IForceModel> forceModel = std::make_shared<ACForceModel>();
+    std::unique_ptr<IDynamicsModel> dynamics = std::make_unique<DynamicsModel_FixedWing_Linear>();
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t step = 0; step < steps; ++step) {
+        for (size_t i = 0; i < n; ++i) {
+            SharedStateSpace& state = *states[i];
+            const DynamicsStepResult r = dynamics->propagate(state, kTimeStep, configs[i], forceModel);
+            state.position.store(r.position, std::memory_order_release);
+            state.velocity.store(r.velocity, std::memory_order_release);
+            state.acceleration.store(r.acceleration, std::memory_order_release);
+        }
+    }
+    const double virtual_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count()
+                              / (static_cast<double>(steps) * n);
+
+    std::cout << std::left << std::setw(16) << "path"
+              << std::setw(22) << "ns/aircraft-step"
+              << std::setw(20) << "speedup vs virtual"
+              << "max rel diff" << std::endl;
+    std::cout << std::left << std::fixed << std::setprecision(2)
+              << std::setw(16) << "virtual" << std::setw(22) << virtual_ns << std::setw(20) << 1.0 << "-" << std::endl;
+
+    std::vector<FleetSimd::Isa> isas = {FleetSimd::Isa::Scalar};
+    if (FleetSimd::kCompiledIsa != FleetSimd::Isa::Scalar) isas.push_back(FleetSimd::Isa::AVX2);
+    if (FleetSimd::kCompiledIsa == FleetSimd::Isa::AVX512) isas.push_back(FleetSimd::Isa::AVX512);
+
+    for (bool tiled : {false, true}) {
+        for (FleetSimd::Isa isa : isas) {
+            FleetState fleet = makeFleet(n);
+            const auto t1 = std::chrono::steady_clock::now();
+            if (tiled) {
+                FleetSimd::stepLinearEuler(fleet, kTimeStep, isa, steps);
+            } else {
+                for (size_t step = 0; step < steps; ++step) FleetSimd::stepLinearEuler(fleet, kTimeStep, isa);
+            }
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t1).count()
+                              / (static_cast<double>(steps) * n);
+
+            double max_diff = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                max_diff = std::max(max_diff, relativeDiff(fleet.at(StateField::Position, i), states[i]->position.load()));
+                max_diff = std::max(max_diff, relativeDiff(fleet.at(StateField::Velocity, i), states[i]->velocity.load()));
+            }
+            std::cout << std::left << std::fixed << std::setprecision(2)
+                      << std::setw(16) << (std::string(FleetSimd::isaName(isa)) + (tiled ? " tiled" : ""))
+                      << std::setw(22) << ns
+                      << std::setw(20) << (ns > 0 ? virtual_ns / ns : 0.0)
+                      << std::scientific << std::setprecision(2) << max_diff << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+/********************************************************************************************************************
+ * @file state_layout_bench.cpp
+ * @brief 后缓冲布局（伪共享）基准测试
+ *
+ * 模拟线程模式下每步并发写后缓冲的四个写者：动力学（位置、速度、加速度、三个力、仿真时间共 7 个字段）、
+ * 油门控制器、刹车控制器、俯仰角控制器（各 1 个字段），对比两种布局的每步耗时：
+ *   - packed      : 原布局，所有字段连续存放在一个数组里，所有写者共用一个写入掩码
+ *   - partitioned : StepStateBuffer，按写者分块、每块 alignas(64) 独占缓存行
+ * 每个写者独立循环写入 N 步（不加屏障，只测写入本身），每步耗时 = 全部写者完成 N 步的墙钟时间 / N。
+ * 每次测量后读回写入掩码和各字段的值求校验和，两种布局的校验和应一致（结果打印输出，写入不会被优化掉）。
+ * 伪共享只在写者位于不同核心时出现：硬件线程数少于写者数时写者分时运行，结果不反映伪共享，
+ * 程序会打印提示。分块布局的收益须在至少 4 个核心的机器上测量。
+ *
+ * 编译与运行（在 Benchmarks 目录下）：
+ *   g++ -std=c++17 -O2 -pthread -I../include state_layout_bench.cpp -o state_layout_bench
+ *   ./state_layout_bench [步数，默认 5000000]
+ ********************************************************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+#include "../include/K_Scenario/step_state_buffer.hpp"
+
+// 原后缓冲布局：字段值连续存放，写入掩码所有写者共用
+class PackedStepBuffer {
+public:
+    void write(StateField field, double value) {
+        const size_t index = static_cast<size_t>(field);
+        values_[index].store(value, std::memory_order_relaxed);
+        written_.fetch_or(uint32_t{1} << index, std::memory_order_release);
+    }
+
+    uint32_t take() { return written_.exchange(0, std::memory_order_acq_rel); }
+
+    double value(StateField field) const { return values_[static_cast<size_t>(field)].load(std::memory_order_relaxed); }
+
+private:
+    std::array<std::atomic<double>, kStateFieldCount> values_{};
+    std::atomic<uint32_t> written_{0};
+};
+
+// 各写者每步写入的字段
+static const std::vector<std::vector<StateField>> kWriterFields = {
+    {StateField::Position, StateField::Velocity, StateField::Acceleration, StateField::Thrust,
+     StateField::DragForce, StateField::BrakeForce, StateField::SimulationTime},
+    {StateField::Throttle},
+    {StateField::Brake},
+    {StateField::PitchControlOutput},
+};
+
+struct Measurement {
+    double ns_per_step;
+    double checksum;   // 写入掩码 + 各写者字段的最终值之和
+};
+
+// 运行一组测量
+template <typename Buffer>
+static Measurement measure(size_t steps) {
+    Buffer buffer;
+    std::atomic<bool> go{false};
+    std::vector<std::thread> writers;
+    for (const auto& fields : kWriterFields) {
+        writers.emplace_back([&buffer, &go, &fields, steps]() {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (size_t step = 0; step < steps; ++step) {
+                for (StateField field : fields) buffer.write(field, static_cast<double>(step));
+            }
+        });
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& w : writers) w.join();
+    const auto t1 = std::chrono::steady_clock::now();
+
+    double checksum = static_cast<double>(buffer.take());
+    for (const auto& fields : kWriterFields) {
+        for (StateField field : fields) checksum += buffer.value(field);
+    }
+    return Measurement{std::chrono::duration<double, std::nano>(t1 - t0).count() / steps, checksum};
+}
+
+int main(int argc, char** argv) {
+    const size_t steps = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+
+    std::cout << "硬件线程数: " << std::thread::hardware_concurrency()
+              << ", 写者数: " << kWriterFields.size() << ", 步数: " << steps << std::endl;
+    if (std::thread::hardware_concurrency() < kWriterFields.size()) {
+        std::cout << "注意: 硬件线程数少于写者数，写者分时运行，以下结果不反映伪共享" << std::endl;
+    }
+    std::cout << "sizeof(PackedStepBuffer) = " << sizeof(PackedStepBuffer)
+              << ", sizeof(StepStateBuffer) = " << sizeof(StepStateBuffer) << std::endl;
+    std::cout << std::left << std::setw(14) << "round"
+              << std::setw(18) << "packed ns/step"
+              << std::setw(22) << "partitioned ns/step"
+              << "speedup" << std::endl;
+
+    bool match = true;
+    for (int round = 1; round <= 3; ++round) {
+        const Measurement packed_run = measure<PackedStepBuffer>(steps);
+        const Measurement partitioned_run = measure<StepStateBuffer>(steps);
+        const double packed = packed_run.ns_per_step;
+        const double partitioned = partitioned_run.ns_per_step;
+        match = match && packed_run.checksum == partitioned_run.checksum;
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(14) << round
+                  << std::setw(18) << packed
+                  << std::setw(22) << partitioned
+                  << (partitioned > 0 ? packed / partitioned : 0.0) << "x"
+                  << std::endl;
+    }
+    std::cout << "两种布局校验和一致: " << (match ? "yes" : "NO") << std::endl;
+    return match ? 0 : 1;
+}
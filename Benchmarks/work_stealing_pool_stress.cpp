@@ -0,0 +1,63 @@
+/********************************************************************************************************************
+ * @file work_stealing_pool_stress.cpp
+ * @brief 工作窃取线程池（WorkStealingPool）构造后立即执行的压力测试
+ *
+ * 反复构造线程池后立即 runRound（不等待辅助线程启动），每轮是一棵任务树：根任务展开为若干子任务，
+ * 子任务在执行回调内 push 到执行者自己的队列。每个线程池连续执行数轮后析构，检查：
+ *   - 每轮所有任务恰好执行一次（任务下标之和与期望一致）
+ *   - 构造后立即开始的第一轮不会挂起（辅助线程尚未运行时纪元已翻转）
+ * 挂起时程序不会返回，建议配合 timeout 运行。最后打印每个线程池（构造 + 各轮 + 析构）的平均耗时。
+ *
+ * 编译与运行（在 Benchmarks 目录下）：
+ *   g++ -std=c++17 -O2 -pthread -I../include work_stealing_pool_stress.cpp -o work_stealing_pool_stress
+ *   timeout 60 ./work_stealing_pool_stress [线程池个数，默认 20000] [辅助线程数，默认 3]
+ ********************************************************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include "../include/L_Simulation_Settings/work_stealing_pool.hpp"
+
+constexpr int kRoots = 4;          // 每轮根任务数
+constexpr int kChildren = 16;      // 每个根任务展开的子任务数
+constexpr int kRoundsPerPool = 3;  // 每个线程池执行的轮数
+constexpr int kTotalTasks = kRoots * (1 + kChildren);
+
+int main(int argc, char** argv) {
+    const size_t pools = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    const size_t helpers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 3;
+
+    // 任务 0..kRoots-1 为根任务，根任务 r 的子任务为 kRoots + r*kChildren + k
+    std::vector<int> roots;
+    for (int r = 0; r < kRoots; ++r) roots.push_back(r);
+    long long expected_sum = 0;
+    for (int task = 0; task < kTotalTasks; ++task) expected_sum += task;
+
+    size_t bad_rounds = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < pools; ++p) {
+        WorkStealingPool pool(helpers);
+        for (int round = 0; round < kRoundsPerPool; ++round) {
+            std::atomic<long long> sum{0};
+            pool.runRound(roots, kTotalTasks, [&pool, &sum](int task, size_t worker) {
+                sum.fetch_add(task, std::memory_order_relaxed);
+                if (task < kRoots) {
+                    for (int k = 0; k < kChildren; ++k) pool.push(worker, kRoots + task * kChildren + k);
+                }
+            });
+            if (sum.load() != expected_sum) ++bad_rounds;
+        }
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count()
+                      / static_cast<double>(pools);
+
+    std::cout << "线程池个数: " << pools << ", 辅助线程数: " << helpers << ", 每个线程池 " << kRoundsPerPool
+              << " 轮 x " << kTotalTasks << " 个任务" << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << "每个线程池平均耗时: " << us << " us" << std::endl;
+    std::cout << "任务执行次数错误的轮数: " << bad_rounds << std::endl;
+    return bad_rounds == 0 ? 0 : 1;
+}
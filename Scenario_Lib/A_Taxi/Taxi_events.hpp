@@ -57,7 +57,7 @@ namespace TaxiEvents {
      * @brief 事件定义映射表（事件名称到事件定义的映射）
      * 用于事件订阅和处理。
      * 按照全局 EventDefinition 成员顺序初始化：
-     * name, description, trigger_condition, actions, response_description, triggered
+     * name, description, trigger_condition, actions, response_description, triggered, guard
      */
     const std::unordered_map<std::string, EventDefinition> EVENT_DEFINITIONS = {
         // 1. 开始增加油门事件：仿真时间1秒
@@ -71,7 +71,8 @@ namespace TaxiEvents {
             },
             { GenericEvents::ControllerAction::START_THROTTLE_INCREASE },
             "启动油门增加控制器",
-            false
+            false,
+            nullptr   // 无连续守卫：事件时刻取检测到 trigger_condition 的步边界
         }},
         // 2. 开始刹车事件：距离达到500米
         {START_BRAKE, {
@@ -82,7 +83,8 @@ namespace TaxiEvents {
             },
             { GenericEvents::ControllerAction::START_THROTTLE_DECREASE, GenericEvents::ControllerAction::START_BRAKE },
             "启动油门减小控制器和刹车控制器",
-            false
+            false,
+            nullptr   // 无连续守卫：事件时刻取检测到 trigger_condition 的步边界
         }},
         // 3. 最终停止事件：速度接近0
         {FINAL_STOP, {
@@ -93,7 +95,8 @@ namespace TaxiEvents {
             },
             { GenericEvents::ControllerAction::STOP_ALL_CONTROLLERS, GenericEvents::ControllerAction::SWITCH_TO_MANUAL_MODE },
             "停止所有控制器并切换到手动模式",
-            false
+            false,
+            nullptr   // 无连续守卫：事件时刻取检测到 trigger_condition 的步边界
         }},
     };
 
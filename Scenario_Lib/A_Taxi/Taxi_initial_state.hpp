@@ -72,7 +72,7 @@ public:
             log_detail("[共享状态空间初始化] 控制标志已重置\n");
 
             // 初始化仿真步长（单位：秒）
-            SimulationClock::getInstance().setTimeStep(TaxiConfig::SIMULATION_TIME_STEP);
+            state.clock().setTimeStep(TaxiConfig::SIMULATION_TIME_STEP);
             log_detail("[共享状态空间初始化] 仿真步长已设置为" + std::to_string(TaxiConfig::SIMULATION_TIME_STEP) + "\n");
 
             return true;
@@ -34,17 +34,20 @@
 #include "../../include/K_Scenario/event_bus.hpp"                         // ParaSAFE系统头文件, 事件总线，事件发布与订阅
 #include "../../include/K_Scenario/controller_manager.hpp"                // ParaSAFE系统头文件, 控制器管理器，管理各类控制器
 #include "../../include/D_DynamicModel/DynamicsModel_FixedWing_Linear.hpp"                // ParaSAFE系统头文件, 固定翼线性动力学模型，推进物理状态
+#include "../../include/D_DynamicModel/DynamicsModel_FixedWing_Longitudinal.hpp" // ParaSAFE系统头文件, 固定翼纵向三自由度动力学模型（升力、俯仰、起落架）
 #include "../../include/L_Simulation_Settings/simulation_clock.hpp"       // ParaSAFE系统头文件, 仿真时钟，统一时间推进
 #include "../../include/L_Simulation_Settings/thread_manager.hpp"         // ParaSAFE系统头文件, 线程管理器，线程统一管理
+#include "../../include/L_Simulation_Settings/thread_policy.hpp"          // ParaSAFE系统头文件, 线程策略，CPU 亲和性与实时优先级
 #include "../../include/L_Simulation_Settings/simulation_manager.hpp"     // ParaSAFE系统头文件, 仿真管理器，仿真流程控制
 #include "../../include/L_Simulation_Settings/data_recorder.hpp"          // ParaSAFE系统头文件, 文件日志器，数据记录与输出
 #include "../../include/L_Simulation_Settings/simulation_config_base.hpp" // ParaSAFE系统头文件, 仿真配置基类，参数管理
 #include "../../include/C_Flight_Control/controller_config.hpp"                 // ParaSAFE系统头文件, 控制器参数配置
 #include "../../include/K_Scenario/controller_actions_config.hpp"         // ParaSAFE系统头文件, 控制器动作配置，事件-动作映射
-#include "../../include/K_Scenario/state_update_queue.hpp"                // ParaSAFE系统头文件, 状态更新队列，线程间状态同步
-#include "../../include/L_Simulation_Settings/state_manager_thread.hpp"   // ParaSAFE系统头文件, 状态空间线程，管理状态推进
+#include "../../include/L_Simulation_Settings/state_manager_thread.hpp"   // ParaSAFE系统头文件, 状态空间处理，步屏障处提交后缓冲
 #include "../../include/L_Simulation_Settings/logger.hpp"                 // ParaSAFE系统头文件, 日志模块，详细/简要日志输出
 #include "../../include/K_Scenario/event_detection.hpp"                   // ParaSAFE系统头文件, 通用事件检测线程头文件
+#include "../../include/L_Simulation_Settings/fused_step_executor.hpp"    // ParaSAFE系统头文件, 单线程融合步进执行器
+#include "../../include/L_Simulation_Settings/task_graph.hpp"             // ParaSAFE系统头文件, 按读写集调度的任务图执行器
 
 // 本科目（中断起飞）头文件：每个科目都需要这几个头文件，如果你在新建一个场景，则需要重新定义这几个头文件
 #include "Taxi_config.hpp"          // 本科目头文件, 配置文件，参数定义
@@ -79,6 +82,25 @@ int main() {
     std::shared_ptr<IDynamicsModel> dynamicsModel = std::make_shared<DynamicsModel_FixedWing_Linear>();
     // 若需切换为非线性模型，只需如下：
     // std::shared_ptr<IDynamicsModel> dynamicsModel = std::make_shared<DynamicsModel_FixedWing_Nonlinear>();
+    // 若需积分俯仰角（升力、俯仰力矩、起落架接地与抬头，俯仰角保持控制器的输出作为升降舵指令），只需如下：
+    // std::shared_ptr<IDynamicsModel> dynamicsModel = std::make_shared<DynamicsModel_FixedWing_Longitudinal>();
+    // 积分方法默认显式欧拉；高阶积分器可配合更大的 SIMULATION_TIME_STEP 使用，只需如下：
+    // dynamicsModel->setIntegrator(Integrator(IntegratorType::RK4));
+
+    // =============================== 执行器模式选择 =============================== //
+    // false: 每个组件一个线程，由仿真时钟屏障同步（默认）
+    // true : 所有组件在一个线程内按 动力学→状态提交→事件→控制器→数据记录 的顺序执行
+    const bool USE_FUSED_EXECUTOR = false;
+    // 仅在 USE_FUSED_EXECUTOR 为 true 时生效：true 为按状态读写集并行的任务图执行器
+    const bool USE_TASK_GRAPH = false;
+
+    // ============================= 时钟运行模式选择 ============================= //
+    // AsFastAsPossible: 不与墙钟同步，批量仿真用；RealTime: 与墙钟 1:1；ScaledRealTime: N 倍实时
+    SimulationClock::getInstance().setRunMode(SimulationClock::RunMode::AsFastAsPossible);
+    // 若需按墙钟回放，只需如下：
+    // SimulationClock::getInstance().setRunMode(SimulationClock::RunMode::RealTime);
+    // SimulationClock::getInstance().setRunMode(SimulationClock::RunMode::ScaledRealTime, 4.0);
+    SimulationClock::getInstance().setLatencyReportOnStop(true); // 时钟停止时把各线程的延迟统计写入日志
 
     // =============================== 初始化   ============================== // 
     SetConsoleOutputCP(CP_UTF8);
@@ -86,6 +108,7 @@ int main() {
     std::cout << "[主函数] 开始加载配置文件..." << std::endl;
     TaxiConfig::loadConfig("Taxi_config.txt");
     ControllerActionsConfig::loadConfig("controller_actions_config.txt");
+    ThreadPolicy::loadConfig("thread_policy_config.txt");
     std::cout << "[主函数] 配置文件加载完成" << std::endl;
     log_brief("=========   仿真开始  ========= \n");
     SharedStateSpace state;
@@ -93,21 +116,27 @@ int main() {
     state.simulation_started = true;
     state.setSimulationRunning(true);
     log_brief("[主函数：状态空间] 状态空间已初始化\n");
-    EventBus bus(state);
+    EventBus bus(state, USE_FUSED_EXECUTOR ? EventBus::DispatchMode::Synchronous : EventBus::DispatchMode::Async);
     log_brief("[主函数：事件总线] 事件总线已初始化\n");
-    StateUpdateQueue update_queue;
-    log_brief("[主函数：队列] 状态更新队列已初始化\n");
-    ControllerManagerThread controller_manager_thread(state, bus, update_queue);
+    ControllerManagerThread controller_manager_thread(state, bus);
     log_brief("[主函数：控制器管理器] 控制器管理器已初始化\n");
+    controller_manager_thread.setExternallyStepped(USE_FUSED_EXECUTOR);
     controller_manager_thread.setEventDefinitions(TaxiEvents::EVENT_DEFINITIONS);
     EventMonitorThread event_monitor_thread(state, bus, TaxiEvents::EVENT_DEFINITIONS);
     log_brief("[主函数：事件监控] 事件监控器已初始化\n");
     SimulationControlThread simulation_control_thread(state, bus);
+    StopConditionSet stop_conditions; // 本场景的停止条件，每步求值，仿真恰好在满足条件的步结束
+    stop_conditions.add(StopConditions::positionAbove(TaxiConfig::STOP_POSITION_LIMIT));
+    stop_conditions.add(StopConditions::timeAbove(TaxiConfig::STOP_TIME_LIMIT));
+    simulation_control_thread.setStopConditions(stop_conditions);
     log_brief("[主函数：仿真控制] 仿真控制线程已初始化\n");
     controller_manager_thread.setupEventHandlers();
     log_brief("[主函数：事件处理] 事件处理器已设置\n");
     FileLogger logger("Taxi_log.txt");
     DataRecorderThread data_recorder_thread(state, SimulationClock::getInstance(), logger);
+    // 数据记录与事件检测默认每个时间步一次；如需降频（时钟只在调度步唤醒对应线程），只需如下：
+    // data_recorder_thread.setRecordPeriod(0.1);   // 10 Hz
+    // event_monitor_thread.setCheckPeriod(0.02);   // 50 Hz
     auto start_data_recorder = [&]() {
         data_recorder_thread.start();
         log_brief("[主函数：数据输出] 数据输出线程已启动\n");
@@ -133,6 +162,7 @@ int main() {
     auto stop_clock = [&]() {
         SimulationClock::getInstance().stop();
         log_brief("[主函数：时钟] 仿真时钟已停止\n");
+        SimulationClock::getInstance().reportRunStats();
         if (clock_thread_started && clock_thread.joinable()) {
             clock_thread.join();
             log_brief("[主函数：时钟] 仿真时钟线程已停止\n");
@@ -156,21 +186,21 @@ int main() {
         controller_manager_thread.join();
         log_brief("[主函数：控制器管理器] 控制器管理线程已停止\n");
     };
-    StateManagerThread state_manager(state, update_queue, SimulationClock::getInstance());
+    StateManagerThread state_manager(state, SimulationClock::getInstance());
     auto start_state_manager = [&]() {
         state_manager.start();
-        log_brief("[主函数：状态空间] 状态空间线程已启动\n");
+        log_brief("[主函数：状态空间] 状态提交已挂到时钟步屏障\n");
     };
     auto stop_state_manager = [&]() {
         state_manager.stop();
-        log_brief("[主函数：状态空间线程] 状态空间线程已停止\n");
+        log_brief("[主函数：状态空间] 状态提交已从时钟步屏障移除\n");
     };
 
     std::thread dynamics_thread;
     bool dynamics_thread_started = false;
     auto start_dynamics = [&]() {
         if (!dynamics_thread_started) {
-            dynamics_thread = std::thread([&state, &update_queue, &bus, aircraftConfig, forceModel, dynamicsModel]() {
+            dynamics_thread = std::thread([&state, &bus, aircraftConfig, forceModel, dynamicsModel]() {
                 ThreadNaming::set_current_thread_name("DynamicsModel");
                 log_brief("[主函数：动力学模型] 动力学模型线程已启动\n");
                 SimulationClock::getInstance().registerThread();
@@ -183,9 +213,8 @@ int main() {
                         log_brief("[主函数：动力学模型] 时钟已停止，退出循环\n");
                         break;
                     }
-                    state.simulation_time.store(SimulationClock::getInstance().getCurrentTime());
                     log_brief("[主函数：动力学模型] 开始更新动力学模型\n");
-                    dynamicsModel->step(state, update_queue, bus, SimulationClock::getInstance(), aircraftConfig, forceModel);
+                    dynamicsModel->step(state, bus, SimulationClock::getInstance(), aircraftConfig, forceModel);
                     log_brief("[主函数：动力学模型] 通知时钟步骤已完成\n");
                     SimulationClock::getInstance().notifyStepCompleted();
                     log_brief("[主函数：动力学模型] 动力学模型更新完成\n");
@@ -211,22 +240,77 @@ int main() {
         simulation_control_thread.join();
         log_brief("[主函数：仿真控制] 仿真控制线程已停止\n");
     };
+    auto run_fused_executor = [&]() {
+        SimulationClock& clock = SimulationClock::getInstance();
+        FusedStepExecutor executor(clock, state);
+        executor.setStage(FusedStage::Dynamics, [&]() {
+            dynamicsModel->step(state, bus, clock, aircraftConfig, forceModel);
+        });
+        executor.setStage(FusedStage::StateCommit, [&]() { state_manager.processStep(); });
+        executor.setStage(FusedStage::Events, [&]() { event_monitor_thread.checkEventsOnce(clock.getCurrentTime()); },
+                          event_monitor_thread.getRateDivisor());
+        executor.setStage(FusedStage::Controllers, [&]() { controller_manager_thread.stepControllers(clock.getTimeStep()); });
+        executor.setStage(FusedStage::Recorder, [&]() { data_recorder_thread.recordStep(); },
+                          data_recorder_thread.getRateDivisor());
+        executor.setStopCondition([&]() { return simulation_control_thread.checkStopConditions(); });
+        log_brief("[主函数：融合执行器] 融合执行器开始运行\n");
+        data_recorder_thread.recordInitialState();
+        executor.run();
+        controller_manager_thread.stopAllControllers();
+        log_brief("[主函数：融合执行器] 融合执行器已结束\n");
+        clock.reportRunStats();
+    };
+    auto run_task_graph_executor = [&]() {
+        SimulationClock& clock = SimulationClock::getInstance();
+        TaskGraphExecutor executor(clock, state);
+        executor.addTask("动力学", dynamicsModel->stateAccess() | forceModel->stateAccess(), [&]() {
+            dynamicsModel->step(state, bus, clock, aircraftConfig, forceModel);
+        });
+        executor.addTask("状态提交", StateManagerThread::stateAccess(), [&]() { state_manager.processStep(); });
+        executor.addTask("事件检测", event_monitor_thread.stateAccess(),
+                         [&]() { event_monitor_thread.checkEventsOnce(clock.getCurrentTime()); },
+                         event_monitor_thread.getRateDivisor());
+        for (const auto& controller : controller_manager_thread.getControllers()) {
+            executor.addTask(controller->getName(), controller->stateAccess(), [&clock, controller]() {
+                if (controller->isActive()) controller->stepOnce(clock.getTimeStep());
+            });
+        }
+        executor.addTask("数据记录", DataRecorderThread::stateAccess(), [&]() { data_recorder_thread.recordStep(); },
+                         data_recorder_thread.getRateDivisor());
+        executor.setStopCondition([&]() { return simulation_control_thread.checkStopConditions(); });
+        log_brief("[主函数：任务图执行器] 任务图执行器开始运行\n");
+        data_recorder_thread.recordInitialState();
+        executor.run();
+        controller_manager_thread.stopAllControllers();
+        log_brief("[主函数：任务图执行器] 任务图执行器已结束\n");
+        clock.reportRunStats();
+    };
+    if (USE_FUSED_EXECUTOR) {
+        start_simulation_control();
+        if (USE_TASK_GRAPH) {
+            run_task_graph_executor();
+        } else {
+            run_fused_executor();
+        }
+        stop_simulation_control();
+        log_brief("========= 仿真结束 =========\n");
+        return 0;
+    }
+    SimulationClock::getInstance().setStartParticipants(3); // 事件监测、动力学、数据记录
     start_simulation_control();
+    start_state_manager(); // 状态提交挂到时钟步屏障，须在时钟启动之前
     start_clock();
-    start_state_manager();
     start_event_monitor();
     start_controller_manager();
     start_dynamics();
     start_data_recorder();
-    while (state.simulation_running.load(std::memory_order_acquire)) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+    state.wait_for_simulation_end(); // 停止条件成立或控制通道收到 stop 命令时唤醒
     stop_data_recorder();
     stop_dynamics();
     stop_controller_manager();
     stop_event_monitor();
-    stop_state_manager();
     stop_clock();
+    stop_state_manager();
     stop_simulation_control();
     log_brief("========= 仿真结束 =========\n");
     return 0;
@@ -68,6 +68,10 @@ namespace AbortTakeoffConfig {
     double ABORT_REACTION_TIME = 1.0;       // 中止反应时间 (单位：s)
     double SIMULATION_TIME_STEP = 0.01;     // 仿真时间步长 (单位：s)
 
+    // ===================== 停止条件参数 =====================
+    double STOP_POSITION_LIMIT = 1500.0;    // 位置超过该值时结束仿真 (单位：m)
+    double STOP_TIME_LIMIT = 180.0;         // 仿真时间超过该值时结束仿真 (单位：s)
+
     // ===================== 控制律参数 =====================
     double SPEED_CONTROL_KP = 0.1;             // 速度控制比例系数
     double SPEED_CONTROL_KI = 0.01;            // 速度控制积分系数
@@ -227,6 +231,14 @@ namespace AbortTakeoffConfig {
                 SIMULATION_TIME_STEP = value;
                 std::cout << "[AbortTakeoffConfig] 加载 " << key << " = " << value << std::endl;
             }
+            else if (key == "STOP_POSITION_LIMIT") {
+                STOP_POSITION_LIMIT = value;
+                std::cout << "[AbortTakeoffConfig] 加载 " << key << " = " << value << std::endl;
+            }
+            else if (key == "STOP_TIME_LIMIT") {
+                STOP_TIME_LIMIT = value;
+                std::cout << "[AbortTakeoffConfig] 加载 " << key << " = " << value << std::endl;
+            }
             else if (key == "SPEED_CONTROL_KP") {
                 SPEED_CONTROL_KP = value;
                 std::cout << "[AbortTakeoffConfig] 加载 " << key << " = " << value << std::endl;
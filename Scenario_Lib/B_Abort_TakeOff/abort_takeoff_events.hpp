@@ -96,18 +96,22 @@ namespace AbortTakeoffEvents {
             },
             {GenericEvents::ControllerAction::SWITCH_TO_AUTO_MODE, GenericEvents::ControllerAction::START_THROTTLE_INCREASE},
             "切换到自动模式并启动油门增加控制器",
-            false
+            false,
+            nullptr   // 无连续守卫：事件时刻取检测到 trigger_condition 的步边界
         }},
         {ABORT_TAKEOFF, {
             ABORT_TAKEOFF,
             "中止起飞事件",
             [](const SharedStateSpace& state) {
-                return state.velocity.load() >= AbortTakeoffConfig::ABORT_SPEED && 
+                return state.velocity.load() >= state.abort_speed_threshold.load() && 
                        !state.abort_triggered.load();
             },
             {GenericEvents::ControllerAction::STOP_THROTTLE_INCREASE, GenericEvents::ControllerAction::START_THROTTLE_DECREASE, GenericEvents::ControllerAction::START_BRAKE},
             "停止油门增加控制器，启动油门减小控制器，启动刹车控制器",
-            false
+            false,
+            [](const SharedStateSpace& state) {  // 守卫：速度达到中止速度
+                return state.velocity.load() - state.abort_speed_threshold.load();
+            }
         }},
         {START_CRUISE, {
             START_CRUISE,
@@ -119,7 +123,10 @@ namespace AbortTakeoffEvents {
             },
             {GenericEvents::ControllerAction::STOP_THROTTLE_DECREASE, GenericEvents::ControllerAction::STOP_BRAKE, GenericEvents::ControllerAction::START_CRUISE},
             "停止油门减少控制器和刹车控制器，启动巡航控制器",
-            false
+            false,
+            [](const SharedStateSpace& state) {  // 守卫：减速到 15km/h
+                return 4.17 - state.velocity.load();
+            }
         }},
         {START_BRAKE, {
             START_BRAKE,
@@ -129,7 +136,10 @@ namespace AbortTakeoffEvents {
             },
             {GenericEvents::ControllerAction::START_BRAKE},
             "启动刹车控制器",
-            false
+            false,
+            [](const SharedStateSpace& state) {  // 守卫：到达 1000 米刹车点
+                return state.position.load() - 1000.0;
+            }
         }},
         {FINAL_STOP, {
             FINAL_STOP,
@@ -141,7 +151,10 @@ namespace AbortTakeoffEvents {
             },
             {GenericEvents::ControllerAction::STOP_ALL_CONTROLLERS, GenericEvents::ControllerAction::SWITCH_TO_MANUAL_MODE},
             "停止所有控制器并切换到手动模式",
-            false
+            false,
+            [](const SharedStateSpace& state) {  // 守卫：速度降到零速阈值
+                return AbortTakeoffConfig::ZERO_VELOCITY_THRESHOLD - state.velocity.load();
+            }
         }},
     };
 
@@ -34,17 +34,23 @@
 #include "../../include/K_Scenario/event_bus.hpp"                         // ParaSAFE系统头文件, 事件总线，事件发布与订阅
 #include "../../include/K_Scenario/controller_manager.hpp"                // ParaSAFE系统头文件, 控制器管理器，管理各类控制器
 #include "../../include/D_DynamicModel/DynamicsModel_FixedWing_Linear.hpp"   // ParaSAFE系统头文件, 固定翼线性动力学模型，推进物理状态
+#include "../../include/D_DynamicModel/DynamicsModel_FixedWing_Longitudinal.hpp" // ParaSAFE系统头文件, 固定翼纵向三自由度动力学模型（升力、俯仰、起落架）
 #include "../../include/L_Simulation_Settings/simulation_clock.hpp"       // ParaSAFE系统头文件, 仿真时钟，统一时间推进
 #include "../../include/L_Simulation_Settings/thread_manager.hpp"         // ParaSAFE系统头文件, 线程管理器，线程统一管理
+#include "../../include/L_Simulation_Settings/thread_policy.hpp"          // ParaSAFE系统头文件, 线程策略，CPU 亲和性与实时优先级
 #include "../../include/L_Simulation_Settings/simulation_manager.hpp"     // ParaSAFE系统头文件, 仿真管理器，仿真流程控制
 #include "../../include/L_Simulation_Settings/data_recorder.hpp"          // ParaSAFE系统头文件, 文件日志器，数据记录与输出
 #include "../../include/L_Simulation_Settings/simulation_config_base.hpp" // ParaSAFE系统头文件, 仿真配置基类，参数管理
 #include "../../include/C_Flight_Control/controller_config.hpp"                 // ParaSAFE系统头文件, 控制器参数配置
 #include "../../include/K_Scenario/controller_actions_config.hpp"         // ParaSAFE系统头文件, 控制器动作配置，事件-动作映射
-#include "../../include/K_Scenario/state_update_queue.hpp"                // ParaSAFE系统头文件, 状态更新队列，线程间状态同步
-#include "../../include/L_Simulation_Settings/state_manager_thread.hpp"   // ParaSAFE系统头文件, 状态空间线程，管理状态推进
+#include "../../include/L_Simulation_Settings/state_manager_thread.hpp"   // ParaSAFE系统头文件, 状态空间处理，步屏障处提交后缓冲
 #include "../../include/L_Simulation_Settings/logger.hpp"                 // ParaSAFE系统头文件, 日志模块，详细/简要日志输出
 #include "../../include/K_Scenario/event_detection.hpp"                   // ParaSAFE系统头文件, 通用事件检测线程头文件
+#include "../../include/K_Scenario/event_localization.hpp"                // ParaSAFE系统头文件, 步内事件定位（守卫过零检测）
+#include "../../include/L_Simulation_Settings/fused_step_executor.hpp"    // ParaSAFE系统头文件, 单线程融合步进执行器
+#include "../../include/L_Simulation_Settings/task_graph.hpp"             // ParaSAFE系统头文件, 按读写集调度的任务图执行器
+#include "../../include/K_Scenario/simulation_checkpoint.hpp"             // ParaSAFE系统头文件, 整个仿真的检查点保存与恢复
+#include "../../include/L_Simulation_Settings/deterministic_replay.hpp"   // ParaSAFE系统头文件, 确定性记录/回放
 
 // 本科目（中断起飞）头文件：每个科目都需要这几个头文件，如果你在新建一个场景，则需要重新定义这几个头文件
 #include "abort_takeoff_config.hpp"          // 本科目头文件, 配置文件，参数定义
@@ -79,6 +85,43 @@ int main() {
     std::shared_ptr<IDynamicsModel> dynamicsModel = std::make_shared<DynamicsModel_FixedWing_Linear>();
     // 若需切换为非线性模型，只需如下：
     // std::shared_ptr<IDynamicsModel> dynamicsModel = std::make_shared<DynamicsModel_FixedWing_Nonlinear>();
+    // 若需积分俯仰角（升力、俯仰力矩、起落架接地与抬头，俯仰角保持控制器的输出作为升降舵指令），只需如下：
+    // std::shared_ptr<IDynamicsModel> dynamicsModel = std::make_shared<DynamicsModel_FixedWing_Longitudinal>();
+    // 积分方法默认显式欧拉；高阶积分器可配合更大的 SIMULATION_TIME_STEP 使用，只需如下：
+    // dynamicsModel->setIntegrator(Integrator(IntegratorType::RK4));
+
+    // ============================= 执行器模式选择 ============================= //
+    // false: 每个组件一个线程，由仿真时钟屏障同步（默认）
+    // true : 所有组件在一个线程内按 动力学→状态提交→事件→控制器→数据记录 的顺序执行
+    const bool USE_FUSED_EXECUTOR = false;
+    // 仅在 USE_FUSED_EXECUTOR 为 true 时生效：
+    // true : 各组件按声明的状态读写集建立依赖图，无冲突的组件在工作窃取线程池上并行，结果与融合执行器相同
+    const bool USE_TASK_GRAPH = false;
+    // 仅在 USE_FUSED_EXECUTOR 为 true 且不使用任务图时生效：
+    // true : 定义了守卫函数的事件在步内求根定位触发时刻，增大步长时事件时刻不再滞后
+    const bool USE_EVENT_LOCALIZATION = false;
+    // 仅在 USE_FUSED_EXECUTOR 为 true 时生效（检查点在步边界保存和恢复）：
+    // CHECKPOINT_SAVE_TIME > 0 : 仿真时间到达该时刻的步结束时把整个仿真保存到 CHECKPOINT_FILE
+    // RESUME_FROM_CHECKPOINT   : 从 CHECKPOINT_FILE 恢复后继续仿真，不再从 0 秒开始
+    const double CHECKPOINT_SAVE_TIME = 0.0;
+    const bool RESUME_FROM_CHECKPOINT = false;
+    const std::string CHECKPOINT_FILE = "output/checkpoint.bin";
+    // 仅在 USE_FUSED_EXECUTOR 为 true 时生效（确定性记录/回放）：
+    // Record: 把外部命令、事件分发和每步状态摘要写入 REPLAY_LOG_FILE，stop 命令在步边界生效
+    // Replay: 按 REPLAY_LOG_FILE 在相同的步施加外部命令，逐步核对事件与状态摘要，按最快速度运行
+    const ReplayMode REPLAY_MODE = ReplayMode::Off;
+    const std::string REPLAY_LOG_FILE = "output/replay_log.txt";
+
+    // ============================= 时钟运行模式选择 ============================= //
+    // AsFastAsPossible: 不与墙钟同步，批量仿真用；RealTime: 与墙钟 1:1；ScaledRealTime: N 倍实时
+    SimulationClock::getInstance().setRunMode(SimulationClock::RunMode::AsFastAsPossible);
+    // 若需按墙钟回放，只需如下：
+    // SimulationClock::getInstance().setRunMode(SimulationClock::RunMode::RealTime);
+    // SimulationClock::getInstance().setRunMode(SimulationClock::RunMode::ScaledRealTime, 4.0);
+    if (USE_FUSED_EXECUTOR && REPLAY_MODE == ReplayMode::Replay) {
+        SimulationClock::getInstance().setRunMode(SimulationClock::RunMode::AsFastAsPossible); // 回放不与墙钟同步
+    }
+    SimulationClock::getInstance().setLatencyReportOnStop(true); // 时钟停止时把各线程的延迟统计写入日志
 
     // =============================== 初始化定义部分 =============================== // 
 
@@ -90,6 +133,7 @@ int main() {
     std::cout << "[主函数] 开始加载配置文件..." << std::endl;
     AbortTakeoffConfig::loadConfig("abort_takeoff_config.txt");
     ControllerActionsConfig::loadConfig("controller_actions_config.txt");
+    ThreadPolicy::loadConfig("thread_policy_config.txt");
     std::cout << "[主函数] 配置文件加载完成" << std::endl;
 
     // 提示仿真开始
@@ -103,17 +147,17 @@ int main() {
     log_brief("[主函数：状态空间] 状态空间已初始化\n");
 
     // 初始化事件总线
-    EventBus bus(state);
+    EventBus bus(state, USE_FUSED_EXECUTOR ? EventBus::DispatchMode::Synchronous : EventBus::DispatchMode::Async);
     log_brief("[主函数：事件总线] 事件总线已初始化\n");
 
-    // 初始化状态更新队列
-    StateUpdateQueue update_queue;
-    log_brief("[主函数：队列] 状态更新队列已初始化\n");
 
     // 初始化控制器管理器
-    ControllerManagerThread controller_manager_thread(state, bus, update_queue);
+    ControllerManagerThread controller_manager_thread(state, bus);
     log_brief("[主函数：控制器管理器] 控制器管理器已初始化\n");
 
+    // 融合执行器模式下，控制器由执行器逐步调用，不创建独立线程
+    controller_manager_thread.setExternallyStepped(USE_FUSED_EXECUTOR);
+
     // 把"事件-控制器"映射表传递给控制器管理线程
     controller_manager_thread.setEventDefinitions(AbortTakeoffEvents::EVENT_DEFINITIONS);
 
@@ -123,8 +167,21 @@ int main() {
 
     // 初始化仿真控制线程
     SimulationControlThread simulation_control_thread(state, bus);
+    StopConditionSet stop_conditions; // 本场景的停止条件，每步求值，仿真恰好在满足条件的步结束
+    stop_conditions.add(StopConditions::positionAbove(AbortTakeoffConfig::STOP_POSITION_LIMIT));
+    stop_conditions.add(StopConditions::timeAbove(AbortTakeoffConfig::STOP_TIME_LIMIT));
+    simulation_control_thread.setStopConditions(stop_conditions);
     log_brief("[主函数：仿真控制] 仿真控制线程已初始化\n");
 
+    // 初始化确定性记录/回放会话：记录每个事件分发所在的步，stop 命令在步边界生效
+    DeterministicSession replay_session(USE_FUSED_EXECUTOR ? REPLAY_MODE : ReplayMode::Off, REPLAY_LOG_FILE);
+    if (replay_session.enabled()) {
+        bus.setDispatchObserver([&replay_session](const std::string& event) {
+            replay_session.onEventDispatched(static_cast<uint64_t>(SimulationClock::getInstance().getStepCount()), event);
+        });
+        simulation_control_thread.setDeterministicSession(&replay_session);
+    }
+
     // 初始化事件处理器
     controller_manager_thread.setupEventHandlers();
     log_brief("[主函数：事件处理] 事件处理器已设置\n");
@@ -132,6 +189,9 @@ int main() {
     // 初始化数据记录器
     FileLogger logger("abort_takeoff_log.txt");
     DataRecorderThread data_recorder_thread(state, SimulationClock::getInstance(), logger);
+    // 数据记录与事件检测默认每个时间步一次；如需降频（时钟只在调度步唤醒对应线程），只需如下：
+    // data_recorder_thread.setRecordPeriod(0.1);   // 10 Hz
+    // event_monitor_thread.setCheckPeriod(0.02);   // 50 Hz
     auto start_data_recorder = [&]() {
         data_recorder_thread.start();
         log_brief("[主函数：数据输出] 数据输出线程已启动\n");
@@ -164,6 +224,7 @@ int main() {
     auto stop_clock = [&]() {
         SimulationClock::getInstance().stop();
         log_brief("[主函数：时钟] 仿真时钟已停止\n");
+        SimulationClock::getInstance().reportRunStats();
         if (clock_thread_started && clock_thread.joinable()) {
             clock_thread.join();
             log_brief("[主函数：时钟] 仿真时钟线程已停止\n");
@@ -192,21 +253,23 @@ int main() {
         log_brief("[主函数：控制器管理器] 控制器管理线程已停止\n");
     };
 
-    // 定义状态空间线程的启停函数
-    StateManagerThread state_manager(state, update_queue, SimulationClock::getInstance());
+    // 定义状态空间处理的启停函数（挂到时钟步屏障，不占用线程）
+    StateManagerThread state_manager(state, SimulationClock::getInstance());
     auto start_state_manager = [&]() {
         state_manager.start();
-        log_brief("[主函数：状态空间] 状态空间线程已启动\n");
+        log_brief("[主函数：状态空间] 状态提交已挂到时钟步屏障\n");
     };
     auto stop_state_manager = [&]() {
         state_manager.stop();
-        log_brief("[主函数：状态空间线程] 状态空间线程已停止\n");
+        log_brief("[主函数：状态空间] 状态提交已从时钟步屏障移除\n");
     };
 
-    
+    // 定义动力学模型线程的启停函数
+    std::thread dynamics_thread;
+    bool dynamics_thread_started = false;
     auto start_dynamics = [&]() {
         if (!dynamics_thread_started) {
-            dynamics_thread = std::thread([&state, &update_queue, &bus, aircraftConfig, forceModel, dynamicsModel]() {
+            dynamics_thread = std::thread([&state, &bus, aircraftConfig, forceModel, dynamicsModel]() {
                 ThreadNaming::set_current_thread_name("DynamicsModel");
                 log_brief("[主函数：动力学模型] 动力学模型线程已启动\n");
                 SimulationClock::getInstance().registerThread();
@@ -219,9 +282,8 @@ int main() {
                         log_brief("[主函数：动力学模型] 时钟已停止，退出循环\n");
                         break;
                     }
-                    state.simulation_time.store(SimulationClock::getInstance().getCurrentTime());
                     log_brief("[主函数：动力学模型] 开始更新动力学模型\n");
-                    dynamicsModel->step(state, update_queue, bus, SimulationClock::getInstance(), aircraftConfig, forceModel);
+                    dynamicsModel->step(state, bus, SimulationClock::getInstance(), aircraftConfig, forceModel);
                     log_brief("[主函数：动力学模型] 通知时钟步骤已完成\n");
                     SimulationClock::getInstance().notifyStepCompleted();
                     log_brief("[主函数：动力学模型] 动力学模型更新完成\n");
@@ -249,15 +311,139 @@ int main() {
         simulation_control_thread.join();
         log_brief("[主函数：仿真控制] 仿真控制线程已停止\n");
     };
+
+    // 定义检查点的保存与恢复函数（融合执行器与任务图执行器共用，均在步边界调用）
+    bool checkpoint_saved = false;
+    auto save_checkpoint_if_due = [&]() {
+        if (checkpoint_saved || CHECKPOINT_SAVE_TIME <= 0.0) return;
+        if (SimulationClock::getInstance().getCurrentTime() < CHECKPOINT_SAVE_TIME) return;
+        checkpoint_saved = true;
+        const std::string blob = SimulationCheckpoint::capture(state, SimulationClock::getInstance(), event_monitor_thread,
+                                                               controller_manager_thread, &data_recorder_thread);
+        if (Checkpoint::saveToFile(blob, CHECKPOINT_FILE)) {
+            log_brief("[主函数：检查点] 已保存到 " + CHECKPOINT_FILE + "\n");
+        } else {
+            log_brief("[主函数：检查点] 保存失败: " + CHECKPOINT_FILE + "\n");
+        }
+    };
+    auto begin_from_checkpoint_or_initial_state = [&]() {
+        if (!RESUME_FROM_CHECKPOINT) {
+            data_recorder_thread.recordInitialState();
+        } else {
+            std::string blob;
+            if (!Checkpoint::loadFromFile(CHECKPOINT_FILE, blob)) {
+                log_brief("[主函数：检查点] 读取失败: " + CHECKPOINT_FILE + "\n");
+                return false;
+            }
+            if (!SimulationCheckpoint::restore(blob, state, SimulationClock::getInstance(), event_monitor_thread,
+                                               controller_manager_thread, &data_recorder_thread)) {
+                return false;
+            }
+        }
+        if (!replay_session.begin(state)) {
+            log_brief("[主函数：回放] 无法开始回放: " + replay_session.divergence() + "\n");
+            return false;
+        }
+        return true;
+    };
+    auto finish_replay_session = [&]() {
+        if (!replay_session.enabled()) return;
+        const bool ok = replay_session.finish();
+        if (REPLAY_MODE == ReplayMode::Record) {
+            log_brief(ok ? "[主函数：记录] 回放日志已写入 " + REPLAY_LOG_FILE + "\n"
+                         : "[主函数：记录] 回放日志写入失败: " + REPLAY_LOG_FILE + "\n");
+        } else {
+            log_brief(ok ? std::string("[主函数：回放] 回放与记录逐位一致\n")
+                         : "[主函数：回放] 与记录不一致，" + replay_session.divergence() + "\n");
+        }
+    };
+
+    // 定义融合执行器的运行函数：各组件作为阶段在当前线程内按固定顺序执行
+    auto run_fused_executor = [&]() {
+        SimulationClock& clock = SimulationClock::getInstance();
+        FusedStepExecutor executor(clock, state);
+        EventLocalizer localizer(state, event_monitor_thread, dynamicsModel, aircraftConfig, forceModel,
+                                 [&](double dt) { controller_manager_thread.stepActivatedControllers(dt); },
+                                 [&]() { state_manager.processStep(); });
+        executor.setStage(FusedStage::Dynamics, [&]() {
+            if (USE_EVENT_LOCALIZATION) {
+                localizer.step(clock.getCurrentTime() - clock.getTimeStep(), clock.getTimeStep());
+                return;
+            }
+            dynamicsModel->step(state, bus, clock, aircraftConfig, forceModel);
+        });
+        executor.setStage(FusedStage::StateCommit, [&]() { state_manager.processStep(); });
+        executor.setStage(FusedStage::Events, [&]() { event_monitor_thread.checkEventsOnce(clock.getCurrentTime()); },
+                          event_monitor_thread.getRateDivisor());
+        executor.setStage(FusedStage::Controllers, [&]() { controller_manager_thread.stepControllers(clock.getTimeStep()); });
+        executor.setStage(FusedStage::Recorder, [&]() { data_recorder_thread.recordStep(); },
+                          data_recorder_thread.getRateDivisor());
+        executor.setStopCondition([&]() {
+            save_checkpoint_if_due();
+            return simulation_control_thread.checkStopConditions();
+        });
+        log_brief("[主函数：融合执行器] 融合执行器开始运行\n");
+        if (begin_from_checkpoint_or_initial_state()) executor.run();
+        controller_manager_thread.stopAllControllers();
+        finish_replay_session();
+        log_brief("[主函数：融合执行器] 融合执行器已结束\n");
+        clock.reportRunStats();
+    };
+
+    // 定义任务图执行器的运行函数：各组件作为带读写集的任务，按声明顺序建立依赖、无冲突时并行
+    auto run_task_graph_executor = [&]() {
+        SimulationClock& clock = SimulationClock::getInstance();
+        TaskGraphExecutor executor(clock, state);
+        executor.addTask("动力学", dynamicsModel->stateAccess() | forceModel->stateAccess(), [&]() {
+            dynamicsModel->step(state, bus, clock, aircraftConfig, forceModel);
+        });
+        executor.addTask("状态提交", StateManagerThread::stateAccess(), [&]() { state_manager.processStep(); });
+        executor.addTask("事件检测", event_monitor_thread.stateAccess(),
+                         [&]() { event_monitor_thread.checkEventsOnce(clock.getCurrentTime()); },
+                         event_monitor_thread.getRateDivisor());
+        for (const auto& controller : controller_manager_thread.getControllers()) {
+            executor.addTask(controller->getName(), controller->stateAccess(), [&clock, controller]() {
+                if (controller->isActive()) controller->stepOnce(clock.getTimeStep());
+            });
+        }
+        executor.addTask("数据记录", DataRecorderThread::stateAccess(), [&]() { data_recorder_thread.recordStep(); },
+                         data_recorder_thread.getRateDivisor());
+        executor.setStopCondition([&]() {
+            save_checkpoint_if_due();
+            return simulation_control_thread.checkStopConditions();
+        });
+        log_brief("[主函数：任务图执行器] 任务图执行器开始运行\n");
+        if (begin_from_checkpoint_or_initial_state()) executor.run();
+        controller_manager_thread.stopAllControllers();
+        finish_replay_session();
+        log_brief("[主函数：任务图执行器] 任务图执行器已结束\n");
+        clock.reportRunStats();
+    };
    // ============================ 各线程的启停函数定义完成 ============================ // 
 
 
 
+    // ================================ 融合执行器模式 ================================ // 
+    // 仅启动仿真控制线程（控制通道），其余组件在当前线程内步进
+    if (USE_FUSED_EXECUTOR) {
+        start_simulation_control();
+        if (USE_TASK_GRAPH) {
+            run_task_graph_executor();
+        } else {
+            run_fused_executor();
+        }
+        stop_simulation_control();
+        log_brief("========= 仿真结束 =========\n");
+        return 0;
+    }
+
     // ================================ 按顺序启动线程 ================================ // 
     // 注意，顺序不能乱，线程的启动顺序会影响同步与实时特性
+    // 时钟先于其他线程启动，须等事件监测、动力学、数据记录3个常驻线程注册后再发布第一步
+    SimulationClock::getInstance().setStartParticipants(3);
     start_simulation_control(); //第1个启动，控制仿真进程
-    start_clock();              //第2个启动，控制同步性与实时性
-    start_state_manager();      //第3个启动，管理共享状态空间
+    start_state_manager();      //第2个启动，在时钟步屏障处提交共享状态空间，须在时钟启动之前
+    start_clock();              //第3个启动，控制同步性与实时性
     start_event_monitor();      //第4个启动，开始进行事件监测
     start_controller_manager(); //第5个启动，事件驱动控制器
     start_dynamics();           //第6个启动，动力学模型运行
@@ -265,17 +451,15 @@ int main() {
     
 
     // 等待仿真结束
-    while (state.simulation_running.load(std::memory_order_acquire)) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+    state.wait_for_simulation_end(); // 停止条件成立或控制通道收到 stop 命令时唤醒
 
     // ============================== 停止所有线程，反顺序 ============================== // 
     stop_data_recorder();
     stop_dynamics();
     stop_controller_manager();
     stop_event_monitor(); 
-    stop_state_manager();
     stop_clock();
+    stop_state_manager();       // 时钟停止后才能取消步提交回调
     stop_simulation_control();
 
     // 提示仿真结束       
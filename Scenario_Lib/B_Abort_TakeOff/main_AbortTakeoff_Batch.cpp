@@ -0,0 +1,291 @@
+/********************************************************************************************************************
+ * @file main_AbortTakeoff_Batch.cpp
+ * @brief 中止起飞场景批量仿真主程序：同一进程内并发扫描中止速度
+ *
+ * 每个仿真使用独立的 SimulationContext（时钟、状态空间、事件总线）和单线程融合执行器，
+ * 所有仿真共享一个 BatchRunner 线程池，线程数等于硬件线程数而不随仿真数量增长。
+ * 每个仿真的数据写入 output/data_abort_<中止速度>.csv，结束后汇总各中止速度下的停止位置。
+ *
+ * 场景参数仍由 abort_takeoff_config.txt 加载（所有仿真共享、只读），扫描的中止速度通过
+ * state.abort_speed_threshold 逐个仿真覆盖。
+ *
+ * 中止、刹车、停止等事件在步内定位触发时刻（EventLocalizer），停止位置对步长不敏感，
+ * 扫描时可把 SIMULATION_TIME_STEP 调大以缩短运行时间。
+ *
+ * 各中止速度在达到最小中止速度之前的起飞滑跑完全相同：默认只仿真一次这段公共前缀，
+ * 在分支点保存检查点，各中止速度从检查点恢复后只仿真后缀（见 what_if_branching.hpp），
+ * 每个 CSV 仍包含从 0 秒开始的完整数据。
+ *
+ * ******************************************************************************************************************/
+
+// 系统头文件
+#include <iostream>           //C++系统头文件,  标准输入输出流
+#include <windows.h>          //C++系统头文件,  Windows API，控制台编码设置等
+#include <memory>             //C++系统头文件,  智能指针库
+#include <sstream>            //C++系统头文件,  字符串流库，格式化输出
+#include <iomanip>            //C++系统头文件,  输入输出流格式控制库
+#include <vector>             //C++系统头文件,  向量容器
+#include <string>             //C++系统头文件,  字符串库
+#include <chrono>             //C++系统头文件,  时间库，计时
+#include <algorithm>          //C++系统头文件,  算法库，最小中止速度
+#include <limits>             //C++系统头文件,  数值极限，前缀的中止速度阈值
+
+// ParaSAFE系统头文件
+#include "../../include/L_Simulation_Settings/simulation_context.hpp"     // ParaSAFE系统头文件, 仿真上下文，每个仿真独占的时钟与状态
+#include "../../include/L_Simulation_Settings/batch_runner.hpp"           // ParaSAFE系统头文件, 批量仿真运行器，共享线程池
+#include "../../include/L_Simulation_Settings/fused_step_executor.hpp"    // ParaSAFE系统头文件, 单线程融合步进执行器
+#include "../../include/K_Scenario/controller_manager.hpp"                // ParaSAFE系统头文件, 控制器管理器，管理各类控制器
+#include "../../include/K_Scenario/event_detection.hpp"                   // ParaSAFE系统头文件, 通用事件检测
+#include "../../include/K_Scenario/event_localization.hpp"                // ParaSAFE系统头文件, 步内事件定位
+#include "../../include/K_Scenario/controller_actions_config.hpp"         // ParaSAFE系统头文件, 控制器动作配置，事件-动作映射
+#include "../../include/D_DynamicModel/DynamicsModel_FixedWing_Linear.hpp" // ParaSAFE系统头文件, 固定翼线性动力学模型
+#include "../../include/L_Simulation_Settings/simulation_manager.hpp"     // ParaSAFE系统头文件, 仿真控制（停止条件）
+#include "../../include/L_Simulation_Settings/data_recorder.hpp"          // ParaSAFE系统头文件, 数据记录
+#include "../../include/L_Simulation_Settings/state_manager_thread.hpp"   // ParaSAFE系统头文件, 状态空间处理
+#include "../../include/L_Simulation_Settings/logger.hpp"                 // ParaSAFE系统头文件, 日志模块
+#include "../../include/L_Simulation_Settings/what_if_branching.hpp"      // ParaSAFE系统头文件, 假设分析分支，共享公共前缀
+#include "../../include/K_Scenario/simulation_checkpoint.hpp"             // ParaSAFE系统头文件, 整个仿真的检查点保存与恢复
+
+// 本科目头文件
+#include "abort_takeoff_config.hpp"          // 本科目头文件, 配置文件，参数定义
+#include "abort_takeoff_events.hpp"          // 本科目头文件, 事件定义，事件枚举与条件
+#include "abort_takeoff_initial_state.hpp"   // 本科目头文件, 初始状态，仿真初始值
+
+// 头文件：飞机构型库
+#include "A_Aircraft_Configuration/aircraft_config.hpp"
+#include "A_Aircraft_Configuration/AircraftConfig_FixedWin_AC2.hpp"
+
+// 单个仿真的结果
+struct AbortTakeoffResult {
+    double abort_speed = 0.0;     // 中止速度（m/s）
+    double stop_position = 0.0;   // 仿真结束时的位置（m）
+    double end_time = 0.0;        // 仿真结束时间（s）
+    size_t steps = 0;             // 执行步数（分支运行时只含后缀）
+    bool branched = false;        // 是否从公共前缀的分支点继续
+};
+
+// 是否在步内定位事件时刻；false 时事件只在步边界检测，最多滞后一个步长
+static const bool USE_EVENT_LOCALIZATION = true;
+
+// 是否用假设分析分支扫描：只仿真一次到达最小中止速度之前的公共前缀，各中止速度从分支点继续；
+// false 时每个中止速度都从 0 秒完整仿真
+static const bool USE_WHAT_IF_BRANCHING = true;
+
+// 一次中止起飞仿真的全部对象：公共前缀和每个变体各构造一个
+class AbortTakeoffSimulation {
+public:
+    explicit AbortTakeoffSimulation(const std::string& data_path)
+        : data_path_(data_path),
+          controller_manager_(ctx_.state, ctx_.bus),
+          event_monitor_(ctx_.state, ctx_.bus, AbortTakeoffEvents::EVENT_DEFINITIONS),
+          simulation_control_(ctx_.state, ctx_.bus), // 只用于停止条件检查，不启动控制通道
+          state_manager_(ctx_.state, ctx_.clock),
+          logger_("abort_takeoff_log.txt", data_path),
+          data_recorder_(ctx_.state, ctx_.clock, logger_),
+          executor_(ctx_.clock, ctx_.state),
+          localizer_(ctx_.state, event_monitor_, dynamicsModel_, aircraftConfig_, forceModel_,
+                     [this](double dt) { controller_manager_.stepActivatedControllers(dt); },
+                     [this]() { state_manager_.processStep(); }) {
+        controller_manager_.setExternallyStepped(true);
+        controller_manager_.setEventDefinitions(AbortTakeoffEvents::EVENT_DEFINITIONS);
+        controller_manager_.setupEventHandlers();
+
+        // 飞机停止即结束，不再空跑到时间上限。FINAL_STOP 事件还要求 abort_triggered，而场景中没有动作置位该标志，
+        // 这里直接判断：中止事件已触发且速度降到零速阈值
+        StopConditionSet stop_conditions;
+        stop_conditions.add("最终停止", [this](const SharedStateSpace& state) {
+            return event_monitor_.isTriggered(AbortTakeoffEvents::ABORT_TAKEOFF)
+                && state.velocity.load() <= AbortTakeoffConfig::ZERO_VELOCITY_THRESHOLD;
+        }, "飞机已停止");
+        stop_conditions.add(StopConditions::positionAbove(AbortTakeoffConfig::STOP_POSITION_LIMIT));
+        stop_conditions.add(StopConditions::timeAbove(AbortTakeoffConfig::STOP_TIME_LIMIT));
+        simulation_control_.setStopConditions(stop_conditions);
+
+        executor_.setStage(FusedStage::Dynamics, [this]() {
+            if (USE_EVENT_LOCALIZATION) {
+                localizer_.step(ctx_.clock.getCurrentTime() - ctx_.clock.getTimeStep(), ctx_.clock.getTimeStep());
+                return;
+            }
+            dynamicsModel_->step(ctx_.state, ctx_.bus, ctx_.clock, aircraftConfig_, forceModel_);
+        });
+        executor_.setStage(FusedStage::StateCommit, [this]() { state_manager_.processStep(); });
+        executor_.setStage(FusedStage::Events, [this]() { event_monitor_.checkEventsOnce(ctx_.clock.getCurrentTime()); });
+        executor_.setStage(FusedStage::Controllers, [this]() { controller_manager_.stepControllers(ctx_.clock.getTimeStep()); });
+        executor_.setStage(FusedStage::Recorder, [this]() { data_recorder_.recordStep(); });
+    }
+
+    // 从 0 秒开始：按场景初始化状态并写入初始数据行
+    void initialize(double abort_speed) {
+        AbortTakeoffInitialState::initializeMotionState(ctx_.state, aircraftConfig_);
+        ctx_.state.abort_speed.store(abort_speed);
+        ctx_.state.abort_speed_threshold.store(abort_speed);
+        ctx_.state.simulation_started = true;
+        ctx_.state.setSimulationRunning(true);
+        data_recorder_.recordInitialState();
+    }
+
+    // 从分支点继续：数据文件以前缀数据开头，恢复整个仿真后施加变体的参数覆盖
+    bool branchFrom(const BranchPoint& point, const WhatIfVariant& variant) {
+        if (!WhatIfBranching::seedDataFile(point, data_path_)) return false;
+        if (!SimulationCheckpoint::restore(*point.snapshot, ctx_.state, ctx_.clock, event_monitor_,
+                                           controller_manager_, &data_recorder_)) {
+            return false;
+        }
+        if (variant.overlay) variant.overlay(ctx_.state);
+        return true;
+    }
+
+    // 运行到停止条件成立；branch_condition 成立时提前返回而不结束仿真（公共前缀用）
+    void run(std::function<bool(const SharedStateSpace&)> branch_condition = nullptr) {
+        executor_.setStopCondition([this, branch_condition]() {
+            if (simulation_control_.checkStopConditions()) return true;
+            return branch_condition && branch_condition(ctx_.state);
+        });
+        executor_.run();
+    }
+
+    void finish() { controller_manager_.stopAllControllers(); }
+
+    std::string capture() const {
+        return SimulationCheckpoint::capture(ctx_.state, ctx_.clock, event_monitor_, controller_manager_, &data_recorder_);
+    }
+
+    // 仿真是否已由停止条件结束
+    bool ended() const { return !ctx_.state.isSimulationRunning(); }
+
+    AbortTakeoffResult result(double abort_speed, bool branched) const {
+        AbortTakeoffResult r;
+        r.abort_speed = abort_speed;
+        r.stop_position = ctx_.state.position.load();
+        r.end_time = ctx_.clock.getCurrentTime();
+        r.steps = executor_.getExecutedSteps();
+        r.branched = branched;
+        return r;
+    }
+
+    const SharedStateSpace& state() const { return ctx_.state; }
+    double getCurrentTime() const { return ctx_.clock.getCurrentTime(); }
+    size_t getExecutedSteps() const { return executor_.getExecutedSteps(); }
+
+private:
+    std::shared_ptr<AircraftConfigBase> aircraftConfig_ = std::make_shared<AircraftConfig_FixedWin_AC2>();
+    std::shared_ptr<IForceModel> forceModel_ = std::make_shared<ACForceModel>();
+    std::shared_ptr<IDynamicsModel> dynamicsModel_ = std::make_shared<DynamicsModel_FixedWing_Linear>();
+    std::string data_path_;
+
+    SimulationContext ctx_; // 独立时钟 + 状态空间 + 同步事件总线
+    ControllerManagerThread controller_manager_;
+    EventMonitorThread event_monitor_;
+    SimulationControlThread simulation_control_;
+    StateManagerThread state_manager_;
+    FileLogger logger_;
+    DataRecorderThread data_recorder_;
+    FusedStepExecutor executor_;
+    EventLocalizer localizer_;
+};
+
+static std::string dataPath(double abort_speed) {
+    std::ostringstream path;
+    path << "output/data_abort_" << std::fixed << std::setprecision(1) << abort_speed << ".csv";
+    return path.str();
+}
+
+// 从 0 秒完整运行一次中止起飞仿真
+static AbortTakeoffResult runAbortTakeoff(double abort_speed) {
+    AbortTakeoffSimulation sim(dataPath(abort_speed));
+    sim.initialize(abort_speed);
+    sim.run();
+    sim.finish();
+    return sim.result(abort_speed, false);
+}
+
+// 假设分析分支扫描：公共前缀只仿真一次（中止速度阈值设为无穷大，中止事件不会触发），
+// 在速度即将达到最小中止速度的步边界分支，各中止速度从分支点继续
+static std::vector<AbortTakeoffResult> runAbortTakeoffBranched(BatchRunner& runner, const std::vector<double>& abort_speeds) {
+    const double min_speed = *std::min_element(abort_speeds.begin(), abort_speeds.end());
+    const std::string prefix_path = "output/data_abort_prefix.csv";
+
+    AbortTakeoffSimulation prefix(prefix_path);
+    prefix.initialize(std::numeric_limits<double>::infinity());
+    prefix.run([min_speed](const SharedStateSpace& s) {
+        // 下一步可能越过最小中止速度时分支；分支点必须早于任何变体的中止事件
+        return s.velocity.load() + 2.0 * std::max(s.acceleration.load(), 0.0) * s.clock().getTimeStep() >= min_speed;
+    });
+    if (prefix.ended()) {
+        std::cout << "[主函数] 公共前缀未到达最小中止速度即结束，改为逐个完整仿真" << std::endl;
+        std::vector<AbortTakeoffResult> results(abort_speeds.size());
+        for (size_t i = 0; i < abort_speeds.size(); ++i) {
+            runner.submit([&results, &abort_speeds, i]() { results[i] = runAbortTakeoff(abort_speeds[i]); });
+        }
+        runner.wait();
+        return results;
+    }
+    const double branch_velocity = prefix.state().velocity.load();
+    const BranchPoint point = WhatIfBranching::makeBranchPoint(prefix.capture(), prefix.getCurrentTime(),
+                                                               prefix.getExecutedSteps(), prefix_path);
+    std::cout << "[主函数] 公共前缀 " << point.steps << " 步，在 t=" << std::fixed << std::setprecision(2)
+              << point.time << "s（速度 " << branch_velocity << "m/s）分支" << std::endl;
+
+    std::vector<WhatIfVariant> variants;
+    for (double v : abort_speeds) {
+        variants.push_back({dataPath(v), [v](SharedStateSpace& s) {
+            s.abort_speed.store(v);
+            s.abort_speed_threshold.store(v);
+        }});
+    }
+    return WhatIfBranching::fork<AbortTakeoffResult>(runner, point, variants,
+        [&abort_speeds, &variants, branch_velocity](const BranchPoint& p, const WhatIfVariant& variant) {
+            const double abort_speed = abort_speeds[&variant - variants.data()]; // variants 与 abort_speeds 一一对应
+            if (abort_speed <= branch_velocity) return runAbortTakeoff(abort_speed); // 已越过分支点，不能共享前缀
+            AbortTakeoffSimulation sim(variant.name);
+            if (!sim.branchFrom(p, variant)) return runAbortTakeoff(abort_speed);
+            sim.run();
+            sim.finish();
+            return sim.result(abort_speed, true);
+        });
+}
+
+int main() {
+    SetConsoleOutputCP(CP_UTF8);
+    SetConsoleCP(CP_UTF8);
+
+    std::cout << "[主函数] 开始加载配置文件..." << std::endl;
+    AbortTakeoffConfig::loadConfig("abort_takeoff_config.txt");
+    ControllerActionsConfig::loadConfig("controller_actions_config.txt");
+    ThreadPolicy::loadConfig("thread_policy_config.txt"); // 可为 BatchWorker0、BatchWorker1 ... 绑定核心
+    std::cout << "[主函数] 配置文件加载完成" << std::endl;
+
+    // 多个仿真并发写同一日志文件没有意义，批量模式下关闭逐步日志
+    Logger::getInstance().disable();
+
+    // =============================== 扫描参数 =============================== //
+    std::vector<double> abort_speeds;
+    for (double v = 20.0; v <= 60.0; v += 2.5) abort_speeds.push_back(v);
+
+    std::vector<AbortTakeoffResult> results(abort_speeds.size());
+    BatchRunner runner; // 线程数默认等于硬件线程数
+    std::cout << "[主函数] " << abort_speeds.size() << " 个仿真，" << runner.getThreadCount() << " 个工作线程" << std::endl;
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    if (USE_WHAT_IF_BRANCHING) {
+        results = runAbortTakeoffBranched(runner, abort_speeds);
+    } else {
+        for (size_t i = 0; i < abort_speeds.size(); ++i) {
+            runner.submit([&results, &abort_speeds, i]() { results[i] = runAbortTakeoff(abort_speeds[i]); });
+        }
+        runner.wait();
+    }
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    // =============================== 结果汇总 =============================== //
+    std::cout << std::left << std::setw(16) << "abort_speed" << std::setw(16) << "stop_position"
+              << std::setw(12) << "end_time" << std::setw(10) << "steps" << "branched" << std::endl;
+    for (const auto& r : results) {
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(16) << r.abort_speed << std::setw(16) << r.stop_position
+                  << std::setw(12) << r.end_time << std::setw(10) << r.steps << (r.branched ? "yes" : "no") << std::endl;
+    }
+    std::cout << "[主函数] 批量仿真完成，失败 " << runner.getFailedCount() << " 个，墙钟时间 "
+              << std::setprecision(2) << wall << "s" << std::endl;
+    return 0;
+}
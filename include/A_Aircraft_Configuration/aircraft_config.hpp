@@ -29,4 +29,18 @@ public:
     // 可扩展更多参数...
 };
 
+// 力学计算用到的构型参数（按值保存，批量计算时按字段分列存放在 FleetState 中）
+struct AircraftParams {
+    double mass;                          // 质量（kg）
+    double max_thrust;                    // 最大推力（N）
+    double max_brake_force;               // 最大刹车力（N）
+    double drag_coefficient;              // 阻力系数
+    double static_friction_coefficient;   // 静摩擦系数
+
+    static AircraftParams from(const AircraftConfigBase& config) {
+        return AircraftParams{config.getMass(), config.getMaxThrust(), config.getMaxBrakeForce(),
+                              config.getDragCoefficient(), config.getStaticFrictionCoefficient()};
+    }
+};
+
 #endif // AIRCRAFT_CONFIG_INTERFACE_H 
\ No newline at end of file
@@ -4,108 +4,85 @@
 #include <atomic>
 #include <cmath>
 #include <memory>
+#include <type_traits>
 
 // ParaSAFE头文件
 #include "../K_Scenario/shared_state.hpp"
 #include "../A_Aircraft_Configuration/aircraft_config.hpp"
+#include "../K_Scenario/state_access.hpp"
+#include "../K_Scenario/fleet_state.hpp"
+#include "ForcePipeline.hpp"   // 编译期组合的各项力（ForceResult）
 
 // 使用配置文件中的参数
 // using namespace SimulationConfig; // 如有需要，可按需开启
 
-// 计算合外力
-struct ForceResult {
-    double net_force;      // 合外力
-    double thrust;         // 推力
-    double drag;           // 阻力
-    double brake_force;    // 刹车力
-    double static_friction;// 静摩擦力
-};
-
 // 力学模型接口
 class IForceModel {
 public:
     virtual ~IForceModel() = default;
     virtual ForceResult calculateNetForce(const SharedStateSpace& state, double current_velocity, std::shared_ptr<AircraftConfigBase> aircraftConfig) = 0;
-};
+    // 一次计算整个机队的力：读取各机油门、刹车、速度列，写入推力、阻力、刹车力列和合外力列
+    // 返回 false 表示该模型不支持机队计算
+    virtual bool calculateFleetForces(FleetState& /*fleet*/) const { return false; }
+    // 力的计算是否与 LinearForcePipeline 逐位一致：是则动力学模型可把力与推进融合为一次 SIMD 扫描
+    // （FleetSimd::stepLinearEuler）；派生类改变力的计算时须返回 false
+    virtual bool isLinearPipeline() const { return false; }
+    // 从状态空间读取的字段（速度由调用方传入，计入动力学模型的读集）
+    virtual StateAccess stateAccess() const {
+        return StateAccess::of({StateField::Throttle, StateField::Brake}, {});
+    }
 
-// 线性力学模型实现
-class ACForceModel : public IForceModel {
-public:
-    ForceResult calculateNetForce(const SharedStateSpace& state, double current_velocity, std::shared_ptr<AircraftConfigBase> aircraftConfig) override {
-        ForceResult result;
-        
-        // 计算推力
-        result.thrust = state.throttle.load() * aircraftConfig->getMaxThrust();
-        
-        // 计算阻力
-        const double AIR_DENSITY = 1.225;  // 空气密度 (kg/m^3)
-        const double FRONTAL_AREA = 50.0;  // 迎风面积 (m^2)
-        double drag_coeff = aircraftConfig->getDragCoefficient();
-        result.drag = 0.5 * AIR_DENSITY * FRONTAL_AREA * drag_coeff * current_velocity * current_velocity;
-        
-        // 计算刹车力和静摩擦力处理
-        if (std::abs(current_velocity) < 0.01) {
-            // 静止状态：无刹车力，需要考虑静摩擦力
-            result.brake_force = 0.0;
-            double static_friction_coeff = aircraftConfig->getStaticFrictionCoefficient();
-            double normal_force = aircraftConfig->getMass() * 9.81;
-            result.static_friction = static_friction_coeff * normal_force;
-        } else {
-            // 运动状态：有刹车力，无静摩擦力
-            // 速度因子：低速时接近1.0，高速时也接近1.0，避免过度变化
-            double speed_factor = std::min(1.0, std::max(0.3, std::abs(current_velocity) / 50.0)); // 速度因子范围0.3-1.0
-            result.brake_force = state.brake.load() * aircraftConfig->getMaxBrakeForce() * speed_factor;
-            result.static_friction = 0.0; // 运动时无静摩擦力
-        }
-        
-        // 计算合外力
-        result.net_force = result.thrust - result.drag - result.brake_force;
-        
-        // 静止状态下的静摩擦力处理
-        if (std::abs(current_velocity) < 0.01) {
-            if (std::abs(result.net_force) < result.static_friction) {
-                result.net_force = 0; // 力小于静摩擦力，保持静止
-            } else {
-                result.net_force -= result.static_friction * (result.net_force > 0 ? 1 : -1);
-            }
+protected:
+    // 对机队逐架调用单机力计算函数 compute(throttle, brake, velocity, params)，各列顺序读写
+    template <typename Compute>
+    static void computeFleet(FleetState& fleet, Compute compute) {
+        const double* throttle = fleet.column(StateField::Throttle);
+        const double* brake = fleet.column(StateField::Brake);
+        const double* velocity = fleet.column(StateField::Velocity);
+        double* thrust = fleet.column(StateField::Thrust);
+        double* drag = fleet.column(StateField::DragForce);
+        double* brake_force = fleet.column(StateField::BrakeForce);
+        double* net_force = fleet.netForce();
+        const double* mass = fleet.param(FleetParam::Mass).data();
+        const double* max_thrust = fleet.param(FleetParam::MaxThrust).data();
+        const double* max_brake_force = fleet.param(FleetParam::MaxBrakeForce).data();
+        const double* drag_coeff = fleet.param(FleetParam::DragCoefficient).data();
+        const double* static_friction_coeff = fleet.param(FleetParam::StaticFrictionCoefficient).data();
+        for (size_t i = 0, n = fleet.size(); i < n; ++i) {
+            const ForceResult r = compute(throttle[i], brake[i], velocity[i],
+                AircraftParams{mass[i], max_thrust[i], max_brake_force[i], drag_coeff[i], static_friction_coeff[i]});
+            thrust[i] = r.thrust;
+            drag[i] = r.drag;
+            brake_force[i] = r.brake_force;
+            net_force[i] = r.net_force;
         }
-        
-        return result;
     }
 };
 
-// 非线性力学模型实现（示例）
-class ACForceModel_Nonlinear : public IForceModel {
+// 编译期组合的力学流水线到虚接口的适配器
+// 每步仍有一次虚调用、一次 shared_ptr 引用计数和构型参数的虚 getter；需要最低开销时直接调用 Pipeline::compute
+template <typename Pipeline>
+class PipelineForceModel : public IForceModel {
 public:
     ForceResult calculateNetForce(const SharedStateSpace& state, double current_velocity, std::shared_ptr<AircraftConfigBase> aircraftConfig) override {
-        ForceResult result;
-        // 非线性推力：加入速度相关扰动
-        result.thrust = state.throttle.load() * aircraftConfig->getMaxThrust() * (1.0 - 0.1 * std::sin(current_velocity / 10.0));
-        // 非线性阻力：阻力系数随速度变化
-        const double AIR_DENSITY = 1.225;
-        const double FRONTAL_AREA = 50.0;
-        double drag_coeff = aircraftConfig->getDragCoefficient() * (1.0 + 0.05 * std::abs(current_velocity) / 100.0);
-        result.drag = 0.5 * AIR_DENSITY * FRONTAL_AREA * drag_coeff * current_velocity * current_velocity;
-        // 非线性刹车力：刹车效率随速度降低
-        if (std::abs(current_velocity) < 0.01) {
-            result.brake_force = 0.0;
-            double static_friction_coeff = aircraftConfig->getStaticFrictionCoefficient();
-            double normal_force = aircraftConfig->getMass() * 9.81;
-            result.static_friction = static_friction_coeff * normal_force;
-        } else {
-            double speed_factor = std::min(1.0, std::max(0.2, std::abs(current_velocity) / 60.0));
-            // 非线性：刹车力随速度降低而减弱
-            result.brake_force = state.brake.load() * aircraftConfig->getMaxBrakeForce() * speed_factor * (1.0 - 0.1 * std::cos(current_velocity / 15.0));
-            result.static_friction = 0.0;
-        }
-        result.net_force = result.thrust - result.drag - result.brake_force;
-        if (std::abs(current_velocity) < 0.01) {
-            if (std::abs(result.net_force) < result.static_friction) {
-                result.net_force = 0;
-            } else {
-                result.net_force -= result.static_friction * (result.net_force > 0 ? 1 : -1);
-            }
-        }
-        return result;
+        return computeForces(state.throttle.load(), state.brake.load(), current_velocity, AircraftParams::from(*aircraftConfig));
     }
-}; 
\ No newline at end of file
+
+    bool calculateFleetForces(FleetState& fleet) const override {
+        computeFleet(fleet, &Pipeline::compute);
+        return true;
+    }
+
+    bool isLinearPipeline() const override { return std::is_same<Pipeline, LinearForcePipeline>::value; }
+
+    // 单架飞机的力（单机与机队计算共用）
+    static ForceResult computeForces(double throttle, double brake, double current_velocity, const AircraftParams& params) {
+        return Pipeline::compute(throttle, brake, current_velocity, params);
+    }
+};
+
+// 线性力学模型实现：线性推力、二次阻力、速度因子刹车力、静摩擦（LinearForcePipeline）
+class ACForceModel : public PipelineForceModel<LinearForcePipeline> {};
+
+// 非线性力学模型实现（示例）：推力扰动、变阻力系数、刹车效率衰减、静摩擦（NonlinearForcePipeline）
+class ACForceModel_Nonlinear : public PipelineForceModel<NonlinearForcePipeline> {};
@@ -0,0 +1,171 @@
+/*
+ * @file ForcePipeline.hpp
+ * @brief 编译期组合的力学计算流水线头文件
+ *
+ * 合外力由五项组成，每一项是一个只含静态函数的策略类型（policy），在编译期组合为 ForcePipeline：
+ *
+ *     ForcePipeline<推力, 气动阻力, 刹车力, 滚动阻力, 静摩擦>::compute(throttle, brake, velocity, params)
+ *
+ * compute 不含虚调用，构型参数按值（AircraftParams）传入，各项在调用点完全内联。
+ * 虚接口 IForceModel 保留，由 PipelineForceModel<Pipeline>（见 ACForceModel.hpp）适配：
+ * ACForceModel / ACForceModel_Nonlinear 即 LinearForcePipeline / NonlinearForcePipeline 的适配器，
+ * 结果与组合前逐位一致。需要每步最低开销的调用方（批量扫描、基准测试）可直接调用 Pipeline::compute。
+ *
+ * 策略约定（v 为速度，p 为 AircraftParams）：
+ *   - 推力、气动阻力、刹车力、滚动阻力：static double force(double throttle, double brake, double v, const AircraftParams& p)
+ *     返回力的大小，合外力 = 推力 - 阻力 - 刹车力 - 滚动阻力（滚动阻力按速度方向带符号）
+ *   - 静摩擦：static double force(...) 返回最大静摩擦力，
+ *             static double apply(double v, double net_force, double static_friction) 返回修正后的合外力
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <algorithm>   // 速度因子限幅
+#include <cmath>       // 非线性项
+
+// ParaSAFE系统头文件
+#include "../A_Aircraft_Configuration/aircraft_config.hpp"   // 构型参数
+
+// 计算合外力
+struct ForceResult {
+    double net_force;      // 合外力
+    double thrust;         // 推力
+    double drag;           // 阻力
+    double brake_force;    // 刹车力
+    double static_friction;// 静摩擦力
+};
+
+namespace ForceTerms {
+
+constexpr double kAirDensity = 1.225;     ///< 空气密度（kg/m^3）
+constexpr double kFrontalArea = 50.0;     ///< 迎风面积（m^2）
+constexpr double kDragFactor = 0.5 * kAirDensity * kFrontalArea;   ///< 按与原公式相同的顺序折叠
+constexpr double kGravity = 9.81;         ///< 重力加速度（m/s^2）
+constexpr double kStillVelocity = 0.01;   ///< 低于该速度按静止处理（无刹车力，考虑静摩擦）
+
+inline bool isStill(double v) { return std::abs(v) < kStillVelocity; }
+
+// ---------------------------------------------------------------- 推力
+
+/// 线性推力：油门 × 最大推力
+struct LinearThrust {
+    static double force(double throttle, double, double, const AircraftParams& p) {
+        return throttle * p.max_thrust;
+    }
+};
+
+/// 非线性推力：加入速度相关扰动
+struct SpeedDisturbedThrust {
+    static double force(double throttle, double, double v, const AircraftParams& p) {
+        return throttle * p.max_thrust * (1.0 - 0.1 * std::sin(v / 10.0));
+    }
+};
+
+// ---------------------------------------------------------------- 气动阻力
+
+/// 二次阻力：0.5·ρ·A·Cd·v²
+struct QuadraticDrag {
+    static double force(double, double, double v, const AircraftParams& p) {
+        return kDragFactor * p.drag_coefficient * v * v;
+    }
+};
+
+/// 阻力系数随速度增大的二次阻力
+struct SpeedDependentDrag {
+    static double force(double, double, double v, const AircraftParams& p) {
+        const double drag_coeff = p.drag_coefficient * (1.0 + 0.05 * std::abs(v) / 100.0);
+        return kDragFactor * drag_coeff * v * v;
+    }
+};
+
+// ---------------------------------------------------------------- 刹车力
+
+/// 刹车力 × 速度因子（|v|/50，限幅 0.3~1.0），静止时为 0
+struct LinearBrake {
+    static double force(double, double brake, double v, const AircraftParams& p) {
+        if (isStill(v)) return 0.0;
+        const double speed_factor = std::min(1.0, std::max(0.3, std::abs(v) / 50.0));
+        return brake * p.max_brake_force * speed_factor;
+    }
+};
+
+/// 刹车效率随速度降低而减弱（|v|/60，限幅 0.2~1.0，另加余弦扰动），静止时为 0
+struct SpeedFadingBrake {
+    static double force(double, double brake, double v, const AircraftParams& p) {
+        if (isStill(v)) return 0.0;
+        const double speed_factor = std::min(1.0, std::max(0.2, std::abs(v) / 60.0));
+        return brake * p.max_brake_force * speed_factor * (1.0 - 0.1 * std::cos(v / 15.0));
+    }
+};
+
+// ---------------------------------------------------------------- 滚动阻力
+
+/// 不计滚动阻力（原模型）
+struct NoRollingResistance {
+    static double force(double, double, double, const AircraftParams&) { return 0.0; }
+};
+
+/// 轮胎滚动阻力：μr·m·g，μr = PerMille / 1000，方向与速度相反，静止时为 0
+template <int PerMille>
+struct RollingResistance {
+    static constexpr double kCoefficient = PerMille / 1000.0;
+    static double force(double, double, double v, const AircraftParams& p) {
+        if (isStill(v)) return 0.0;
+        const double magnitude = kCoefficient * (p.mass * kGravity);
+        return v > 0 ? magnitude : -magnitude;
+    }
+};
+
+// ---------------------------------------------------------------- 静摩擦
+
+/// 库仑静摩擦：静止时合外力小于 μs·m·g 则保持静止，否则扣除静摩擦力
+struct CoulombStaticFriction {
+    static double force(double, double, double v, const AircraftParams& p) {
+        return isStill(v) ? p.static_friction_coefficient * (p.mass * kGravity) : 0.0;
+    }
+    static double apply(double v, double net_force, double static_friction) {
+        if (!isStill(v)) return net_force;
+        if (std::abs(net_force) < static_friction) return 0;   // 力小于静摩擦力，保持静止
+        return net_force - static_friction * (net_force > 0 ? 1 : -1);
+    }
+};
+
+/// 不计静摩擦
+struct NoStaticFriction {
+    static double force(double, double, double, const AircraftParams&) { return 0.0; }
+    static double apply(double, double net_force, double) { return net_force; }
+};
+
+} // namespace ForceTerms
+
+/**
+ * @struct ForcePipeline
+ * @brief 由五个策略类型在编译期组合的力学计算
+ */
+template <typename Thrust, typename Drag, typename Brake, typename Rolling, typename StaticFriction>
+struct ForcePipeline {
+    /**
+     * @brief 单架飞机的力（签名与 IForceModel::computeFleet 的计算函数一致）
+     */
+    static ForceResult compute(double throttle, double brake, double velocity, const AircraftParams& params) {
+        ForceResult result;
+        result.thrust = Thrust::force(throttle, brake, velocity, params);
+        result.drag = Drag::force(throttle, brake, velocity, params);
+        result.brake_force = Brake::force(throttle, brake, velocity, params);
+        result.static_friction = StaticFriction::force(throttle, brake, velocity, params);
+        // 不计滚动阻力时减去 +0.0 不改变任何值（含 -0.0），编译器直接消去
+        const double net_force = result.thrust - result.drag - result.brake_force
+                               - Rolling::force(throttle, brake, velocity, params);
+        result.net_force = StaticFriction::apply(velocity, net_force, result.static_friction);
+        return result;
+    }
+};
+
+/// 线性力学模型（ACForceModel）的组合
+using LinearForcePipeline = ForcePipeline<ForceTerms::LinearThrust, ForceTerms::QuadraticDrag, ForceTerms::LinearBrake,
+                                          ForceTerms::NoRollingResistance, ForceTerms::CoulombStaticFriction>;
+
+/// 非线性力学模型（ACForceModel_Nonlinear）的组合
+using NonlinearForcePipeline = ForcePipeline<ForceTerms::SpeedDisturbedThrust, ForceTerms::SpeedDependentDrag, ForceTerms::SpeedFadingBrake,
+                                             ForceTerms::NoRollingResistance, ForceTerms::CoulombStaticFriction>;
@@ -45,7 +45,9 @@ public:
     void start() override {
         if (!running) {
             running = true;
-            controller_thread = std::thread(&CruiseOnRunwayController::run, this);
+            if (!externally_stepped) {
+                controller_thread = std::thread(&CruiseOnRunwayController::run, this);
+            }
             log_detail("[跑道巡航控制器] 已启动\n");
         }
     }
@@ -72,10 +74,21 @@ public:
         return state.throttle.load();
     }
 
+    StateAccess stateAccess() const override {
+        return StateAccess::of({StateField::ControlFlags, StateField::Velocity},
+                               {StateField::NextThrottle, StateField::NextBrake});
+    }
+
+    void stepOnce(double /*dt*/) override {
+        if (state.cruise_control_enabled) {
+            updateThrottle();
+        }
+    }
+
 private:
     void run() {
         ThreadNaming::set_current_thread_name("CruiseOnRunwayCtrl");
-        auto& clock = SimulationClock::getInstance();
+        auto& clock = state.clock();
         clock.registerThread(); // 注册线程
         log_detail("[跑道巡航控制器] 开始运行\n");
         size_t current_step = 0; // 记录当前线程处理到的步数
@@ -83,9 +96,7 @@ private:
         while (running && clock.isRunning()) {
             clock.waitForNextStep(current_step);
             current_step = clock.getStepCount();
-            if (state.cruise_control_enabled) {
-                updateThrottle();
-            }
+            stepOnce(clock.getTimeStep());
             // 通知时钟本步骤已完成
             clock.notifyStepCompleted();
         }
@@ -102,9 +113,9 @@ private:
         // 计算油门和刹车
         auto [throttle, brake] = calculateThrottleAndBrake(current_velocity, target_velocity);
         
-        // 更新油门和刹车
-        state.throttle.store(throttle);
-        state.brake.store(brake);
+        // 更新油门和刹车（写入后缓冲，步屏障处提交）
+        state.next.write(StateField::Throttle, throttle);
+        state.next.write(StateField::Brake, brake);
 
         // 打印状态
         printCruiseStatus(current_velocity, target_velocity, throttle, brake);
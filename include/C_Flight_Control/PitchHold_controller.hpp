@@ -65,7 +65,9 @@ public:
     void start() override {
         if (!running) {
             running = true;
-            controller_thread = std::thread(&PitchHoldController::run, this);
+            if (!externally_stepped) {
+                controller_thread = std::thread(&PitchHoldController::run, this);
+            }
             log_detail("[俯仰角保持控制器] 已启动\n");
         }
     }
@@ -108,6 +110,38 @@ public:
         return state.pitch_control_output.load();
     }
 
+    StateAccess stateAccess() const override {
+        return StateAccess::of({StateField::ControlFlags, StateField::PitchAngle}, {StateField::NextPitchControl});
+    }
+
+    /**
+     * @brief 执行一个仿真步的俯仰角控制
+     * @param dt 时间步长（秒）
+     */
+    void stepOnce(double dt) override {
+        if (state.pitch_control_enabled) {
+            updatePitchControl(dt);
+        }
+    }
+
+    void saveCheckpoint(CheckpointWriter& writer) const override {
+        writer.write(target_pitch_angle);
+        writer.write(pid_kp);
+        writer.write(pid_ki);
+        writer.write(pid_kd);
+        writer.write(integral_error);
+        writer.write(previous_error);
+    }
+
+    void restoreCheckpoint(CheckpointReader& reader) override {
+        reader.read(target_pitch_angle);
+        reader.read(pid_kp);
+        reader.read(pid_ki);
+        reader.read(pid_kd);
+        reader.read(integral_error);
+        reader.read(previous_error);
+    }
+
     /**
      * @brief 设置目标俯仰角
      * @param target_pitch 目标俯仰角（弧度）
@@ -174,7 +208,7 @@ private:
      */
     void run() {
         ThreadNaming::set_current_thread_name("PitchHoldCtrl");
-        auto& clock = SimulationClock::getInstance();
+        auto& clock = state.clock();
         clock.registerThread(); // 注册线程
         log_detail("[俯仰角保持控制器] 开始运行\n");
         size_t current_step = 0; // 记录当前线程处理到的步数
@@ -183,9 +217,7 @@ private:
             clock.waitForNextStep(current_step);
             current_step = clock.getStepCount();
             
-            if (state.pitch_control_enabled) {
-                updatePitchControl();
-            }
+            stepOnce(clock.getTimeStep());
             
             // 通知时钟本步骤已完成
             clock.notifyStepCompleted();
@@ -198,14 +230,15 @@ private:
     /**
      * @brief 更新俯仰角控制
      * 计算PID控制输出并应用到飞机状态
+     * @param dt 时间步长（秒）
      */
-    void updatePitchControl() {
+    void updatePitchControl(double dt) {
         // 获取当前状态
         double current_pitch = state.pitch_angle.load();
         double target_pitch = target_pitch_angle.load();
         
         // 计算控制输出
-        double control_output = calculatePIDOutput(current_pitch, target_pitch);
+        double control_output = calculatePIDOutput(current_pitch, target_pitch, dt);
         
         // 应用控制输出到飞机状态
         applyPitchControl(control_output);
@@ -218,9 +251,10 @@ private:
      * @brief 计算PID控制输出
      * @param current_pitch 当前俯仰角
      * @param target_pitch 目标俯仰角
+     * @param dt 时间步长（秒），积分项与微分项按此步长计算
      * @return PID控制输出值
      */
-    double calculatePIDOutput(double current_pitch, double target_pitch) {
+    double calculatePIDOutput(double current_pitch, double target_pitch, double dt) {
         // 计算误差
         double error = target_pitch - current_pitch;
         
@@ -233,13 +267,13 @@ private:
         
         // 积分项
         double ki = pid_ki.load();
-        double integral = integral_error.load() + ki * error * 0.01; // 假设时间步长为0.01s
+        double integral = integral_error.load() + ki * error * dt;
         integral = std::max(-INTEGRAL_LIMIT, std::min(INTEGRAL_LIMIT, integral));
         integral_error.store(integral);
         
         // 微分项
         double kd = pid_kd.load();
-        double derivative = kd * (error - previous_error.load()) / 0.01;
+        double derivative = kd * (error - previous_error.load()) / dt;
         previous_error.store(error);
         
         // 计算总输出
@@ -258,14 +292,12 @@ private:
     void applyPitchControl(double control_output) {
         // 将控制输出应用到飞机状态
         // 这里假设控制输出直接影响俯仰角变化率
-        double pitch_rate = control_output * 0.1; // 缩放因子
-        
         // 更新俯仰角（这里需要根据实际的物理模型来更新）
-        // 暂时直接更新到共享状态中
-        state.pitch_control_output.store(control_output);
+        // 暂时写入共享状态空间的后缓冲，步屏障处提交
+        state.next.write(StateField::PitchControlOutput, control_output);
         
-        // 如果有俯仰角变化率状态变量，也可以更新
-        // state.pitch_rate.store(pitch_rate);
+        // 如果有俯仰角变化率状态变量，也可以按缩放因子 0.1 更新
+        // state.pitch_rate.store(control_output * 0.1);
     }
 
     /**
@@ -22,6 +22,7 @@
 //ParaSAFE头文件
 #include "../K_Scenario/shared_state.hpp"   // 共享状态空间，存储仿真系统的所有状态变量
 #include "../K_Scenario/event_bus.hpp"      // 事件总线，处理事件发布和订阅
+#include "../K_Scenario/state_access.hpp"   // 状态读写集声明，供任务图调度
 
 /**
  * @brief 控制器基类
@@ -30,6 +31,11 @@
  * 实现其纯虚函数接口，实现各自的控制逻辑。
  *
  * 支持线程安全的启动/停止，便于多线程仿真。
+ *
+ * 控制器有两种运行方式：
+ *   - 独立线程：start() 创建控制线程，线程内与仿真时钟同步后调用 stepOnce()
+ *   - 外部步进：setExternallyStepped(true) 后 start() 只置运行标志，
+ *     由单线程执行器在每步调用 stepOnce()（见 FusedStepExecutor）
  */
 class BaseController {
 public:
@@ -68,11 +74,57 @@ public:
      */
     virtual double getCurrentValue() const = 0;
 
+    /**
+     * @brief 执行一个仿真步的控制逻辑
+     * @param dt 时间步长（秒）
+     *
+     * 独立线程模式下由控制线程调用，外部步进模式下由执行器调用。
+     * 默认实现为空，便于旧控制器逐步迁移。
+     */
+    virtual void stepOnce(double /*dt*/) {}
+
+    /**
+     * @brief stepOnce() 每步读写的共享状态字段
+     *
+     * 任务图执行器据此决定控制器之间、控制器与其他组件之间的执行顺序。
+     * 默认读写所有字段（与任何组件串行），新控制器应覆盖为准确的读写集。
+     */
+    virtual StateAccess stateAccess() const { return StateAccess::all(); }
+
+    /**
+     * @brief 写入控制器内部状态（如积分项、上次误差），默认没有内部状态
+     *
+     * 运行状态（是否已启动）由 ControllerManagerThread 统一保存，派生类只写自己的成员。
+     */
+    virtual void saveCheckpoint(CheckpointWriter& /*writer*/) const {}
+
+    /**
+     * @brief 恢复 saveCheckpoint() 写入的内部状态
+     */
+    virtual void restoreCheckpoint(CheckpointReader& /*reader*/) {}
+
+    /**
+     * @brief 设置是否由外部执行器步进（必须在 start() 之前设置）
+     * @param external true 表示 start() 不创建线程
+     */
+    void setExternallyStepped(bool external) { externally_stepped = external; }
+
+    /**
+     * @brief 查询是否由外部执行器步进
+     */
+    bool isExternallyStepped() const { return externally_stepped; }
+
+    /**
+     * @brief 查询控制器是否已启动（start 之后、stop 之前）
+     */
+    bool isActive() const { return running.load(); }
+
 protected:
     SharedStateSpace& state;   ///< 共享状态空间引用，便于控制器读写仿真状态
     EventBus& bus;             ///< 事件总线引用，支持事件驱动控制
     std::atomic<bool> running{false}; ///< 控制器运行状态标志，线程安全
     std::thread controller_thread;    ///< 控制器线程对象，实现独立控制循环
+    bool externally_stepped{false};   ///< 是否由外部执行器步进（不创建控制线程）
 
     /**
      * @brief 构造函数
@@ -43,8 +43,6 @@ using namespace ControllerConfig;
 // 刹车控制器
 class BrakeController : public BaseController {
 private:
-    std::atomic<bool> running{false};
-    std::thread controller_thread;
     double last_update_time{0.0};
 
 public:
@@ -56,7 +54,9 @@ public:
     void start() override {
         if (!running) {
             running = true;
-            controller_thread = std::thread(&BrakeController::run, this);
+            if (!externally_stepped) {
+                controller_thread = std::thread(&BrakeController::run, this);
+            }
         }
     }
 
@@ -82,20 +82,31 @@ public:
         return state.brake.load();
     }
 
+    StateAccess stateAccess() const override {
+        // 刹车写入后缓冲，由状态空间处理在步屏障处提交
+        return StateAccess::of({StateField::ControlFlags, StateField::Brake}, {StateField::NextBrake});
+    }
+
+    void saveCheckpoint(CheckpointWriter& writer) const override { writer.write(last_update_time); }
+    void restoreCheckpoint(CheckpointReader& reader) override { reader.read(last_update_time); }
+
+    void stepOnce(double dt) override {
+        if (state.brake_control_enabled) {
+            updateBrake(dt);
+        }
+    }
+
 private:
     void run() {
         ThreadNaming::set_current_thread_name("BrakeCtrl");
-        const double FIXED_DT = 0.01; // 固定时间步长
-        auto& clock = SimulationClock::getInstance();
+        auto& clock = state.clock();
         clock.registerThread(); // 注册线程
         size_t current_step = 0; // 记录当前线程处理到的步数
         
         while (running && clock.isRunning()) {
             clock.waitForNextStep(current_step);
             current_step = clock.getStepCount();
-            if (state.brake_control_enabled) {
-                updateBrake(FIXED_DT);
-            }
+            stepOnce(clock.getTimeStep());
             // 通知时钟本步骤已完成
             clock.notifyStepCompleted();
         }
@@ -108,7 +119,7 @@ private:
         if (new_brake > MAX_BRAKE) {
             new_brake = MAX_BRAKE;
         }
-        state.brake.store(new_brake);
+        state.next.write(StateField::Brake, new_brake);
         printBrakeStatus(new_brake);
     }
 
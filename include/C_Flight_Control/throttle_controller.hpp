@@ -32,17 +32,12 @@
 #include "../L_Simulation_Settings/simulation_config_base.hpp"  // 仿真配置基类，定义基础配置参数
 #include "controller_config.hpp"      // 控制器配置，定义控制器参数和配置结构
 #include "../L_Simulation_Settings/simulation_clock.hpp"  // 仿真时钟，提供时间同步和步进控制
-#include "../K_Scenario/state_update_queue.hpp"     // 状态更新队列，管理状态更新操作
 #include "../L_Simulation_Settings/thread_name_util.hpp"  // 线程命名工具，便于调试和监控
 
 class ThrottleController_Increase : public BaseController {
 private:
     SimulationClock& clock;
-    StateUpdateQueue& queue;
-    std::thread controller_thread;
-    std::atomic<bool> running{false};
     const double THROTTLE_INCREASE_RATE = 0.1; // 每秒增加0.1，如果时间步长为0.01，那么每步增加0.001
-    const double FIXED_DT = 0.01; // 固定时间步长
 
     void run() {
         ThreadNaming::set_current_thread_name("ThrottleIncreaseCtrl");
@@ -53,10 +48,7 @@ private:
             clock.waitForNextStep(current_step);
             current_step = clock.getStepCount();
             
-            // 只有在油门控制启用时才更新
-            if (state.throttle_control_enabled) {
-                updateThrottle(FIXED_DT);
-            }
+            stepOnce(clock.getTimeStep());
 
             // 通知时钟本步骤已完成
             clock.notifyStepCompleted();
@@ -73,7 +65,7 @@ private:
         
         // 只有当油门值发生变化时才更新
         if (std::abs(new_throttle - current_throttle) > 1e-6) {
-            queue.push({StateUpdateType::Throttle, new_throttle});
+            state.next.write(StateField::Throttle, new_throttle);
             std::ostringstream stream;
             stream << std::fixed << std::setprecision(2)
                    << "[油门控制器] 请求更新油门值: " << new_throttle << "\n";
@@ -82,15 +74,17 @@ private:
     }
 
 public:
-    ThrottleController_Increase(SharedStateSpace& state_ref, EventBus& bus_ref, SimulationClock& clock_ref, StateUpdateQueue& queue_ref)
-        : BaseController(state_ref, bus_ref), clock(clock_ref), queue(queue_ref) {
+    ThrottleController_Increase(SharedStateSpace& state_ref, EventBus& bus_ref, SimulationClock& clock_ref)
+        : BaseController(state_ref, bus_ref), clock(clock_ref) {
         log_detail("[油门控制器] 初始化完成\n");
     }
 
     void start() override {
         if (!running) {
             running = true;
-            controller_thread = std::thread(&ThrottleController_Increase::run, this);
+            if (!externally_stepped) {
+                controller_thread = std::thread(&ThrottleController_Increase::run, this);
+            }
             log_detail("[油门控制器] 已启动\n");
         }
     }
@@ -116,24 +110,34 @@ public:
     double getCurrentValue() const override {
         return state.throttle.load();
     }
+
+    StateAccess stateAccess() const override {
+        // 油门写入后缓冲，由状态空间处理在步屏障处提交
+        return StateAccess::of({StateField::ControlFlags, StateField::Throttle}, {StateField::NextThrottle});
+    }
+
+    void stepOnce(double dt) override {
+        // 只有在油门控制启用时才更新
+        if (state.throttle_control_enabled) {
+            updateThrottle(dt);
+        }
+    }
 };
 
 class ThrottleController_Decrease : public BaseController {
 private:
-    std::thread controller_thread;
-    std::atomic<bool> running{false};
     const double THROTTLE_DECREASE_RATE = 0.2; // 油门减小率
-    const double FIXED_DT = 0.01; // 固定时间步长
-    StateUpdateQueue& queue;
 
 public:
-    ThrottleController_Decrease(SharedStateSpace& state_ref, EventBus& bus_ref, StateUpdateQueue& queue_ref)
-        : BaseController(state_ref, bus_ref), queue(queue_ref) {}
+    ThrottleController_Decrease(SharedStateSpace& state_ref, EventBus& bus_ref)
+        : BaseController(state_ref, bus_ref) {}
 
     void start() override {
         if (!running) {
             running = true;
-            controller_thread = std::thread(&ThrottleController_Decrease::run, this);
+            if (!externally_stepped) {
+                controller_thread = std::thread(&ThrottleController_Decrease::run, this);
+            }
         }
     }
 
@@ -156,11 +160,21 @@ public:
         return state.throttle.load();
     }
 
+    StateAccess stateAccess() const override {
+        // 油门写入后缓冲，由状态空间处理在步屏障处提交
+        return StateAccess::of({StateField::ControlFlags, StateField::Throttle}, {StateField::NextThrottle});
+    }
+
+    void stepOnce(double dt) override {
+        if (state.throttle_control_enabled) {
+            updateThrottle(dt);
+        }
+    }
+
 private:
     void run() {
         ThreadNaming::set_current_thread_name("ThrottleDecreaseCtrl");
-        const double FIXED_DT = 0.01; // 固定时间步长
-        auto& clock = SimulationClock::getInstance();
+        auto& clock = state.clock();
         clock.registerThread(); // 注册线程
         size_t current_step = 0; // 记录当前线程处理到的步数
         
@@ -170,9 +184,7 @@ private:
             current_step = clock.getStepCount();
             
             // 然后更新油门值
-            if (state.throttle_control_enabled) {
-                updateThrottle(FIXED_DT);
-            }
+            stepOnce(clock.getTimeStep());
 
             // 通知时钟本步骤已完成
             clock.notifyStepCompleted();
@@ -186,7 +198,7 @@ private:
         if (new_throttle < 0.0) {
             new_throttle = 0.0;
         }
-        queue.push({StateUpdateType::Throttle, new_throttle});
+        state.next.write(StateField::Throttle, new_throttle);
         printThrottleStatus(new_throttle);
     }
 
@@ -9,7 +9,9 @@
  * 主要功能：
  *   - 计算飞机在当前状态下的合力、加速度、速度和位置
  *   - 支持与控制器、物理参数、力模型的集成
- *   - 支持仿真步进与状态队列推送
+ *   - 支持仿真步进，新状态写入共享状态空间的后缓冲
+ *   - 支持一次调用推进整个机队（FleetState，按字段分列）
+ *   - 积分方法可选（显式欧拉、半隐式欧拉、RK4、自适应 RK45，见 integrator.hpp），步长取仿真时钟步长
  *   - 支持状态打印与日志记录
  *
  * 后续可扩展为非线性模型、直升机等其他机型动力学模型。
@@ -37,8 +39,10 @@
 #include "../L_Simulation_Settings/logger.hpp" // 日志系统，支持详细/简要日志输出
 #include "../A_Aircraft_Configuration/aircraft_config.hpp" // 飞机物理参数配置
 #include "../B_Aircraft_Forces_Model/ACForceModel.hpp"  // 飞机力模型，计算合力
+#include "../K_Scenario/fleet_state.hpp"       // 多机状态（结构数组），机队推进
+#include "integrator.hpp"                      // 积分器，按时钟步长推进位置和速度
+#include "fleet_simd_kernel.hpp"               // 机队批量推进的 SIMD 内核
 #include "../C_Flight_Control/controller_config.hpp"     // 控制器参数配置
-#include "../K_Scenario/state_update_queue.hpp" // 状态更新队列，支持多线程状态同步
 
 // ================= 命名空间与配置参数 =================
 using namespace SimulationConfig;   // 仿真全局配置参数
@@ -63,42 +67,137 @@ double calculateAcceleration(const SharedStateSpace& state);
  */
 void printState(double time, double position, double velocity, double acceleration, double throttle, double brake);
 
+// 一次推进的结果（不写入状态空间）
+struct DynamicsStepResult {
+    double position;       // 推进后的位置
+    double velocity;       // 推进后的速度
+    double acceleration;   // 本次推进使用的加速度
+    ForceResult forces;    // 本次推进使用的力
+    // 纵向三自由度模型推进的高度、法向速度和俯仰状态（longitudinal 为 false 时未推进，状态空间中保持原值）
+    bool longitudinal = false;
+    double altitude = 0.0;
+    double normal_velocity = 0.0;
+    double pitch_angle = 0.0;
+    double pitch_rate = 0.0;
+};
+
 // 动力学模型接口
 class IDynamicsModel {
 public:
+    explicit IDynamicsModel(Integrator integrator = Integrator()) : integrator_(integrator) {}
     virtual ~IDynamicsModel() = default;
-    virtual void step(SharedStateSpace& state, StateUpdateQueue& queue, EventBus& bus, SimulationClock& clock,
+    // 积分方法（须在仿真开始前设置）；模型不支持该方法时记录日志、保持原积分方法并返回 false
+    bool setIntegrator(const Integrator& integrator) {
+        if (!supportsIntegrator(integrator.type())) {
+            log_brief(std::string("[Dynamics] 动力学模型不支持积分方法 ") + integrator.name() + "，保持 " + integrator_.name() + "\n");
+            return false;
+        }
+        integrator_ = integrator;
+        return true;
+    }
+    // 是否支持该积分方法（默认全部支持）
+    virtual bool supportsIntegrator(IntegratorType) const { return true; }
+    const Integrator& integrator() const { return integrator_; }
+    // 从已提交的本步状态推进一个时钟步长，结果写入后缓冲 state.next，步屏障处提交
+    virtual void step(SharedStateSpace& state, EventBus& bus, SimulationClock& clock,
                       std::shared_ptr<AircraftConfigBase> aircraftConfig, std::shared_ptr<IForceModel> forceModel) = 0;
+    // 从当前状态试探推进 dt，只计算不写入（事件定位在步内多次调用）；dt 趋于 0 时结果应趋于当前状态
+    virtual DynamicsStepResult propagate(const SharedStateSpace& state, double dt,
+                                         std::shared_ptr<AircraftConfigBase> aircraftConfig, std::shared_ptr<IForceModel> forceModel) const = 0;
+    // 一次推进整个机队 dt：先由力学模型计算各机的力，再逐列更新加速度、速度、位置和共用仿真时间
+    // 机队推进只需步起点的力，支持显式/半隐式欧拉；返回 false 表示积分方法、动力学模型或力学模型不支持机队推进
+    virtual bool stepFleet(FleetState& /*fleet*/, double /*dt*/, const IForceModel& /*forceModel*/) const { return false; }
+    // 每步读写的状态字段（不含力学模型，任务图中与 forceModel->stateAccess() 合并）
+    virtual StateAccess stateAccess() const {
+        return StateAccess::of({StateField::Position, StateField::Velocity}, {StateField::NextKinematics});
+    }
+
+protected:
+    Integrator integrator_;
+
+    // 把一次推进的结果（力、新状态、推进后的仿真时间）写入后缓冲
+    static void writeNext(SharedStateSpace& state, const DynamicsStepResult& result, double time) {
+        state.next.write(StateField::Thrust, result.forces.thrust);
+        state.next.write(StateField::DragForce, result.forces.drag);
+        state.next.write(StateField::BrakeForce, result.forces.brake_force);
+        state.next.write(StateField::Velocity, result.velocity);
+        state.next.write(StateField::Position, result.position);
+        state.next.write(StateField::Acceleration, result.acceleration);
+        state.next.write(StateField::SimulationTime, time);
+        if (result.longitudinal) {
+            state.next.write(StateField::Altitude, result.altitude);
+            state.next.write(StateField::NormalVelocity, result.normal_velocity);
+            state.next.write(StateField::PitchAngle, result.pitch_angle);
+            state.next.write(StateField::PitchRate, result.pitch_rate);
+        }
+    }
 };
 
 // 线性动力学模型实现
 class DynamicsModel_FixedWing_Linear : public IDynamicsModel {
 public:
-    void step(SharedStateSpace& state, StateUpdateQueue& queue, EventBus& bus, SimulationClock& clock,
+    explicit DynamicsModel_FixedWing_Linear(Integrator integrator = Integrator()) : IDynamicsModel(integrator) {}
+
+    void step(SharedStateSpace& state, EventBus& bus, SimulationClock& clock,
               std::shared_ptr<AircraftConfigBase> aircraftConfig, std::shared_ptr<IForceModel> forceModel) override {
-        // 1. 计算当前合力（推力、阻力、刹车力）
-        ForceResult forces = forceModel->calculateNetForce(state, state.velocity.load(), aircraftConfig);
-        // 2. 更新共享状态空间中的力值
-        state.thrust.store(forces.thrust);
-        state.drag_force.store(forces.drag);
-        state.brake_force.store(forces.brake_force);
-        // 3. 计算加速度 a = F/m
-        double acceleration = forces.net_force / aircraftConfig->getMass();
-        // 4. 获取当前速度和位置
-        double current_velocity = state.velocity.load();
-        double current_position = state.position.load();
-        // 5. 更新速度 v = v0 + a*dt
-        double new_velocity = current_velocity + acceleration * 0.01; // 固定步长dt=0.01s
-        // 6. 更新位置 x = x0 + v0*dt
-        double new_position = current_position + current_velocity * 0.01; // 固定步长dt=0.01s
-        // 7. 将新状态推送到状态队列（线程安全）
-        queue.push({StateUpdateType::Velocity, new_velocity});
-        queue.push({StateUpdateType::Position, new_position});
-        queue.push({StateUpdateType::Acceleration, acceleration});
-        // 8. 记录当前状态
+        // 1. 按时钟步长推进（合力、加速度、速度、位置）
+        DynamicsStepResult result = propagate(state, clock.getTimeStep(), aircraftConfig, forceModel);
+        // 2. 将力值与新状态写入后缓冲（步屏障处提交）
+        writeNext(state, result, clock.getCurrentTime());
+        // 3. 记录当前状态
         // state.printState();
-        // 9. 更新仿真时间
-        state.simulation_time.store(clock.getCurrentTime(), std::memory_order_release);
+    }
+
+    DynamicsStepResult propagate(const SharedStateSpace& state, double dt,
+                                 std::shared_ptr<AircraftConfigBase> aircraftConfig, std::shared_ptr<IForceModel> forceModel) const override {
+        DynamicsStepResult result;
+        // 1. 计算当前合力（推力、阻力、刹车力）
+        result.forces = forceModel->calculateNetForce(state, state.velocity.load(), aircraftConfig);
+        // 2. 计算加速度 a = F/m
+        result.acceleration = result.forces.net_force / aircraftConfig->getMass();
+        // 3. 按积分方法推进速度和位置（显式欧拉：v = v0 + a*dt，x = x0 + v0*dt）
+        const double mass = aircraftConfig->getMass();
+        const KinematicState next = integrator_.advance(
+            KinematicState{state.position.load(), state.velocity.load()}, dt, result.acceleration,
+            [&](double, double velocity) {
+                return forceModel->calculateNetForce(state, velocity, aircraftConfig).net_force / mass;
+            });
+        result.velocity = next.velocity;
+        result.position = next.position;
+        return result;
+    }
+
+    bool stepFleet(FleetState& fleet, double dt, const IForceModel& forceModel) const override {
+        const IntegratorType type = integrator_.type();
+        if (type != IntegratorType::ExplicitEuler && type != IntegratorType::SemiImplicitEuler) return false;
+        if (type == IntegratorType::ExplicitEuler && forceModel.isLinearPipeline()) {
+            // 线性力学模型 + 显式欧拉：力与推进融合为一次 SIMD 扫描
+            FleetSimd::stepLinearEuler(fleet, dt);
+            fleet.simulation_time += dt;
+            return true;
+        }
+        if (!forceModel.calculateFleetForces(fleet)) return false;
+        const double* net_force = fleet.netForce();
+        const double* mass = fleet.param(FleetParam::Mass).data();
+        double* acceleration = fleet.column(StateField::Acceleration);
+        double* velocity = fleet.column(StateField::Velocity);
+        double* position = fleet.column(StateField::Position);
+        if (type == IntegratorType::ExplicitEuler) {
+            // 与 propagate 相同：位置用推进前的速度
+            for (size_t i = 0, n = fleet.size(); i < n; ++i) {
+                acceleration[i] = net_force[i] / mass[i];
+                position[i] = position[i] + velocity[i] * dt;
+                velocity[i] = velocity[i] + acceleration[i] * dt;
+            }
+        } else {
+            for (size_t i = 0, n = fleet.size(); i < n; ++i) {
+                acceleration[i] = net_force[i] / mass[i];
+                velocity[i] = velocity[i] + acceleration[i] * dt;
+                position[i] = position[i] + velocity[i] * dt;
+            }
+        }
+        fleet.simulation_time += dt;
+        return true;
     }
 };
 
@@ -109,35 +208,68 @@ public:
  */
 class DynamicsModel_FixedWing_Nonlinear : public IDynamicsModel {
 public:
-    void step(SharedStateSpace& state, StateUpdateQueue& queue, EventBus& bus, SimulationClock& clock,
+    explicit DynamicsModel_FixedWing_Nonlinear(Integrator integrator = Integrator()) : IDynamicsModel(integrator) {}
+
+    void step(SharedStateSpace& state, EventBus& bus, SimulationClock& clock,
               std::shared_ptr<AircraftConfigBase> aircraftConfig, std::shared_ptr<IForceModel> forceModel) override {
+        // 1. 按时钟步长推进（合力、加速度、速度、位置）
+        DynamicsStepResult result = propagate(state, clock.getTimeStep(), aircraftConfig, forceModel);
+        // 2. 将力值与新状态写入后缓冲（步屏障处提交）
+        writeNext(state, result, clock.getCurrentTime());
+        // 3. 记录当前状态
+        // state.printState();
+    }
+
+    DynamicsStepResult propagate(const SharedStateSpace& state, double dt,
+                                 std::shared_ptr<AircraftConfigBase> aircraftConfig, std::shared_ptr<IForceModel> forceModel) const override {
+        DynamicsStepResult result;
         // 1. 计算当前合力（推力、阻力、刹车力），假设力学模型已体现非线性
-        ForceResult forces = forceModel->calculateNetForce(state, state.velocity.load(), aircraftConfig);
-        // 2. 更新共享状态空间中的力值
-        state.thrust.store(forces.thrust);
-        state.drag_force.store(forces.drag);
-        state.brake_force.store(forces.brake_force);
-        // 3. 计算非线性加速度 a = f(v, F, ...)
+        result.forces = forceModel->calculateNetForce(state, state.velocity.load(), aircraftConfig);
+        // 2. 计算非线性加速度 a = f(v, F, ...)
         double current_velocity = state.velocity.load();
         double mass = aircraftConfig->getMass();
         // 非线性扰动项：随速度变化的附加加速度
         double nonlinear_term = 0.5 * std::sin(current_velocity / 10.0);
-        double acceleration = (forces.net_force / mass) + nonlinear_term;
-        // 4. 获取当前速度和位置
+        result.acceleration = (result.forces.net_force / mass) + nonlinear_term;
+        // 3. 获取当前位置
         double current_position = state.position.load();
-        // 5. 更新速度 v = v0 + a*dt + 0.5*扰动项
-        double dt = 0.01;
-        double new_velocity = current_velocity + acceleration * dt + 0.1 * std::cos(current_velocity / 8.0);
-        // 6. 更新位置 x = x0 + v0*dt + 0.5*a*dt^2
-        double new_position = current_position + current_velocity * dt + 0.5 * acceleration * dt * dt;
-        // 7. 将新状态推送到状态队列（线程安全）
-        queue.push({StateUpdateType::Velocity, new_velocity});
-        queue.push({StateUpdateType::Position, new_position});
-        queue.push({StateUpdateType::Acceleration, acceleration});
-        // 8. 记录当前状态
-        // state.printState();
-        // 9. 更新仿真时间
-        state.simulation_time.store(clock.getCurrentTime(), std::memory_order_release);
+        if (integrator_.type() != IntegratorType::ExplicitEuler) {
+            // 其他积分方法：速度扰动项折算为附加加速度 10*cos(v/8)（即 (dt/0.01)*0.1*cos(v/8) 对 dt 的变化率）
+            const auto accel = [&](double, double velocity) {
+                return forceModel->calculateNetForce(state, velocity, aircraftConfig).net_force / mass
+                     + 0.5 * std::sin(velocity / 10.0) + 10.0 * std::cos(velocity / 8.0);
+            };
+            // 报告的加速度与积分使用的一致，含折算的扰动项
+            result.acceleration += 10.0 * std::cos(current_velocity / 8.0);
+            const KinematicState next = integrator_.advance(KinematicState{current_position, current_velocity}, dt,
+                                                            result.acceleration, accel);
+            result.velocity = next.velocity;
+            result.position = next.position;
+            return result;
+        }
+        // 4. 更新速度 v = v0 + a*dt + 扰动项（扰动按 dt/0.01 缩放，dt=0.01 时与原模型一致、dt→0 时趋于0）
+        result.velocity = current_velocity + result.acceleration * dt + (dt / 0.01) * 0.1 * std::cos(current_velocity / 8.0);
+        // 5. 更新位置 x = x0 + v0*dt + 0.5*a*dt^2
+        result.position = current_position + current_velocity * dt + 0.5 * result.acceleration * dt * dt;
+        return result;
+    }
+
+    bool stepFleet(FleetState& fleet, double dt, const IForceModel& forceModel) const override {
+        if (integrator_.type() != IntegratorType::ExplicitEuler) return false;
+        if (!forceModel.calculateFleetForces(fleet)) return false;
+        const double* net_force = fleet.netForce();
+        const double* mass = fleet.param(FleetParam::Mass).data();
+        double* acceleration = fleet.column(StateField::Acceleration);
+        double* velocity = fleet.column(StateField::Velocity);
+        double* position = fleet.column(StateField::Position);
+        for (size_t i = 0, n = fleet.size(); i < n; ++i) {
+            const double current_velocity = velocity[i];
+            acceleration[i] = (net_force[i] / mass[i]) + 0.5 * std::sin(current_velocity / 10.0);
+            velocity[i] = current_velocity + acceleration[i] * dt + (dt / 0.01) * 0.1 * std::cos(current_velocity / 8.0);
+            position[i] = position[i] + current_velocity * dt + 0.5 * acceleration[i] * dt * dt;
+        }
+        fleet.simulation_time += dt;
+        return true;
     }
 };
 
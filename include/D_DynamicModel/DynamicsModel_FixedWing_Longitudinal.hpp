@@ -0,0 +1,262 @@
+/*
+ * @file DynamicsModel_FixedWing_Longitudinal.hpp
+ * @brief 固定翼飞机纵向三自由度动力学模型头文件
+ *
+ * 状态 (x, z, u, w, θ, q)：跑道方向位置 x（position）、高度 h = -z（altitude）、机体纵轴速度 u（velocity）、
+ * 机体法向速度 w（normal_velocity，向下为正）、俯仰角 θ（pitch_angle）、俯仰角速度 q（pitch_rate）。
+ * 俯仰角保持控制器的输出 pitch_control_output（-1 ~ 1，正值抬头）作为升降舵指令。
+ *
+ * 力与力矩：
+ *   - 推力、阻力、刹车力由力学模型（IForceModel）按机体纵轴速度 u 计算，沿机体纵轴
+ *   - 升力 L = q̄·S·CL，CL = CL0 + CLα·α（限幅 ±CLmax），α = atan2(w, u)，垂直于空速
+ *   - 俯仰力矩 M = q̄·S·c·(Cm0 + Cmα·α + Cmq·q·c/(2V) + Cmδ·δ)
+ * 起落架接地（altitude <= 0 且升力与推力竖直分量不足以承担重力）时：
+ *   - 速度沿跑道，α = θ；沿跑道加速度 = (力学模型合外力 + 推力·(cosθ - 1)) / m（刹车力、静摩擦照常作用）
+ *   - 绕主轮转动：q̇ = (M - N·d) / (Iyy + m·d²)，N = m·g - L - T·sinθ 为地面支持力，d 为重心到主轮的纵向距离
+ *   - 前轮支撑 θ >= 0，擦尾角限制 θ <= θtail
+ * 离地后按机体轴三自由度方程推进；再次接地时保留水平速度，竖直速度由起落架吸收。
+ * 不抬头（θ = 0）的地面滑跑与 DynamicsModel_FixedWing_Linear 的显式欧拉推进逐位一致。
+ *
+ * 积分：显式欧拉（默认，与线性模型一致）或半隐式欧拉（先更新速度与角速度，再用新值更新位置与角度）。
+ * 起落架约束使状态在接地、离地时不连续，本模型不支持 RK4 / RK45：构造时指定则记录日志并改用显式欧拉，
+ * setIntegrator 记录日志并返回 false，stepFleet 返回 false。每步一次力学模型调用和一次 atan2、sqrt、sin、cos，
+ * 单步与机队推进（stepFleet）共用同一单机函数 LongitudinalDynamics::advance，结果逐位一致。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <algorithm>   // 限幅
+#include <cmath>       // 三角函数
+
+// ParaSAFE系统头文件
+#include "DynamicsModel_FixedWing_Linear.hpp"                // 动力学模型接口
+#include "../B_Aircraft_Forces_Model/ForcePipeline.hpp"      // 空气密度、重力加速度
+
+/**
+ * @struct LongitudinalParams
+ * @brief 纵向气动与起落架参数（默认值为中型双发客机起飞构型的量级）
+ */
+struct LongitudinalParams {
+    double wing_area = 122.6;                 ///< 机翼面积 S（m^2）
+    double mean_chord = 4.19;                 ///< 平均气动弦长 c（m）
+    double pitch_inertia = 3.0e6;             ///< 俯仰转动惯量 Iyy（kg·m^2）
+    double cl0 = 0.4;                         ///< 零迎角升力系数（含襟翼）
+    double cl_alpha = 5.0;                    ///< 升力线斜率（1/rad）
+    double cl_max = 1.8;                      ///< 最大升力系数
+    double cm0 = 0.0;                         ///< 零迎角俯仰力矩系数
+    double cm_alpha = -0.8;                   ///< 俯仰静稳定导数（1/rad）
+    double cm_q = -12.0;                      ///< 俯仰阻尼导数（对 q·c/(2V)）
+    double cm_delta = 1.0;                    ///< 升降舵指令（-1 ~ 1）的俯仰力矩系数
+    double main_gear_arm = 1.5;               ///< 重心到主轮的纵向距离 d（m，主轮在重心之后）
+    double tail_strike_pitch = 0.2;           ///< 擦尾俯仰角 θtail（rad，约 11.5°）
+};
+
+/**
+ * @struct LongitudinalState
+ * @brief 单架飞机的纵向状态
+ */
+struct LongitudinalState {
+    double x;       ///< 跑道方向位置（m）
+    double h;       ///< 高度（m）
+    double u;       ///< 机体纵轴速度（m/s）
+    double w;       ///< 机体法向速度（m/s，向下为正）
+    double theta;   ///< 俯仰角（rad）
+    double q;       ///< 俯仰角速度（rad/s）
+};
+
+namespace LongitudinalDynamics {
+
+/**
+ * @brief 推进一步
+ * @param s 起始状态
+ * @param forces 力学模型按 s.u 计算的力
+ * @param mass 质量（kg）
+ * @param pitch_command 升降舵指令（-1 ~ 1，正值抬头）
+ * @param p 气动与起落架参数
+ * @param dt 步长（秒）
+ * @param semi_implicit 是否半隐式欧拉
+ * @param acceleration 输出：沿跑道（接地）或沿机体纵轴（空中）的加速度
+ */
+inline LongitudinalState advance(const LongitudinalState& s, const ForceResult& forces, double mass, double pitch_command,
+                                 const LongitudinalParams& p, double dt, bool semi_implicit, double& acceleration) {
+    const double g = ForceTerms::kGravity;
+    const double cos_theta = std::cos(s.theta);
+    const double sin_theta = std::sin(s.theta);
+
+    // 气动力与力矩
+    const double airspeed = std::sqrt(s.u * s.u + s.w * s.w);
+    const double alpha = std::atan2(s.w, s.u);
+    const double dynamic_pressure = 0.5 * ForceTerms::kAirDensity * airspeed * airspeed;
+    const double cl = std::max(-p.cl_max, std::min(p.cl_max, p.cl0 + p.cl_alpha * alpha));
+    const double lift = dynamic_pressure * p.wing_area * cl;
+    const double delta = std::max(-1.0, std::min(1.0, pitch_command));
+    const double rate_term = airspeed > 1.0 ? s.q * p.mean_chord / (2.0 * airspeed) : 0.0;
+    const double moment = dynamic_pressure * p.wing_area * p.mean_chord
+                        * (p.cm0 + p.cm_alpha * alpha + p.cm_q * rate_term + p.cm_delta * delta);
+
+    LongitudinalState n;
+    const double normal_force = mass * g - lift - forces.thrust * sin_theta;
+    if (s.h <= 0.0 && normal_force > 0.0) {
+        // 接地：沿跑道推进，绕主轮转动
+        const double ground_speed = s.u * cos_theta + s.w * sin_theta;
+        acceleration = (forces.net_force + forces.thrust * (cos_theta - 1.0)) / mass;
+        const double q_dot = (moment - normal_force * p.main_gear_arm)
+                           / (p.pitch_inertia + mass * p.main_gear_arm * p.main_gear_arm);
+        double speed;
+        if (semi_implicit) {
+            speed = ground_speed + acceleration * dt;
+            n.x = s.x + speed * dt;
+            n.q = s.q + q_dot * dt;
+            n.theta = s.theta + n.q * dt;
+        } else {
+            n.x = s.x + ground_speed * dt;
+            speed = ground_speed + acceleration * dt;
+            n.theta = s.theta + s.q * dt;
+            n.q = s.q + q_dot * dt;
+        }
+        if (n.theta <= 0.0) {
+            n.theta = 0.0;   // 前轮支撑
+            if (n.q < 0.0) n.q = 0.0;
+        } else if (n.theta >= p.tail_strike_pitch) {
+            n.theta = p.tail_strike_pitch;   // 擦尾
+            if (n.q > 0.0) n.q = 0.0;
+        }
+        n.h = 0.0;
+        n.u = speed * std::cos(n.theta);
+        n.w = speed * std::sin(n.theta);
+        return n;
+    }
+
+    // 空中（或本步离地）：机体轴三自由度方程，阻力沿机体纵轴，升力垂直于空速
+    const double sin_alpha = airspeed > 0.0 ? s.w / airspeed : 0.0;
+    const double cos_alpha = airspeed > 0.0 ? s.u / airspeed : 1.0;
+    const double force_x = forces.thrust - forces.drag + lift * sin_alpha;
+    const double force_z = -lift * cos_alpha;
+    const double u_dot = force_x / mass - s.q * s.w - g * sin_theta;
+    const double w_dot = force_z / mass + s.q * s.u + g * cos_theta;
+    const double q_dot = moment / p.pitch_inertia;
+    acceleration = u_dot;
+    n.u = s.u + u_dot * dt;
+    n.w = s.w + w_dot * dt;
+    n.q = s.q + q_dot * dt;
+    if (semi_implicit) {
+        n.x = s.x + (n.u * cos_theta + n.w * sin_theta) * dt;
+        n.h = s.h + (n.u * sin_theta - n.w * cos_theta) * dt;
+        n.theta = s.theta + n.q * dt;
+    } else {
+        n.x = s.x + (s.u * cos_theta + s.w * sin_theta) * dt;
+        n.h = s.h + (s.u * sin_theta - s.w * cos_theta) * dt;
+        n.theta = s.theta + s.q * dt;
+    }
+    if (n.h <= 0.0) {
+        // 接地：保留水平速度，竖直速度由起落架吸收
+        const double speed = n.u * std::cos(n.theta) + n.w * std::sin(n.theta);
+        n.h = 0.0;
+        n.theta = std::max(0.0, std::min(p.tail_strike_pitch, n.theta));
+        if (n.theta == 0.0 && n.q < 0.0) n.q = 0.0;
+        n.u = speed * std::cos(n.theta);
+        n.w = speed * std::sin(n.theta);
+    }
+    return n;
+}
+
+} // namespace LongitudinalDynamics
+
+// ================= 纵向三自由度动力学模型实现 =================
+/**
+ * @brief 固定翼飞机纵向三自由度动力学模型（地面滑跑、抬头、离地、爬升）
+ */
+class DynamicsModel_FixedWing_Longitudinal : public IDynamicsModel {
+public:
+    explicit DynamicsModel_FixedWing_Longitudinal(LongitudinalParams params = LongitudinalParams(),
+                                                  Integrator integrator = Integrator())
+        : IDynamicsModel(integrator), params_(params) {
+        if (!supportsIntegrator(integrator.type())) {
+            log_brief(std::string("[Dynamics] 纵向三自由度模型不支持积分方法 ") + integrator.name() + "，改用 ExplicitEuler\n");
+            integrator_ = Integrator();
+        }
+    }
+
+    // 气动与起落架参数（须在仿真开始前设置）
+    void setParams(const LongitudinalParams& params) { params_ = params; }
+    const LongitudinalParams& params() const { return params_; }
+
+    void step(SharedStateSpace& state, EventBus& /*bus*/, SimulationClock& clock,
+              std::shared_ptr<AircraftConfigBase> aircraftConfig, std::shared_ptr<IForceModel> forceModel) override {
+        // 1. 按时钟步长推进（力、三自由度状态）
+        DynamicsStepResult result = propagate(state, clock.getTimeStep(), aircraftConfig, forceModel);
+        // 2. 将力值与新状态写入后缓冲（步屏障处提交）
+        writeNext(state, result, clock.getCurrentTime());
+    }
+
+    DynamicsStepResult propagate(const SharedStateSpace& state, double dt,
+                                 std::shared_ptr<AircraftConfigBase> aircraftConfig, std::shared_ptr<IForceModel> forceModel) const override {
+        DynamicsStepResult result;
+        const LongitudinalState s{state.position.load(), state.altitude.load(), state.velocity.load(),
+                                  state.normal_velocity.load(), state.pitch_angle.load(), state.pitch_rate.load()};
+        // 1. 力学模型按机体纵轴速度计算推力、阻力、刹车力
+        result.forces = forceModel->calculateNetForce(state, s.u, aircraftConfig);
+        // 2. 加入升力、俯仰力矩和起落架约束推进一步
+        const LongitudinalState n = LongitudinalDynamics::advance(
+            s, result.forces, aircraftConfig->getMass(), state.pitch_control_output.load(), params_, dt,
+            semiImplicit(), result.acceleration);
+        result.position = n.x;
+        result.velocity = n.u;
+        result.longitudinal = true;
+        result.altitude = n.h;
+        result.normal_velocity = n.w;
+        result.pitch_angle = n.theta;
+        result.pitch_rate = n.q;
+        return result;
+    }
+
+    bool supportsIntegrator(IntegratorType type) const override {
+        return type == IntegratorType::ExplicitEuler || type == IntegratorType::SemiImplicitEuler;
+    }
+
+    bool stepFleet(FleetState& fleet, double dt, const IForceModel& forceModel) const override {
+        if (!supportsIntegrator(integrator_.type())) return false;
+        if (!forceModel.calculateFleetForces(fleet)) return false;
+        const double* net_force = fleet.netForce();
+        const double* thrust = fleet.column(StateField::Thrust);
+        const double* drag = fleet.column(StateField::DragForce);
+        const double* brake_force = fleet.column(StateField::BrakeForce);
+        const double* pitch_command = fleet.column(StateField::PitchControlOutput);
+        const double* mass = fleet.param(FleetParam::Mass).data();
+        double* acceleration = fleet.column(StateField::Acceleration);
+        double* position = fleet.column(StateField::Position);
+        double* altitude = fleet.column(StateField::Altitude);
+        double* velocity = fleet.column(StateField::Velocity);
+        double* normal_velocity = fleet.column(StateField::NormalVelocity);
+        double* pitch_angle = fleet.column(StateField::PitchAngle);
+        double* pitch_rate = fleet.column(StateField::PitchRate);
+        const bool semi_implicit = semiImplicit();
+        for (size_t i = 0, n = fleet.size(); i < n; ++i) {
+            const LongitudinalState s{position[i], altitude[i], velocity[i], normal_velocity[i], pitch_angle[i], pitch_rate[i]};
+            const ForceResult forces{net_force[i], thrust[i], drag[i], brake_force[i], 0.0};
+            const LongitudinalState next = LongitudinalDynamics::advance(s, forces, mass[i], pitch_command[i], params_, dt,
+                                                                         semi_implicit, acceleration[i]);
+            position[i] = next.x;
+            altitude[i] = next.h;
+            velocity[i] = next.u;
+            normal_velocity[i] = next.w;
+            pitch_angle[i] = next.theta;
+            pitch_rate[i] = next.q;
+        }
+        fleet.simulation_time += dt;
+        return true;
+    }
+
+    StateAccess stateAccess() const override {
+        return StateAccess::of({StateField::Position, StateField::Velocity, StateField::Altitude, StateField::NormalVelocity,
+                                StateField::PitchAngle, StateField::PitchRate, StateField::PitchControlOutput},
+                               {StateField::NextKinematics});
+    }
+
+private:
+    // 构造与 setIntegrator 已保证积分方法为显式或半隐式欧拉
+    bool semiImplicit() const { return integrator_.type() == IntegratorType::SemiImplicitEuler; }
+
+    LongitudinalParams params_;
+};
@@ -0,0 +1,257 @@
+/*
+ * @file fleet_simd_kernel.hpp
+ * @brief 机队批量推进的 SIMD 内核头文件
+ *
+ * 蒙特卡洛扫描中成千上万次相互独立的起飞滑跑只在参数上不同。本内核把线性力学模型（ACForceModel）与
+ * 显式欧拉线性动力学（DynamicsModel_FixedWing_Linear）融合为一次扫描，按 FleetState 的结构数组
+ * 每次处理一组飞机：
+ *   - AVX-512：每次 8 架（编译时定义 __AVX512F__，如 -mavx512f / -march=native / MSVC /arch:AVX512）
+ *   - AVX2   ：每次 4 架（编译时定义 __AVX2__，如 -mavx2 / MSVC /arch:AVX2）
+ *   - 标量   ：未启用上述指令集时，以及每组不足一个向量宽度的尾部，逐架调用 ACForceModel::computeForces
+ * 静止（|v| < 0.01）时的静摩擦分支用比较掩码与混合（select）实现，不产生分支。
+ * 机队较大时逐步推进受内存带宽限制；各步之间控制量不变时（如开环扫描）可一次推进多步，按块留在缓存中计算。
+ *
+ * 各条路径按与 ACForceModel::computeForces 相同的运算顺序计算；编译器把乘加融合为 FMA 时
+ * （如 -mfma、-march=native）各路径的结果可能在最后一位上不同。
+ *
+ * 指令集在编译期选择，不做运行时检测：程序只能在支持所选指令集的 CPU 上运行。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <algorithm> // 分块边界
+#include <cmath>     // 标量路径
+#include <cstddef>   // size_t
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>   // AVX2 / AVX-512 内建函数
+#endif
+
+// ParaSAFE系统头文件
+#include "../K_Scenario/fleet_state.hpp"                 // 多机状态（结构数组）
+#include "../B_Aircraft_Forces_Model/ACForceModel.hpp"   // 单架飞机的力（标量路径）
+
+namespace FleetSimd {
+
+/**
+ * @brief 内核使用的指令集
+ */
+enum class Isa { Scalar, AVX2, AVX512 };
+
+#if defined(__AVX512F__)
+constexpr Isa kCompiledIsa = Isa::AVX512;
+#elif defined(__AVX2__)
+constexpr Isa kCompiledIsa = Isa::AVX2;
+#else
+constexpr Isa kCompiledIsa = Isa::Scalar;
+#endif
+
+inline const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::AVX512: return "AVX-512";
+        case Isa::AVX2: return "AVX2";
+        default: return "Scalar";
+    }
+}
+
+// 与 ACForceModel（LinearForcePipeline）相同的常数
+constexpr double kDragFactor = ForceTerms::kDragFactor;
+constexpr double kStillVelocity = ForceTerms::kStillVelocity;   ///< 低于该速度按静止处理（静摩擦）
+constexpr double kGravity = ForceTerms::kGravity;
+
+/**
+ * @brief 机队各列的指针（内核内部使用）
+ */
+struct FleetColumns {
+    const double* throttle;
+    const double* brake;
+    const double* mass;
+    const double* max_thrust;
+    const double* max_brake_force;
+    const double* drag_coeff;
+    const double* static_friction_coeff;
+    double* position;
+    double* velocity;
+    double* acceleration;
+    double* thrust;
+    double* drag;
+    double* brake_force;
+    double* net_force;
+
+    explicit FleetColumns(FleetState& fleet)
+        : throttle(fleet.column(StateField::Throttle)),
+          brake(fleet.column(StateField::Brake)),
+          mass(fleet.param(FleetParam::Mass).data()),
+          max_thrust(fleet.param(FleetParam::MaxThrust).data()),
+          max_brake_force(fleet.param(FleetParam::MaxBrakeForce).data()),
+          drag_coeff(fleet.param(FleetParam::DragCoefficient).data()),
+          static_friction_coeff(fleet.param(FleetParam::StaticFrictionCoefficient).data()),
+          position(fleet.column(StateField::Position)),
+          velocity(fleet.column(StateField::Velocity)),
+          acceleration(fleet.column(StateField::Acceleration)),
+          thrust(fleet.column(StateField::Thrust)),
+          drag(fleet.column(StateField::DragForce)),
+          brake_force(fleet.column(StateField::BrakeForce)),
+          net_force(fleet.netForce()) {}
+};
+
+/**
+ * @brief 标量路径：推进 [begin, end) 号飞机
+ */
+inline void stepLinearEulerScalar(const FleetColumns& c, double dt, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const ForceResult r = ACForceModel::computeForces(c.throttle[i], c.brake[i], c.velocity[i],
+            AircraftParams{c.mass[i], c.max_thrust[i], c.max_brake_force[i], c.drag_coeff[i], c.static_friction_coeff[i]});
+        c.thrust[i] = r.thrust;
+        c.drag[i] = r.drag;
+        c.brake_force[i] = r.brake_force;
+        c.net_force[i] = r.net_force;
+        c.acceleration[i] = r.net_force / c.mass[i];
+        c.position[i] = c.position[i] + c.velocity[i] * dt;
+        c.velocity[i] = c.velocity[i] + c.acceleration[i] * dt;
+    }
+}
+
+#if defined(__AVX2__)
+/**
+ * @brief AVX2 路径：每次 4 架，返回已处理到的下标
+ */
+inline size_t stepLinearEulerAvx2(const FleetColumns& c, double dt, size_t begin, size_t end) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d minus_one = _mm256_set1_pd(-1.0);
+    const __m256d sign_bit = _mm256_set1_pd(-0.0);
+    const __m256d drag_factor = _mm256_set1_pd(kDragFactor);
+    const __m256d still_velocity = _mm256_set1_pd(kStillVelocity);
+    const __m256d min_speed_factor = _mm256_set1_pd(0.3);
+    const __m256d speed_factor_scale = _mm256_set1_pd(50.0);
+    const __m256d gravity = _mm256_set1_pd(kGravity);
+    const __m256d step = _mm256_set1_pd(dt);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m256d v = _mm256_loadu_pd(c.velocity + i);
+        const __m256d mass = _mm256_loadu_pd(c.mass + i);
+        const __m256d abs_v = _mm256_andnot_pd(sign_bit, v);
+        const __m256d still = _mm256_cmp_pd(abs_v, still_velocity, _CMP_LT_OQ);
+
+        const __m256d thrust = _mm256_mul_pd(_mm256_loadu_pd(c.throttle + i), _mm256_loadu_pd(c.max_thrust + i));
+        const __m256d drag = _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(drag_factor, _mm256_loadu_pd(c.drag_coeff + i)), v), v);
+        // 运动时：刹车力 = 刹车 * 最大刹车力 * 速度因子（0.3~1.0）；静止时为 0
+        const __m256d speed_factor = _mm256_min_pd(one, _mm256_max_pd(min_speed_factor, _mm256_div_pd(abs_v, speed_factor_scale)));
+        const __m256d moving_brake = _mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(c.brake + i), _mm256_loadu_pd(c.max_brake_force + i)), speed_factor);
+        const __m256d brake_force = _mm256_blendv_pd(moving_brake, zero, still);
+        // 静止时：静摩擦力 = 静摩擦系数 * 质量 * g；运动时为 0
+        const __m256d static_friction = _mm256_blendv_pd(zero,
+            _mm256_mul_pd(_mm256_loadu_pd(c.static_friction_coeff + i), _mm256_mul_pd(mass, gravity)), still);
+
+        __m256d net = _mm256_sub_pd(_mm256_sub_pd(thrust, drag), brake_force);
+        // 静止：合力不超过静摩擦力时保持静止，否则扣除静摩擦力
+        const __m256d sign = _mm256_blendv_pd(minus_one, one, _mm256_cmp_pd(net, zero, _CMP_GT_OQ));
+        const __m256d overcome = _mm256_sub_pd(net, _mm256_mul_pd(static_friction, sign));
+        const __m256d held = _mm256_cmp_pd(_mm256_andnot_pd(sign_bit, net), static_friction, _CMP_LT_OQ);
+        net = _mm256_blendv_pd(net, _mm256_blendv_pd(overcome, zero, held), still);
+
+        const __m256d acceleration = _mm256_div_pd(net, mass);
+        const __m256d position = _mm256_loadu_pd(c.position + i);
+        _mm256_storeu_pd(c.thrust + i, thrust);
+        _mm256_storeu_pd(c.drag + i, drag);
+        _mm256_storeu_pd(c.brake_force + i, brake_force);
+        _mm256_storeu_pd(c.net_force + i, net);
+        _mm256_storeu_pd(c.acceleration + i, acceleration);
+        _mm256_storeu_pd(c.position + i, _mm256_add_pd(position, _mm256_mul_pd(v, step)));
+        _mm256_storeu_pd(c.velocity + i, _mm256_add_pd(v, _mm256_mul_pd(acceleration, step)));
+    }
+    return i;
+}
+#endif
+
+#if defined(__AVX512F__)
+/**
+ * @brief AVX-512 路径：每次 8 架，掩码寄存器做选择，返回已处理到的下标
+ */
+inline size_t stepLinearEulerAvx512(const FleetColumns& c, double dt, size_t begin, size_t end) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d minus_one = _mm512_set1_pd(-1.0);
+    const __m512d drag_factor = _mm512_set1_pd(kDragFactor);
+    const __m512d still_velocity = _mm512_set1_pd(kStillVelocity);
+    const __m512d min_speed_factor = _mm512_set1_pd(0.3);
+    const __m512d speed_factor_scale = _mm512_set1_pd(50.0);
+    const __m512d gravity = _mm512_set1_pd(kGravity);
+    const __m512d step = _mm512_set1_pd(dt);
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const __m512d v = _mm512_loadu_pd(c.velocity + i);
+        const __m512d mass = _mm512_loadu_pd(c.mass + i);
+        const __m512d abs_v = _mm512_abs_pd(v);
+        const __mmask8 still = _mm512_cmp_pd_mask(abs_v, still_velocity, _CMP_LT_OQ);
+
+        const __m512d thrust = _mm512_mul_pd(_mm512_loadu_pd(c.throttle + i), _mm512_loadu_pd(c.max_thrust + i));
+        const __m512d drag = _mm512_mul_pd(_mm512_mul_pd(_mm512_mul_pd(drag_factor, _mm512_loadu_pd(c.drag_coeff + i)), v), v);
+        const __m512d speed_factor = _mm512_min_pd(one, _mm512_max_pd(min_speed_factor, _mm512_div_pd(abs_v, speed_factor_scale)));
+        const __m512d moving_brake = _mm512_mul_pd(_mm512_mul_pd(_mm512_loadu_pd(c.brake + i), _mm512_loadu_pd(c.max_brake_force + i)), speed_factor);
+        const __m512d brake_force = _mm512_mask_blend_pd(still, moving_brake, zero);
+        const __m512d static_friction = _mm512_mask_blend_pd(still, zero,
+            _mm512_mul_pd(_mm512_loadu_pd(c.static_friction_coeff + i), _mm512_mul_pd(mass, gravity)));
+
+        __m512d net = _mm512_sub_pd(_mm512_sub_pd(thrust, drag), brake_force);
+        const __m512d sign = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(net, zero, _CMP_GT_OQ), minus_one, one);
+        const __m512d overcome = _mm512_sub_pd(net, _mm512_mul_pd(static_friction, sign));
+        const __mmask8 held = _mm512_cmp_pd_mask(_mm512_abs_pd(net), static_friction, _CMP_LT_OQ);
+        net = _mm512_mask_blend_pd(still, net, _mm512_mask_blend_pd(held, overcome, zero));
+
+        const __m512d acceleration = _mm512_div_pd(net, mass);
+        const __m512d position = _mm512_loadu_pd(c.position + i);
+        _mm512_storeu_pd(c.thrust + i, thrust);
+        _mm512_storeu_pd(c.drag + i, drag);
+        _mm512_storeu_pd(c.brake_force + i, brake_force);
+        _mm512_storeu_pd(c.net_force + i, net);
+        _mm512_storeu_pd(c.acceleration + i, acceleration);
+        _mm512_storeu_pd(c.position + i, _mm512_add_pd(position, _mm512_mul_pd(v, step)));
+        _mm512_storeu_pd(c.velocity + i, _mm512_add_pd(v, _mm512_mul_pd(acceleration, step)));
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief 推进 [begin, end) 号飞机一步：按 isa 从最宽的向量路径开始，尾部依次由较窄的路径处理
+ */
+inline void stepLinearEulerRange(const FleetColumns& columns, double dt, Isa isa, size_t begin, size_t end) {
+    size_t done = begin;
+#if defined(__AVX512F__)
+    if (isa == Isa::AVX512) done = stepLinearEulerAvx512(columns, dt, done, end);
+#endif
+#if defined(__AVX2__)
+    if (isa != Isa::Scalar) done = stepLinearEulerAvx2(columns, dt, done, end);
+#endif
+    (void)isa;
+    stepLinearEulerScalar(columns, dt, done, end);
+}
+
+constexpr size_t kTile = 256;   ///< 多步推进的分块大小（每块约 35 KB）
+
+/**
+ * @brief 用线性力学模型和显式欧拉推进整个机队 steps 步（结果与 ACForceModel + DynamicsModel_FixedWing_Linear
+ *        的 stepFleet 相同，不推进 fleet.simulation_time）
+ * @param isa 使用的指令集，超过 kCompiledIsa 时退回已编译的最宽者
+ * @param steps 步数，各步之间控制量（油门、刹车）保持不变；大于 1 时按 kTile 架分块，每块连续推进 steps 步，
+ *              块内数据留在缓存中，机队较大时吞吐明显高于逐步调用
+ */
+inline void stepLinearEuler(FleetState& fleet, double dt, Isa isa = kCompiledIsa, size_t steps = 1) {
+    const FleetColumns columns(fleet);
+    const size_t n = fleet.size();
+    if (steps == 1) {
+        stepLinearEulerRange(columns, dt, isa, 0, n);
+        return;
+    }
+    for (size_t begin = 0; begin < n; begin += kTile) {
+        const size_t end = std::min(n, begin + kTile);
+        for (size_t step = 0; step < steps; ++step) stepLinearEulerRange(columns, dt, isa, begin, end);
+    }
+}
+
+} // namespace FleetSimd
@@ -0,0 +1,164 @@
+/*
+ * @file integrator.hpp
+ * @brief 纵向运动积分器头文件
+ *
+ * 动力学模型把"由当前状态求加速度"交给积分器，积分器按时钟步长 dt 推进位置和速度：
+ *   - ExplicitEuler     : x₁ = x₀ + v₀·dt，v₁ = v₀ + a₀·dt（原模型的推进方式，默认）
+ *   - SemiImplicitEuler : v₁ = v₀ + a₀·dt，x₁ = x₀ + v₁·dt（辛欧拉，位置用推进后的速度）
+ *   - RK4               : 经典四阶龙格-库塔，每步求 4 次加速度
+ *   - RK45              : Dormand-Prince 5(4) 自适应步长，在 dt 内按误差容限自动细分子步
+ * 高阶积分器可在相同停止距离精度下使用大得多的步长（配合配置文件中的 SIMULATION_TIME_STEP）。
+ *
+ * 加速度函数 accel(position, velocity) 在一步内可能被多次调用（RK 各级），油门、刹车等控制量在步内保持不变。
+ * RK45 每步都从整步 dt 开始试探，不跨步保存步长，结果只取决于当前状态和 dt，检查点恢复与回放保持确定性。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <algorithm>   // 步长缩放限幅
+#include <cmath>       // 误差范数
+
+/**
+ * @brief 积分方法
+ */
+enum class IntegratorType {
+    ExplicitEuler,       ///< 显式欧拉（默认，与原模型一致）
+    SemiImplicitEuler,   ///< 半隐式（辛）欧拉
+    RK4,                 ///< 经典四阶龙格-库塔
+    RK45                 ///< Dormand-Prince 5(4) 自适应步长
+};
+
+/**
+ * @struct KinematicState
+ * @brief 纵向运动状态
+ */
+struct KinematicState {
+    double position;   ///< 位置（m）
+    double velocity;   ///< 速度（m/s）
+};
+
+/**
+ * @class Integrator
+ * @brief 按 IntegratorType 推进一步的积分器（值类型，无虚调用）
+ */
+class Integrator {
+public:
+    /**
+     * @param type 积分方法
+     * @param tolerance RK45 的误差容限（同时作为绝对与相对容限）
+     * @param max_substeps RK45 每步最多细分的子步数，达到后以最小子步长接受
+     */
+    explicit Integrator(IntegratorType type = IntegratorType::ExplicitEuler, double tolerance = 1e-6, int max_substeps = 64)
+        : type_(type), tolerance_(tolerance), max_substeps_(std::max(1, max_substeps)) {}
+
+    IntegratorType type() const { return type_; }
+
+    const char* name() const {
+        switch (type_) {
+            case IntegratorType::ExplicitEuler: return "ExplicitEuler";
+            case IntegratorType::SemiImplicitEuler: return "SemiImplicitEuler";
+            case IntegratorType::RK4: return "RK4";
+            case IntegratorType::RK45: return "RK45";
+        }
+        return "Unknown";
+    }
+
+    /**
+     * @brief 从 s 推进 dt
+     * @param s 起始状态
+     * @param dt 步长（秒），为 0 时返回 s
+     * @param a0 起始状态的加速度（调用方计算力时已求得，避免重复求值）
+     * @param accel 加速度函数 accel(position, velocity)
+     */
+    template <typename Accel>
+    KinematicState advance(const KinematicState& s, double dt, double a0, Accel&& accel) const {
+        switch (type_) {
+            case IntegratorType::SemiImplicitEuler: {
+                const double v1 = s.velocity + a0 * dt;
+                return KinematicState{s.position + v1 * dt, v1};
+            }
+            case IntegratorType::RK4:
+                return rk4(s, dt, a0, accel);
+            case IntegratorType::RK45:
+                return rk45(s, dt, a0, accel);
+            case IntegratorType::ExplicitEuler:
+            default:
+                return KinematicState{s.position + s.velocity * dt, s.velocity + a0 * dt};
+        }
+    }
+
+private:
+    template <typename Accel>
+    static KinematicState rk4(const KinematicState& s, double h, double a1, Accel& accel) {
+        const double x = s.position, v = s.velocity;
+        const double v1 = v;
+        const double v2 = v + 0.5 * h * a1;
+        const double a2 = accel(x + 0.5 * h * v1, v2);
+        const double v3 = v + 0.5 * h * a2;
+        const double a3 = accel(x + 0.5 * h * v2, v3);
+        const double v4 = v + h * a3;
+        const double a4 = accel(x + h * v3, v4);
+        return KinematicState{x + h / 6.0 * (v1 + 2.0 * v2 + 2.0 * v3 + v4),
+                              v + h / 6.0 * (a1 + 2.0 * a2 + 2.0 * a3 + a4)};
+    }
+
+    template <typename Accel>
+    KinematicState rk45(const KinematicState& s, double dt, double a0, Accel& accel) const {
+        // Dormand-Prince 系数（加速度不显含时间，不需要各级的时间节点）
+        constexpr double a21 = 1.0 / 5;
+        constexpr double a31 = 3.0 / 40, a32 = 9.0 / 40;
+        constexpr double a41 = 44.0 / 45, a42 = -56.0 / 15, a43 = 32.0 / 9;
+        constexpr double a51 = 19372.0 / 6561, a52 = -25360.0 / 2187, a53 = 64448.0 / 6561, a54 = -212.0 / 729;
+        constexpr double a61 = 9017.0 / 3168, a62 = -355.0 / 33, a63 = 46732.0 / 5247, a64 = 49.0 / 176, a65 = -5103.0 / 18656;
+        constexpr double b1 = 35.0 / 384, b3 = 500.0 / 1113, b4 = 125.0 / 192, b5 = -2187.0 / 6784, b6 = 11.0 / 84;
+        // 五阶与四阶解之差的系数
+        constexpr double e1 = 71.0 / 57600, e3 = -71.0 / 16695, e4 = 71.0 / 1920, e5 = -17253.0 / 339200,
+                         e6 = 22.0 / 525, e7 = -1.0 / 40;
+
+        KinematicState y = s;
+        double a_first = a0;   // 当前子步起点的加速度（FSAL：接受后复用末级加速度）
+        double remaining = dt;
+        double h = dt;
+        const double min_h = dt / max_substeps_;
+        while (remaining > 0.0) {
+            h = std::min(h, remaining);
+            const double x = y.position, v = y.velocity;
+            // 各级：k 的位置分量为速度，速度分量为加速度
+            const double kv1 = v, ka1 = a_first;
+            const double kv2 = v + h * (a21 * ka1);
+            const double ka2 = accel(x + h * (a21 * kv1), kv2);
+            const double kv3 = v + h * (a31 * ka1 + a32 * ka2);
+            const double ka3 = accel(x + h * (a31 * kv1 + a32 * kv2), kv3);
+            const double kv4 = v + h * (a41 * ka1 + a42 * ka2 + a43 * ka3);
+            const double ka4 = accel(x + h * (a41 * kv1 + a42 * kv2 + a43 * kv3), kv4);
+            const double kv5 = v + h * (a51 * ka1 + a52 * ka2 + a53 * ka3 + a54 * ka4);
+            const double ka5 = accel(x + h * (a51 * kv1 + a52 * kv2 + a53 * kv3 + a54 * kv4), kv5);
+            const double kv6 = v + h * (a61 * ka1 + a62 * ka2 + a63 * ka3 + a64 * ka4 + a65 * ka5);
+            const double ka6 = accel(x + h * (a61 * kv1 + a62 * kv2 + a63 * kv3 + a64 * kv4 + a65 * kv5), kv6);
+            const double x5 = x + h * (b1 * kv1 + b3 * kv3 + b4 * kv4 + b5 * kv5 + b6 * kv6);
+            const double v5 = v + h * (b1 * ka1 + b3 * ka3 + b4 * ka4 + b5 * ka5 + b6 * ka6);
+            const double kv7 = v5;
+            const double ka7 = accel(x5, v5);
+
+            const double err_x = h * (e1 * kv1 + e3 * kv3 + e4 * kv4 + e5 * kv5 + e6 * kv6 + e7 * kv7);
+            const double err_v = h * (e1 * ka1 + e3 * ka3 + e4 * ka4 + e5 * ka5 + e6 * ka6 + e7 * ka7);
+            const double err = std::max(std::abs(err_x) / (tolerance_ + tolerance_ * std::abs(x5)),
+                                        std::abs(err_v) / (tolerance_ + tolerance_ * std::abs(v5)));
+
+            if (err <= 1.0 || h <= min_h) {
+                y = KinematicState{x5, v5};
+                a_first = ka7;
+                remaining -= h;
+                if (remaining < 1e-12 * dt) break;   // 浮点舍入剩余
+            }
+            const double scale = err > 0.0 ? 0.9 * std::pow(err, -0.2) : 5.0;
+            h = std::max(min_h, h * std::min(5.0, std::max(0.2, scale)));
+        }
+        return y;
+    }
+
+    IntegratorType type_;
+    double tolerance_;
+    int max_substeps_;
+};
@@ -11,7 +11,7 @@
 class IVirtualPilot {
 public:
     virtual ~IVirtualPilot() = default;
-    // 根据当前状态和目标，输出油门和刹车指令
+    // 根据已提交的当前状态和目标，输出油门和刹车指令（写入后缓冲，步屏障处提交）
     virtual void update(SharedStateSpace& state) = 0;
 };
 
@@ -25,14 +25,14 @@ public:
     void update(SharedStateSpace& state) override {
         double v = state.velocity.load();
         if (v < target_speed_ - 1.0) {
-            state.throttle.store(1.0); // 全油门
-            state.brake.store(0.0);
+            state.next.write(StateField::Throttle, 1.0); // 全油门
+            state.next.write(StateField::Brake, 0.0);
         } else if (v > target_speed_ + 1.0) {
-            state.throttle.store(0.0);
-            state.brake.store(1.0); // 全刹车
+            state.next.write(StateField::Throttle, 0.0);
+            state.next.write(StateField::Brake, 1.0); // 全刹车
         } else {
-            state.throttle.store(0.2); // 保持巡航
-            state.brake.store(0.0);
+            state.next.write(StateField::Throttle, 0.2); // 保持巡航
+            state.next.write(StateField::Brake, 0.0);
         }
     }
 private:
@@ -71,8 +71,8 @@ public:
     // 多阶段决策主逻辑
     void update(SharedStateSpace& state) override {
         if (mode_ == Mode::MANUAL) {
-            state.throttle.store(manual_throttle_);
-            state.brake.store(manual_brake_);
+            state.next.write(StateField::Throttle, manual_throttle_);
+            state.next.write(StateField::Brake, manual_brake_);
             return;
         }
         double v = state.velocity.load();
@@ -82,8 +82,8 @@ public:
             break;
         case Phase::ACCELERATE:
             if (v < target_speed_ - 2.0) {
-                state.throttle.store(1.0);
-                state.brake.store(0.0);
+                state.next.write(StateField::Throttle, 1.0);
+                state.next.write(StateField::Brake, 0.0);
             } else {
                 phase_ = Phase::CRUISE;
             }
@@ -92,21 +92,21 @@ public:
             if (v > target_speed_ + 2.0) {
                 phase_ = Phase::BRAKE;
             } else {
-                state.throttle.store(0.3);
-                state.brake.store(0.0);
+                state.next.write(StateField::Throttle, 0.3);
+                state.next.write(StateField::Brake, 0.0);
             }
             break;
         case Phase::BRAKE:
             if (v > 2.0) {
-                state.throttle.store(0.0);
-                state.brake.store(1.0);
+                state.next.write(StateField::Throttle, 0.0);
+                state.next.write(StateField::Brake, 1.0);
             } else {
                 phase_ = Phase::STOP;
             }
             break;
         case Phase::STOP:
-            state.throttle.store(0.0);
-            state.brake.store(0.0);
+            state.next.write(StateField::Throttle, 0.0);
+            state.next.write(StateField::Brake, 0.0);
             break;
         }
     }
@@ -29,6 +29,7 @@
 #include <atomic>           // 原子操作，确保多线程环境下的数据安全
 #include <queue>            // 队列容器，用于事件队列管理
 #include <any>              // 通用类型，支持任意类型的事件数据
+#include <algorithm>        // 排序，检查点中事件按名称有序写入
 
 // ParaSAFE系统头文件
 #include "../L_Simulation_Settings/simulation_config_base.hpp"  // 仿真配置基类，定义基础配置参数
@@ -38,7 +39,6 @@
 #include "../L_Simulation_Settings/logger.hpp"      // 日志系统，提供统一的日志记录功能
 #include "../C_Flight_Control/controller_config.hpp"      // 控制器配置，定义控制器参数和配置结构
 #include "../C_Flight_Control/base_controller.hpp"        // 控制器基类，提供控制器接口和基础功能
-#include "state_update_queue.hpp"     // 状态更新队列，管理状态更新操作
 #include "generic_events.hpp"         // 通用事件定义，定义控制器动作枚举
 #include "controller_actions_config.hpp"  // 控制器动作配置，定义动作映射关系
 
@@ -66,13 +66,14 @@ class ControllerManagerThread {
 private:
     SharedStateSpace& state; ///< 共享状态空间引用，存储仿真系统的所有状态变量
     EventBus& bus;           ///< 事件总线引用，负责事件的发布与订阅
-    StateUpdateQueue& queue; ///< 状态更新队列引用，管理状态更新操作
     std::atomic<bool> running{false}; ///< 控制管理线程运行状态的原子变量
     std::thread manager_thread;       ///< 控制器管理线程对象
     std::queue<std::function<void()>> event_queue; ///< 事件队列，存储待处理的事件回调
     std::mutex event_mutex;           ///< 事件队列互斥锁，保证多线程安全
     std::condition_variable event_cv; ///< 事件条件变量，用于线程间事件通知
     std::unordered_map<std::string, std::shared_ptr<BaseController>> controllers; ///< 控制器名称到控制器对象的映射表
+    std::vector<std::shared_ptr<BaseController>> controller_order; ///< 控制器创建顺序，外部步进时按此固定顺序执行
+    std::vector<bool> stepped_controllers_; ///< 上次步进时各控制器（按创建顺序）是否已启动，见 stepActivatedControllers()
     
     std::unordered_map<std::string, bool> triggered_events; ///< 已触发事件的记录表
     mutable std::mutex events_mutex; ///< 事件记录互斥锁，保证事件状态多线程安全
@@ -108,21 +109,28 @@ private:
         }
     }
 
+    /**
+     * @brief 记录各控制器当前是否已启动（已步进）
+     */
+    void recordSteppedControllers() {
+        stepped_controllers_.resize(controller_order.size());
+        for (size_t i = 0; i < controller_order.size(); ++i) stepped_controllers_[i] = controller_order[i]->isActive();
+    }
+
 public:
     /**
      * @brief 构造函数（支持事件定义和回调）
      * @param state 共享状态空间引用
      * @param bus 事件总线引用
-     * @param queue 状态更新队列引用
      * @param event_definitions 事件定义表
      * @param event_state_change_callback 事件状态变化回调函数
      *
      * 支持自定义事件定义和事件状态变化回调，便于灵活扩展。
      */
-    ControllerManagerThread(SharedStateSpace& state, EventBus& bus, StateUpdateQueue& queue,
+    ControllerManagerThread(SharedStateSpace& state, EventBus& bus,
         const std::unordered_map<std::string, EventDefinition>& event_definitions,
         std::function<void(const std::string&)> event_state_change_callback = nullptr)
-        : state(state), bus(bus), queue(queue), running(false),
+        : state(state), bus(bus), running(false),
           event_definitions_(event_definitions),
           event_state_change_callback_(event_state_change_callback) {
         createControllers(); // 创建所有控制器实例
@@ -131,12 +139,11 @@ public:
      * @brief 兼容原有构造函数（无事件定义）
      * @param state 共享状态空间引用
      * @param bus 事件总线引用
-     * @param queue 状态更新队列引用
      *
      * 事件定义需后续通过setEventDefinitions设置。
      */
-    ControllerManagerThread(SharedStateSpace& state, EventBus& bus, StateUpdateQueue& queue)
-        : state(state), bus(bus), queue(queue), running(false) {
+    ControllerManagerThread(SharedStateSpace& state, EventBus& bus)
+        : state(state), bus(bus), running(false) {
         createControllers(); // 创建所有控制器实例
     }
 
@@ -237,14 +244,15 @@ public:
      * @brief 应用状态设置
      * @param state_settings 状态设置映射表
      *
-     * 根据配置表自动设置共享状态空间中的相关变量。
+     * 根据配置表自动设置共享状态空间中的相关变量，可设置的变量见 PARASAFE_CONTROL_FLAGS。
      */
     void applyStateSettings(const std::map<std::string, std::string>& state_settings) {
         for (const auto& [var_name, value] : state_settings) {
-            if (var_name == "throttle_control_enabled") state.throttle_control_enabled = (value == "true");
-            else if (var_name == "brake_control_enabled") state.brake_control_enabled = (value == "true");
-            else if (var_name == "cruise_control_enabled") state.cruise_control_enabled = (value == "true");
-            else if (var_name == "pitch_control_enabled") state.pitch_control_enabled = (value == "true");
+            if (std::atomic<bool>* flag = state.controlFlag(var_name)) {
+                flag->store(value == "true");
+            } else {
+                log_detail("[ControllerManagerThread] Warning: Unknown state setting: " + var_name + "\n");
+            }
         }
     }
 
@@ -335,6 +343,103 @@ public:
         }
     }
 
+    /**
+     * @brief 设置所有控制器由外部执行器步进
+     * @param external true 表示控制器启动时不创建线程，由 stepControllers() 驱动
+     *
+     * 必须在任何控制器启动之前调用。
+     */
+    void setExternallyStepped(bool external) {
+        for (auto& [name, controller] : controllers) controller->setExternallyStepped(external);
+        log_detail(std::string("[ControllerManagerThread] Controllers externally stepped: ") + (external ? "true" : "false") + "\n");
+    }
+
+    /**
+     * @brief 按固定顺序执行所有已启动控制器的一个仿真步
+     * @param dt 时间步长（秒）
+     *
+     * 仅在外部步进模式下使用，执行顺序为控制器创建顺序，保证结果可复现。
+     */
+    void stepControllers(double dt) {
+        for (const auto& controller : controller_order) {
+            if (controller->isActive()) controller->stepOnce(dt);
+        }
+        recordSteppedControllers();
+    }
+
+    /**
+     * @brief 只步进上次步进之后新启动的控制器
+     * @param dt 时间步长（秒），通常为步内事件触发时刻到步末的剩余时间
+     *
+     * 步内定位的事件（EventLocalizer）触发后调用：事件处理器刚启动的控制器以剩余时间响应，
+     * 已在运行的控制器本步的控制量已在上一步边界算出，不再重复步进，否则每次定位事件都会多推进剩余时间。
+     */
+    void stepActivatedControllers(double dt) {
+        for (size_t i = 0; i < controller_order.size(); ++i) {
+            const bool stepped = i < stepped_controllers_.size() && stepped_controllers_[i];
+            if (controller_order[i]->isActive() && !stepped) controller_order[i]->stepOnce(dt);
+        }
+        recordSteppedControllers();
+    }
+
+    /**
+     * @brief 按创建顺序返回所有控制器（任务图执行器为每个控制器建立独立任务）
+     */
+    const std::vector<std::shared_ptr<BaseController>>& getControllers() const { return controller_order; }
+
+    /**
+     * @brief 写入检查点：已触发事件表、各控制器的运行状态与内部状态
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.beginSection("CTRL");
+        std::vector<std::string> triggered;
+        {
+            std::lock_guard<std::mutex> lock(events_mutex);
+            for (const auto& [event_name, is_triggered] : triggered_events) {
+                if (is_triggered) triggered.push_back(event_name);
+            }
+        }
+        std::sort(triggered.begin(), triggered.end()); // 与哈希表遍历顺序无关，相同状态得到相同的检查点
+        writer.write(static_cast<uint32_t>(triggered.size()));
+        for (const auto& event_name : triggered) writer.writeString(event_name);
+
+        writer.write(static_cast<uint32_t>(controller_order.size()));
+        for (const auto& controller : controller_order) {
+            writer.writeString(controller->getName());
+            writer.write(controller->isActive());
+            controller->saveCheckpoint(writer);
+        }
+    }
+
+    /**
+     * @brief 从检查点恢复：按检查点启动/停止各控制器并恢复其内部状态
+     */
+    void restoreCheckpoint(CheckpointReader& reader) {
+        if (!reader.expectSection("CTRL")) return;
+        const uint32_t event_count = reader.read<uint32_t>();
+        {
+            std::lock_guard<std::mutex> lock(events_mutex);
+            triggered_events.clear();
+            for (uint32_t i = 0; i < event_count && reader.ok(); ++i) triggered_events[reader.readString()] = true;
+        }
+
+        const uint32_t controller_count = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < controller_count && reader.ok(); ++i) {
+            const std::string name = reader.readString();
+            const bool active = reader.read<bool>();
+            auto controller = getController(name);
+            if (!controller) {
+                // 后续控制器的数据无法跳过，整个恢复失败
+                reader.fail("检查点中的控制器不存在: " + name);
+                return;
+            }
+            controller->restoreCheckpoint(reader);
+            if (active && !controller->isActive()) controller->start();
+            if (!active && controller->isActive()) controller->stop();
+        }
+        recordSteppedControllers(); // 检查点在步边界保存，此时已启动的控制器都已步进过
+    }
+
     /**
      * @brief 等待管理线程结束
      */
@@ -394,11 +499,14 @@ public:
      * 按照名称注册到controllers映射表，便于统一管理。
      */
     void createControllers() {
-        controllers["油门增加"] = std::make_shared<ThrottleController_Increase>(state, bus, SimulationClock::getInstance(), queue);
-        controllers["油门减少"] = std::make_shared<ThrottleController_Decrease>(state, bus, queue);
+        controllers["油门增加"] = std::make_shared<ThrottleController_Increase>(state, bus, state.clock());
+        controllers["油门减少"] = std::make_shared<ThrottleController_Decrease>(state, bus);
         controllers["刹车"] = std::make_shared<BrakeController>(state, bus);
         controllers["跑道巡航"] = std::make_shared<CruiseOnRunwayController>(state, bus);
         controllers["俯仰角保持"] = std::make_shared<PitchHoldController>(state, bus);
+        for (const char* name : {"油门增加", "油门减少", "刹车", "跑道巡航", "俯仰角保持"}) {
+            controller_order.push_back(controllers[name]);
+        }
         
         log_detail("[ControllerManagerThread] Created controllers:\n");
         for (const auto& [name, controller] : controllers) log_detail("  " + name + "\n");
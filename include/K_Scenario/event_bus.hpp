@@ -26,6 +26,10 @@ struct EventDefinition {
     std::vector<GenericEvents::ControllerAction> actions;  ///< 响应动作
     std::string response_description;    ///< 响应动作描述
     bool triggered{false};               ///< 事件触发标志
+    /// 可选的连续守卫函数：由负变为非负的时刻即事件时刻（如 velocity - ABORT_SPEED）。
+    /// 设置后 EventLocalizer 在步内求根定位事件时刻，未设置的事件只在步边界检测 trigger_condition。
+    /// 守卫为非负时 trigger_condition 中的连续部分应成立。
+    std::function<double(const SharedStateSpace&)> guard = nullptr;
 };
 
 // 事件总线类，用于处理事件订阅和发布
@@ -33,6 +37,12 @@ class EventBus {
 public:
     using EventCallback = std::function<void(const std::any&)>;
 
+    // 事件分发方式
+    enum class DispatchMode {
+        Async,       ///< 由内部工作线程异步分发（默认）
+        Synchronous  ///< 在 publish 调用线程内同步分发，不创建工作线程，用于单线程执行器
+    };
+
     // 事件统计结构
     struct EventStats {
         std::atomic<size_t> total_events{0};
@@ -42,7 +52,12 @@ public:
         std::chrono::steady_clock::time_point last_reset;
     };
 
-    EventBus(SharedStateSpace& state_space) : state(state_space) {
+    EventBus(SharedStateSpace& state_space, DispatchMode mode = DispatchMode::Async)
+        : state(state_space), dispatch_mode(mode) {
+        if (dispatch_mode == DispatchMode::Synchronous) {
+            log_detail("[EventBus] 初始化，同步分发模式，无工作线程\n");
+            return;
+        }
         log_detail("[EventBus] 初始化，事件总线工作线程数: " + std::to_string(MAX_WORKERS) + "\n");
         
         // 创建并启动工作线程
@@ -90,6 +105,10 @@ public:
 
     // 发布事件
     void publish(const std::string& event, const std::any& data = std::any{}) {
+        if (dispatch_mode == DispatchMode::Synchronous) {
+            dispatchNow(event, data);
+            return;
+        }
         std::lock_guard<std::mutex> lock(mtx);
         if (!running) return;
 
@@ -119,6 +138,15 @@ public:
         }
     }
 
+    DispatchMode getDispatchMode() const { return dispatch_mode; }
+
+    // 设置分发观察者：每个事件在调用订阅者之前通知一次（确定性记录/回放用，见 deterministic_replay.hpp）
+    // 须在仿真开始前设置；异步模式下在工作线程调用，顺序不确定
+    void setDispatchObserver(std::function<void(const std::string&)> observer) {
+        std::lock_guard<std::mutex> lock(mtx);
+        dispatch_observer = std::move(observer);
+    }
+
     void clear() {
         std::lock_guard<std::mutex> lock(mtx);
         subscribers.clear();
@@ -138,6 +166,7 @@ private:
     };
 
     SharedStateSpace& state;
+    const DispatchMode dispatch_mode;
     std::unordered_map<std::string, std::vector<EventCallback>> subscribers;
     std::queue<EventItem> event_queue;
     std::mutex mtx;
@@ -148,6 +177,39 @@ private:
     const size_t MAX_QUEUE_SIZE{1000};
     const std::chrono::milliseconds DEFAULT_TIMEOUT{1000};
     std::unordered_map<std::string, EventStats> event_stats;
+    std::function<void(const std::string&)> dispatch_observer;
+
+    // 同步分发：复制回调列表后在锁外执行，回调内可以再次发布事件
+    void dispatchNow(const std::string& event, const std::any& data) {
+        std::vector<EventCallback> callbacks;
+        EventStats* stats = nullptr;
+        std::function<void(const std::string&)> observer;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!running) return;
+            stats = &event_stats[event];
+            stats->total_events++;
+            observer = dispatch_observer;
+            auto it = subscribers.find(event);
+            if (it == subscribers.end()) {
+                log_detail("[EventBus] 警告：事件 " + event + " 没有订阅者\n");
+                return;
+            }
+            callbacks = it->second;
+        }
+        log_detail("[EventBus] 同步处理事件: " + event + "\n");
+        if (observer) observer(event);
+        for (const auto& callback : callbacks) {
+            try {
+                callback(data);
+                stats->processed_events++;
+            } catch (const std::exception& e) {
+                log_detail("[EventBus] 错误：事件处理异常: " + std::string(e.what()) + "\n");
+            } catch (...) {
+                log_detail("[EventBus] 错误：事件处理未知异常\n");
+            }
+        }
+    }
 
     void workerThread() {
         while (running) {
@@ -171,6 +233,7 @@ private:
             if (it != subscribers.end()) {
                 auto& stats = event_stats[item.event];
                 log_detail("[EventBus] 处理事件: " + item.event + "\n");
+                if (dispatch_observer) dispatch_observer(item.event);
                 for (const auto& callback : it->second) {
                     try {
                         callback(item.data);
@@ -23,10 +23,13 @@
 #include <queue>              // 队列容器，事件排队
 #include <any>                // 任意类型容器，事件数据传递
 #include <unordered_map>      // 哈希表容器，事件映射等
+#include <vector>             // 检查点中的事件列表
+#include <algorithm>          // 排序，检查点中事件按名称有序写入
 
 // ParaSAFE系统头文件
 #include "../../include/K_Scenario/shared_state.hpp"               // 共享状态空间结构体
 #include "../../include/K_Scenario/event_bus.hpp"                  // 事件总线，事件发布与订阅
+#include "../../include/K_Scenario/state_access.hpp"               // 状态读写集声明，供任务图调度
 #include "../../include/L_Simulation_Settings/logger.hpp"          // 日志模块，支持详细/简要日志输出
 #include "../../include/L_Simulation_Settings/simulation_clock.hpp"// 仿真时钟
 #include "../../include/L_Simulation_Settings/thread_name_util.hpp"// 线程命名工具，便于调试
@@ -48,66 +51,162 @@ private:
     std::unordered_map<std::string, bool> local_triggered_events;
     mutable std::mutex local_events_mutex;
 
+    // 仿真运行/开始状态的上一次观测值，用于输出状态变化日志
+    bool last_simulation_running{false};
+    bool last_simulation_started{false};
+
+    // 检测周期（秒），0 表示每个时间步检测一次
+    double check_period{0.0};
+
+    // 每步读写集，默认读取所有字段、写入控制标志
+    StateAccess access{kAllStateFields, stateFieldBit(StateField::ControlFlags)};
+
     void check_events() {
         ThreadNaming::set_current_thread_name("EventMonitor");
-        auto& clock = SimulationClock::getInstance();
-        clock.registerThread();
-        bool last_simulation_running = state.simulation_running.load();
-        bool last_simulation_started = state.simulation_started.load();
-        double last_check_time = 0.0;
+        auto& clock = state.clock();
+        const int rate_divisor = getRateDivisor();
+        clock.registerThread(rate_divisor);
         size_t current_step = 0; // 记录当前线程处理到的步数
         
         while (running) {
             if (clock.isRunning()) {
-                clock.waitForNextStep(current_step);
+                clock.waitForNextStep(current_step, rate_divisor);
                 current_step = clock.getStepCount(); // 更新为最新的时钟步数
             } else {
                 std::this_thread::sleep_for(std::chrono::milliseconds(5));
                 continue;
             }
-            double current_time = clock.getCurrentTime();
-            bool current_simulation_running = state.simulation_running.load();
-            bool current_simulation_started = state.simulation_started.load();
-            if (current_simulation_running != last_simulation_running) {
-                log_detail("[事件监测] 仿真运行状态变化: " + 
-                    std::string(last_simulation_running ? "运行中" : "已停止") + " -> " +
-                    std::string(current_simulation_running ? "运行中" : "已停止") + "\n");
-                last_simulation_running = current_simulation_running;
-            }
-            if (current_simulation_started != last_simulation_started) {
-                log_detail("[事件监测] 仿真开始状态变化: " + 
-                    std::string(last_simulation_started ? "已开始" : "未开始") + " -> " +
-                    std::string(current_simulation_started ? "已开始" : "未开始") + "\n");
-                last_simulation_started = current_simulation_started;
-            }
-            for (const auto& [name, event] : event_definitions) {
-                bool already_triggered = false;
-                {
-                    std::lock_guard<std::mutex> lock(local_events_mutex);
-                    auto it = local_triggered_events.find(name);
-                    already_triggered = (it != local_triggered_events.end() && it->second);
-                }
-                
-                // 如果事件未触发过且满足触发条件，则触发事件
-                if (!already_triggered && event.trigger_condition(state)) {
-                    {
-                        std::lock_guard<std::mutex> lock(local_events_mutex);
-                        local_triggered_events[name] = true;
-                    }
-                    bus.publish(name);
-                    log_detail("[事件监测] 触发事件: " + name + " 在时间: " + 
-                        std::to_string(current_time) + " 秒\n");
-                }
-            }
+            checkEventsOnce(clock.getCurrentTime());
             clock.notifyStepCompleted();
-            last_check_time = current_time;
         }
-        clock.unregisterThread();
+        clock.unregisterThread(rate_divisor);
     }
 
 public:
     EventMonitorThread(SharedStateSpace& state, EventBus& bus, const std::unordered_map<std::string, EventDefinition>& event_definitions)
-        : state(state), bus(bus), event_definitions(event_definitions) {}
+        : state(state), bus(bus), event_definitions(event_definitions),
+          last_simulation_running(state.simulation_running.load()),
+          last_simulation_started(state.simulation_started.load()) {}
+
+    /**
+     * @brief 执行一次事件检测
+     * @param current_time 当前仿真时间（秒），用于日志
+     *
+     * 独立线程模式下由检测线程每步调用，单线程执行器模式下由执行器直接调用。
+     */
+    void checkEventsOnce(double current_time) {
+        bool current_simulation_running = state.simulation_running.load();
+        bool current_simulation_started = state.simulation_started.load();
+        if (current_simulation_running != last_simulation_running) {
+            log_detail("[事件监测] 仿真运行状态变化: " + 
+                std::string(last_simulation_running ? "运行中" : "已停止") + " -> " +
+                std::string(current_simulation_running ? "运行中" : "已停止") + "\n");
+            last_simulation_running = current_simulation_running;
+        }
+        if (current_simulation_started != last_simulation_started) {
+            log_detail("[事件监测] 仿真开始状态变化: " + 
+                std::string(last_simulation_started ? "已开始" : "未开始") + " -> " +
+                std::string(current_simulation_started ? "已开始" : "未开始") + "\n");
+            last_simulation_started = current_simulation_started;
+        }
+        for (const auto& [name, event] : event_definitions) {
+            // 如果事件未触发过且满足触发条件，则触发事件
+            if (!isTriggered(name) && event.trigger_condition(state)) {
+                fireEvent(name, current_time);
+            }
+        }
+    }
+
+    /**
+     * @brief 查询事件是否已触发
+     */
+    bool isTriggered(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(local_events_mutex);
+        auto it = local_triggered_events.find(name);
+        return it != local_triggered_events.end() && it->second;
+    }
+
+    /**
+     * @brief 标记并发布事件（每个事件只触发一次）
+     * @param name 事件名称
+     * @param time 事件时刻（秒），步内定位的事件为定位出的时刻
+     * @return 本次调用触发了事件返回 true，事件已触发过返回 false
+     */
+    bool fireEvent(const std::string& name, double time) {
+        {
+            std::lock_guard<std::mutex> lock(local_events_mutex);
+            bool& triggered = local_triggered_events[name];
+            if (triggered) return false;
+            triggered = true;
+        }
+        bus.publish(name);
+        log_detail("[事件监测] 触发事件: " + name + " 在时间: " + 
+            std::to_string(time) + " 秒\n");
+        return true;
+    }
+
+    /**
+     * @brief 写入检查点：已触发事件集合、运行状态的上一次观测值
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.beginSection("EVNT");
+        std::vector<std::string> triggered;
+        {
+            std::lock_guard<std::mutex> lock(local_events_mutex);
+            for (const auto& [name, is_triggered] : local_triggered_events) {
+                if (is_triggered) triggered.push_back(name);
+            }
+        }
+        std::sort(triggered.begin(), triggered.end());
+        writer.write(static_cast<uint32_t>(triggered.size()));
+        for (const auto& name : triggered) writer.writeString(name);
+        writer.write(last_simulation_running);
+        writer.write(last_simulation_started);
+    }
+
+    /**
+     * @brief 从检查点恢复已触发事件集合（不重新发布事件）
+     */
+    void restoreCheckpoint(CheckpointReader& reader) {
+        if (!reader.expectSection("EVNT")) return;
+        const uint32_t count = reader.read<uint32_t>();
+        {
+            std::lock_guard<std::mutex> lock(local_events_mutex);
+            local_triggered_events.clear();
+            for (uint32_t i = 0; i < count && reader.ok(); ++i) local_triggered_events[reader.readString()] = true;
+        }
+        reader.read(last_simulation_running);
+        reader.read(last_simulation_started);
+    }
+
+    /**
+     * @brief 事件定义表
+     */
+    const std::unordered_map<std::string, EventDefinition>& getEventDefinitions() const { return event_definitions; }
+
+    /**
+     * @brief 设置检测周期（必须在 start() 之前调用）
+     * @param period 检测周期（秒），0 表示每个时间步检测一次（默认）
+     */
+    void setCheckPeriod(double period) { check_period = period > 0.0 ? period : 0.0; }
+
+    /**
+     * @brief 检测周期对应的速率分频
+     */
+    int getRateDivisor() const { return state.clock().divisorForPeriod(check_period); }
+
+    /**
+     * @brief checkEventsOnce() 每步读写的共享状态字段
+     *
+     * 触发条件是任意谓词，默认按读取所有字段处理；同步分发时事件处理器在本步内
+     * 修改控制使能和控制器启停，计入 ControlFlags 写集。
+     */
+    StateAccess stateAccess() const { return access; }
+
+    /**
+     * @brief 为已知只读部分字段的事件定义收窄读写集
+     */
+    void setStateAccess(const StateAccess& declared) { access = declared; }
 
     void start() {
         if (!running) {
@@ -0,0 +1,239 @@
+/*
+ * @file event_localization.hpp
+ * @brief 步内事件定位（守卫函数过零检测）头文件
+ *
+ * EventMonitorThread 只在步边界检测 trigger_condition，事件最多晚一个步长触发，
+ * 由此带来的误差（如中止起飞的停止距离）随步长增大。EventLocalizer 替代单线程执行器的
+ * 动力学阶段：对定义了守卫函数（EventDefinition::guard）的事件，先试探推进整步，
+ * 若守卫由负变为非负，则用 Illinois 改进的试位法在步内求出过零时刻 t*，
+ * 推进到 t* 触发事件、让控制器以剩余时间响应，再推进完本步剩余部分。
+ * 因此较大的步长也能得到与小步长一致的事件时刻。
+ *
+ * 使用要求（与 FusedStepExecutor 相同）：
+ *   - 同步事件总线：事件处理器在 fireEvent 内同步执行，控制器在 t* 即生效
+ *   - 单线程执行器内由 EventLocalizer 独占动力学阶段，步内直接在已提交的状态上试探推进并写入运动状态，
+ *     不经后缓冲（没有并发读者）
+ *   - 事件处理器在 t* 新启动的控制器以剩余时间步进一次（ControllerManagerThread::stepActivatedControllers），
+ *     其写入后缓冲的控制输入由提交回调立即提交，在剩余区间内保持（与步边界处理一致的零阶保持）；
+ *     已在运行的控制器本步的控制量已在步边界算出，不再重复步进
+ *
+ * 典型用法（融合执行器）：
+ *   EventLocalizer localizer(state, event_monitor, dynamicsModel, aircraftConfig, forceModel,
+ *       [&](double dt) { controller_manager.stepActivatedControllers(dt); },
+ *       [&]() { state_manager.processStep(); });
+ *   executor.setStage(FusedStage::Dynamics, [&]() {
+ *       localizer.step(clock.getCurrentTime() - clock.getTimeStep(), clock.getTimeStep());
+ *   });
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <cmath>        // 求根
+#include <functional>   // 控制器与提交回调
+#include <memory>       // 模型指针
+#include <string>       // 事件名称
+#include <vector>       // 候选事件
+
+// ParaSAFE系统头文件
+#include "shared_state.hpp"                                  // 共享状态空间
+#include "event_detection.hpp"                               // 事件监测（事件定义与触发）
+#include "../D_DynamicModel/DynamicsModel_FixedWing_Linear.hpp" // 动力学模型接口
+#include "../L_Simulation_Settings/logger.hpp"               // 日志系统
+
+/**
+ * @class EventLocalizer
+ * @brief 在步内定位守卫函数过零时刻并在该时刻触发事件的动力学推进器
+ */
+class EventLocalizer {
+public:
+    using SubStepCallback = std::function<void(double dt)>;
+    using CommitCallback = std::function<void()>;
+
+    /**
+     * @brief 构造事件定位器
+     * @param state 共享状态空间
+     * @param monitor 事件监测器（提供事件定义并负责触发，定位触发后步边界检测不再重复触发）
+     * @param dynamics 动力学模型
+     * @param aircraftConfig 飞机构型
+     * @param forceModel 力学模型
+     * @param step_controllers 事件触发后以剩余时间步进事件刚启动的控制器
+     * @param commit_step 控制器步进后提交其写入后缓冲的控制输入（如 StateManagerThread::processStep）
+     */
+    EventLocalizer(SharedStateSpace& state, EventMonitorThread& monitor,
+                   std::shared_ptr<IDynamicsModel> dynamics,
+                   std::shared_ptr<AircraftConfigBase> aircraftConfig,
+                   std::shared_ptr<IForceModel> forceModel,
+                   SubStepCallback step_controllers, CommitCallback commit_step)
+        : state_(state), monitor_(monitor), dynamics_(std::move(dynamics)),
+          aircraft_config_(std::move(aircraftConfig)), force_model_(std::move(forceModel)),
+          step_controllers_(std::move(step_controllers)), commit_step_(std::move(commit_step)) {}
+
+    /**
+     * @brief 设置时间容差（秒），过零时刻的求根区间收缩到该宽度以内即停止，默认 1e-9
+     */
+    void setTimeTolerance(double tolerance) { time_tolerance_ = tolerance > 0.0 ? tolerance : 1e-9; }
+
+    /**
+     * @brief 设置每次求根的最大迭代次数，默认 50
+     */
+    void setMaxIterations(int iterations) { max_iterations_ = iterations > 0 ? iterations : 50; }
+
+    /**
+     * @brief 推进一个时间步 [t0, t0+dt]，步内定位并触发守卫事件
+     */
+    void step(double t0, double dt) {
+        double t = t0;
+        double remaining = dt;
+        std::vector<std::string> skipped; // 本步内守卫过零但离散条件不成立的事件，交给步边界检测
+
+        while (true) {
+            const Kinematics start = capture();
+            candidates_.clear();
+            for (const auto& [name, event] : monitor_.getEventDefinitions()) {
+                if (!event.guard || monitor_.isTriggered(name) || contains(skipped, name)) continue;
+                const double g0 = event.guard(state_);
+                if (g0 < 0.0) candidates_.push_back({&name, &event, g0});
+            }
+
+            advance(start, t, remaining);
+            if (candidates_.empty()) return;
+
+            // 找出最早的过零时刻
+            const Candidate* first = nullptr;
+            double first_tau = remaining;
+            for (const auto& c : candidates_) {
+                if (c.event->guard(state_) < 0.0) continue;
+                const double tau = localize(start, t, remaining, c);
+                if (!first || tau < first_tau) {
+                    first = &c;
+                    first_tau = tau;
+                }
+            }
+            if (!first) return;
+
+            // 推进到过零时刻并触发事件（同步分发，处理器立即修改控制标志）
+            advance(start, t, first_tau);
+            t += first_tau;
+            remaining -= first_tau;
+            if (!first->event->trigger_condition(state_)) {
+                skipped.push_back(*first->name);
+            } else if (monitor_.fireEvent(*first->name, t)) {
+                localized_count_++;
+                // 事件刚启动的控制器以剩余时间响应，其控制输入在剩余区间内生效
+                if (remaining > 0.0) {
+                    if (step_controllers_) step_controllers_(remaining);
+                    if (commit_step_) commit_step_();
+                }
+            }
+            if (remaining <= 0.0) return;
+        }
+    }
+
+    /**
+     * @brief 已在步内定位触发的事件数
+     */
+    size_t getLocalizedCount() const { return localized_count_; }
+
+private:
+    struct Kinematics {
+        double position;
+        double velocity;
+        double acceleration;
+        double altitude;          // 以下为纵向三自由度模型推进的状态
+        double normal_velocity;
+        double pitch_angle;
+        double pitch_rate;
+    };
+
+    struct Candidate {
+        const std::string* name;
+        const EventDefinition* event;
+        double g0;   ///< 起点处的守卫值（< 0）
+    };
+
+    Kinematics capture() const {
+        return {state_.position.load(), state_.velocity.load(), state_.acceleration.load(),
+                state_.altitude.load(), state_.normal_velocity.load(), state_.pitch_angle.load(), state_.pitch_rate.load()};
+    }
+
+    void restore(const Kinematics& k) {
+        state_.position.store(k.position);
+        state_.velocity.store(k.velocity);
+        state_.acceleration.store(k.acceleration);
+        state_.altitude.store(k.altitude);
+        state_.normal_velocity.store(k.normal_velocity);
+        state_.pitch_angle.store(k.pitch_angle);
+        state_.pitch_rate.store(k.pitch_rate);
+    }
+
+    // 从 start 推进 tau，结果写入状态空间
+    void advance(const Kinematics& start, double t, double tau) {
+        restore(start);
+        const DynamicsStepResult r = dynamics_->propagate(state_, tau, aircraft_config_, force_model_);
+        state_.thrust.store(r.forces.thrust);
+        state_.drag_force.store(r.forces.drag);
+        state_.brake_force.store(r.forces.brake_force);
+        state_.position.store(r.position);
+        state_.velocity.store(r.velocity);
+        state_.acceleration.store(r.acceleration);
+        if (r.longitudinal) {
+            state_.altitude.store(r.altitude);
+            state_.normal_velocity.store(r.normal_velocity);
+            state_.pitch_angle.store(r.pitch_angle);
+            state_.pitch_rate.store(r.pitch_rate);
+        }
+        state_.simulation_time.store(t + tau, std::memory_order_release);
+    }
+
+    /**
+     * @brief Illinois 试位法求守卫过零时刻
+     * @return 过零时刻（相对 t），取区间的非负端，保证该时刻守卫 >= 0
+     *
+     * 守卫对推进时间线性时（如线性模型的速度、位置守卫）一次迭代即收敛。
+     */
+    double localize(const Kinematics& start, double t, double span, const Candidate& c) {
+        double a = 0.0, fa = c.g0;
+        advance(start, t, span);
+        double b = span, fb = c.event->guard(state_);
+        int side = 0;
+        for (int i = 0; i < max_iterations_ && b - a > time_tolerance_; ++i) {
+            double x = (a * fb - b * fa) / (fb - fa);
+            if (!(x > a && x < b)) x = 0.5 * (a + b); // 数值退化时二分
+            advance(start, t, x);
+            const double fx = c.event->guard(state_);
+            if (fx >= 0.0) {
+                b = x;
+                fb = fx;
+                if (side == 1) fa *= 0.5; // 连续两次同侧，削弱另一端避免单侧收敛
+                side = 1;
+            } else {
+                a = x;
+                fa = fx;
+                if (side == -1) fb *= 0.5;
+                side = -1;
+            }
+            if (fx == 0.0) break;
+        }
+        return b;
+    }
+
+    static bool contains(const std::vector<std::string>& names, const std::string& name) {
+        for (const auto& n : names) {
+            if (n == name) return true;
+        }
+        return false;
+    }
+
+    SharedStateSpace& state_;
+    EventMonitorThread& monitor_;
+    std::shared_ptr<IDynamicsModel> dynamics_;
+    std::shared_ptr<AircraftConfigBase> aircraft_config_;
+    std::shared_ptr<IForceModel> force_model_;
+    SubStepCallback step_controllers_;
+    CommitCallback commit_step_;
+    std::vector<Candidate> candidates_;
+    double time_tolerance_ = 1e-9;
+    int max_iterations_ = 50;
+    size_t localized_count_ = 0;
+};
@@ -0,0 +1,146 @@
+/*
+ * @file fleet_state.hpp
+ * @brief 多机状态容器（结构数组）头文件
+ *
+ * SharedStateSpace 以标量原子变量描述一架飞机；机场容量等研究需要同时推进成百上千架飞机，
+ * FleetState 把每架飞机的运动/控制字段按字段分列存放，以飞机编号为下标：
+ *
+ *     position[0..N) | velocity[0..N) | acceleration[0..N) | throttle[0..N) | ...
+ *
+ * 字段与 SharedStateSpace 相同，来自注册表 PARASAFE_STATE_FIELDS（仿真时间为全机队共用的一个值），
+ * 另有力学计算用的构型参数列（质量、最大推力等，见 AircraftParams）和合外力列。
+ * 力学模型（IForceModel::calculateFleetForces）和动力学模型（IDynamicsModel::stepFleet）
+ * 各用一次调用、对每列顺序扫描推进整个机队，编译器可对内层循环自动向量化。
+ *
+ * FleetState 不含原子变量和同步原语，同一时刻只应由一个线程推进；
+ * 各架飞机的控制量（油门、刹车）由调用方在两步之间写入对应列。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <array>     // 按字段分列
+#include <cstddef>   // size_t
+#include <vector>    // 各列存储
+
+// ParaSAFE系统头文件
+#include "state_fields.hpp"                                  // 字段注册表
+#include "state_access.hpp"                                  // 字段枚举
+#include "../A_Aircraft_Configuration/aircraft_config.hpp"   // 构型参数
+
+/**
+ * @brief 机队构型参数列
+ */
+enum class FleetParam : size_t {
+    Mass = 0,                    ///< 质量（kg）
+    MaxThrust,                   ///< 最大推力（N）
+    MaxBrakeForce,               ///< 最大刹车力（N）
+    DragCoefficient,             ///< 阻力系数
+    StaticFrictionCoefficient,   ///< 静摩擦系数
+    Count
+};
+
+/**
+ * @class FleetState
+ * @brief 按字段分列存放的多机状态
+ */
+class FleetState {
+public:
+    static constexpr size_t kParamCount = static_cast<size_t>(FleetParam::Count);
+
+    FleetState() = default;
+    explicit FleetState(size_t expected_aircraft) { reserve(expected_aircraft); }
+
+    /**
+     * @brief 预分配 n 架飞机的容量（推进过程中不再分配内存）
+     */
+    void reserve(size_t n) {
+        for (size_t f = 0; f < kStateFieldCount; ++f) {
+            if (isPerAircraft(static_cast<StateField>(f))) fields_[f].reserve(n);
+        }
+        for (auto& column : params_) column.reserve(n);
+        net_force_.reserve(n);
+    }
+
+    /**
+     * @brief 加入一架飞机，运动/控制字段初始为 0
+     * @return 飞机编号（各列下标）
+     */
+    size_t addAircraft(const AircraftConfigBase& config) { return addAircraft(AircraftParams::from(config)); }
+
+    size_t addAircraft(const AircraftParams& params) {
+        for (size_t f = 0; f < kStateFieldCount; ++f) {
+            if (isPerAircraft(static_cast<StateField>(f))) fields_[f].push_back(0.0);
+        }
+        param(FleetParam::Mass).push_back(params.mass);
+        param(FleetParam::MaxThrust).push_back(params.max_thrust);
+        param(FleetParam::MaxBrakeForce).push_back(params.max_brake_force);
+        param(FleetParam::DragCoefficient).push_back(params.drag_coefficient);
+        param(FleetParam::StaticFrictionCoefficient).push_back(params.static_friction_coefficient);
+        net_force_.push_back(0.0);
+        return count_++;
+    }
+
+    size_t size() const { return count_; }
+
+    /**
+     * @brief 字段是否按飞机分列（仿真时间为全机队共用）
+     */
+    static constexpr bool isPerAircraft(StateField field) { return field != StateField::SimulationTime; }
+
+    /**
+     * @brief 字段列首地址（共用字段 SimulationTime 为空列，使用 simulation_time）
+     */
+    double* column(StateField field) { return fields_[index(field)].data(); }
+    const double* column(StateField field) const { return fields_[index(field)].data(); }
+
+    double& at(StateField field, size_t id) { return fields_[index(field)][id]; }
+    double at(StateField field, size_t id) const { return fields_[index(field)][id]; }
+
+    /**
+     * @brief 构型参数列
+     */
+    std::vector<double>& param(FleetParam p) { return params_[static_cast<size_t>(p)]; }
+    const std::vector<double>& param(FleetParam p) const { return params_[static_cast<size_t>(p)]; }
+
+    /**
+     * @brief 合外力列（力学模型写入、动力学模型读取的中间量）
+     */
+    double* netForce() { return net_force_.data(); }
+    const double* netForce() const { return net_force_.data(); }
+
+    /**
+     * @brief 每架飞机占用的字节数（各列每元素一个 double，不含 vector 预留的余量）
+     */
+    static constexpr size_t bytesPerAircraft() {
+        return (perAircraftFieldCount() + kParamCount + 1) * sizeof(double);
+    }
+
+    /**
+     * @brief 当前实际分配的字节数（含 vector 预留的余量）
+     */
+    size_t allocatedBytes() const {
+        size_t bytes = net_force_.capacity() * sizeof(double);
+        for (const auto& column : fields_) bytes += column.capacity() * sizeof(double);
+        for (const auto& column : params_) bytes += column.capacity() * sizeof(double);
+        return bytes;
+    }
+
+    double simulation_time = 0.0;   ///< 全机队共用的仿真时间
+
+private:
+    static size_t index(StateField field) { return static_cast<size_t>(field); }
+
+    static constexpr size_t perAircraftFieldCount() {
+        size_t count = 0;
+        for (size_t f = 0; f < kStateFieldCount; ++f) {
+            if (isPerAircraft(static_cast<StateField>(f))) ++count;
+        }
+        return count;
+    }
+
+    std::array<std::vector<double>, kStateFieldCount> fields_;   ///< 运动/控制字段，共用字段为空列
+    std::array<std::vector<double>, kParamCount> params_;        ///< 构型参数
+    std::vector<double> net_force_;                              ///< 合外力
+    size_t count_ = 0;
+};
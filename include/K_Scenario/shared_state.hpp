@@ -6,9 +6,10 @@
  * 提供线程安全的状态访问机制，支持多线程环境下的并发操作。
  *
  * 主要功能：
- *   - 定义仿真系统的所有状态变量
+ *   - 定义仿真系统的所有状态变量（运动/控制字段由 state_fields.hpp 的注册表生成）
  *   - 提供线程安全的状态访问接口
- *   - 支持状态快照和版本控制
+ *   - 支持状态快照和版本控制，观察者可休眠等待新版本或字段变化
+ *   - 前/后双缓冲：状态字段为已提交的本步状态，写者写入后缓冲 next，步屏障处 commitStep() 提交
  *   - 实现飞行模式和控制权管理
  */
 
@@ -24,49 +25,65 @@
 #include <memory>           // 智能指针，管理动态内存
 #include <functional>       // 函数对象，支持回调函数
 #include <iomanip>          // 输出格式控制，用于状态信息的格式化显示
+#include <array>            // 快照成员表
 
 // ParaSAFE系统头文件
 #include "../L_Simulation_Settings/simulation_clock.hpp"  // 仿真时钟，提供时间同步功能
 #include "../L_Simulation_Settings/simulation_config_base.hpp"  // 仿真配置基类，定义基础配置参数
+#include "../L_Simulation_Settings/checkpoint.hpp"  // 检查点读写
+#include "../L_Simulation_Settings/seqlock.hpp"  // 顺序锁，无锁一致性快照
+#include "../L_Simulation_Settings/change_signal.hpp"  // 快照发布通知，观察者休眠等待
+#include "state_fields.hpp"  // 状态字段注册表
+#include "step_state_buffer.hpp"  // 步状态后缓冲
+#include "state_history.hpp"  // 最近 N 秒状态历史
 #include "../A_Aircraft_Configuration/aircraft_config.hpp"  // 飞机配置，定义飞机相关参数
 
-// 状态快照结构体
+// 状态快照结构体：注册表中的全部运动/控制字段（state_fields.hpp）
 struct StateSnapshot {
-    double position;
-    double velocity;
-    double acceleration;
-    double throttle;
-    double brake;
-    double thrust;
-    double drag_force;
-    double brake_force;
-    double simulation_time;
-    double pitch_angle;            ///< 俯仰角（弧度）
-    double pitch_rate;             ///< 俯仰角变化率（弧度/秒）
-    double pitch_control_output;    ///< 俯仰角控制输出
+#define PARASAFE_SNAPSHOT_MEMBER(Enum, member, ...) double member;
+    PARASAFE_STATE_FIELDS(PARASAFE_SNAPSHOT_MEMBER)
+#undef PARASAFE_SNAPSHOT_MEMBER
 };
 
-class SharedStateSpace {
+/// 按 StateField 下标访问快照成员
+constexpr std::array<double StateSnapshot::*, kStateFieldCount> kSnapshotMembers = {{
+#define PARASAFE_SNAPSHOT_MEMBER_PTR(Enum, member, ...) &StateSnapshot::member,
+    PARASAFE_STATE_FIELDS(PARASAFE_SNAPSHOT_MEMBER_PTR)
+#undef PARASAFE_SNAPSHOT_MEMBER_PTR
+}};
+
+inline double snapshotValue(const StateSnapshot& s, StateField f) {
+    return s.*kSnapshotMembers[static_cast<size_t>(f)];
+}
+
+/**
+ * @brief 前缓冲：已提交的运动/控制字段（注册表 PARASAFE_STATE_FIELDS，含俯仰角、俯仰角变化率、
+ *        俯仰角控制输出和仿真时间）
+ *
+ * 步内只读，动力学和控制器通过 SharedStateSpace::next 写入下一步的值，由 commitStep() 在步屏障处提交。
+ * alignas(64) 使前缓冲独占缓存行，不与步内被改写的控制开关、计数器等共享缓存行，步内各核读取的缓存行
+ * 只在提交时失效一次。
+ */
+struct alignas(64) StateFrontBuffer {
+#define PARASAFE_STATE_ATOMIC(Enum, member, ...) std::atomic<double> member{0.0};
+    PARASAFE_STATE_FIELDS(PARASAFE_STATE_ATOMIC)
+#undef PARASAFE_STATE_ATOMIC
+};
+
+class SharedStateSpace : public StateFrontBuffer {
 public:
     // 构造函数
     SharedStateSpace() = default;
 
     // 需要外部访问的成员变量
-    std::atomic<double> position{0.0};
-    std::atomic<double> velocity{0.0};
-    std::atomic<double> acceleration{0.0};
-    std::atomic<double> throttle{0.0};
-    std::atomic<double> brake{0.0};
-    std::atomic<double> simulation_time{0.0};
-    std::atomic<double> thrust{0.0};
-    std::atomic<double> brake_force{0.0};
-    std::atomic<double> drag_force{0.0};
+    // 运动/控制字段继承自 StateFrontBuffer（前缓冲），以 state.position 等直接访问
+    // 控制开关（注册表 PARASAFE_CONTROL_FLAGS）：油门、刹车、跑道巡航、俯仰角控制是否启用
+#define PARASAFE_CONTROL_FLAG_ATOMIC(member) std::atomic<bool> member{false};
+    PARASAFE_CONTROL_FLAGS(PARASAFE_CONTROL_FLAG_ATOMIC)
+#undef PARASAFE_CONTROL_FLAG_ATOMIC
     std::atomic<bool> simulation_running{false};
     std::atomic<bool> simulation_started{false};
     std::atomic<bool> final_stop_enabled{false};
-    std::atomic<bool> throttle_control_enabled{false};
-    std::atomic<bool> brake_control_enabled{false};
-    std::atomic<bool> cruise_control_enabled{false};
     std::atomic<bool> abort_triggered{false};
     std::atomic<bool> system_ready{false};
     std::atomic<bool> user_confirmed{false};
@@ -75,12 +92,6 @@ public:
     std::atomic<double> abort_speed_threshold{0.0};
     std::atomic<int> zero_velocity_count{0};
     std::atomic<SimulationClock*> simulation_clock{nullptr};
-    
-    // 俯仰角控制相关状态变量
-    std::atomic<double> pitch_angle{0.0};           ///< 当前俯仰角（弧度）
-    std::atomic<double> pitch_rate{0.0};            ///< 俯仰角变化率（弧度/秒）
-    std::atomic<double> pitch_control_output{0.0};  ///< 俯仰角控制输出
-    std::atomic<bool> pitch_control_enabled{false}; ///< 俯仰角控制启用标志
 
     // 同步原语
     mutable std::mutex mtx;
@@ -88,10 +99,18 @@ public:
     std::mutex confirmation_mutex;
     std::condition_variable confirmation_cv;
 
-    // 状态快照机制
-    StateSnapshot current_state;
-    std::mutex state_mutex;
+    // 状态快照机制（SeqLock 独占缓存行）：每步由状态空间处理（StateManagerThread::processStep）发布一次，
+    // 读者（数据记录、printState 等）通过 getState() 无锁读取一致的副本，从不阻塞写者
+    SeqLock<StateSnapshot> snapshot;
     std::atomic<uint64_t> state_version{0};
+    ChangeSignal state_changed;   ///< 每次发布快照后通知，waitForVersion / waitForFieldChange 在其上等待
+
+    // 后缓冲：本步各写者产生的下一步状态，按写者分块、各块独占缓存行
+    StepStateBuffer next;
+
+    // 最近 N 秒的已发布快照（history.configure() 之后才记录），供事件条件等做时间窗口查询，
+    // 在发布快照时写入，只应在仿真步内或仿真结束后读取
+    StateHistory history;
 
     // 飞行模式管理
     enum class FlightMode {
@@ -112,46 +131,129 @@ public:
     
     ControlAuthority control_auth;
     
+    /**
+     * @brief 只读的前缓冲视图（步内读者只需已提交的运动/控制字段时使用）
+     */
+    const StateFrontBuffer& committed() const { return *this; }
+
+    /**
+     * @brief 双缓冲字段对应的前缓冲原子变量
+     */
+    std::atomic<double>& field(StateField f) {
+        switch (f) {
+#define PARASAFE_STATE_FIELD_CASE(Enum, member, ...) case StateField::Enum: return member;
+            PARASAFE_STATE_FIELDS(PARASAFE_STATE_FIELD_CASE)
+#undef PARASAFE_STATE_FIELD_CASE
+            default: return simulation_time;
+        }
+    }
+
+    /**
+     * @brief 按名称查找控制开关（配置文件 state_settings 用），未登记的名称返回 nullptr
+     */
+    std::atomic<bool>* controlFlag(const std::string& name) {
+#define PARASAFE_CONTROL_FLAG_LOOKUP(member) if (name == #member) return &member;
+        PARASAFE_CONTROL_FLAGS(PARASAFE_CONTROL_FLAG_LOOKUP)
+#undef PARASAFE_CONTROL_FLAG_LOOKUP
+        return nullptr;
+    }
+
+    /**
+     * @brief 提交本步：把后缓冲中写过的字段复制到前缓冲（步屏障处调用，此时没有并发读写者）
+     * @return 本步提交的字段掩码
+     */
+    uint32_t commitStep() {
+        const uint32_t written = next.take();
+        for (size_t i = 0; i < StepStateBuffer::kFieldCount; ++i) {
+            if (!(written & (uint32_t{1} << i))) continue;
+            const StateField f = static_cast<StateField>(i);
+            field(f).store(next.value(f), std::memory_order_release);
+        }
+        return written;
+    }
+
     // 状态快照方法
+    /**
+     * @brief 发布一个快照（单写者：同一时刻只能有一个线程发布）
+     */
     void updateState(const StateSnapshot& new_state) {
-        std::lock_guard<std::mutex> lock(state_mutex);
-        current_state = new_state;
+        snapshot.store(new_state);
+        history.push(new_state.simulation_time, new_state, kSnapshotMembers);
         state_version.fetch_add(1, std::memory_order_release);
+        state_changed.notify(); // 没有观察者等待时只是一次原子自增
     }
+    /**
+     * @brief 读取当前各状态字段，发布为本步快照（由每步最后写状态的一方调用）
+     */
+    void publishSnapshot() { updateState(captureSnapshot()); }
+    /**
+     * @brief 直接读取当前各状态字段（与写者并发时各字段可能来自不同时刻）
+     */
+    StateSnapshot captureSnapshot() const {
+        StateSnapshot s;
+#define PARASAFE_STATE_FIELD_LOAD(Enum, member, ...) s.member = member.load(std::memory_order_acquire);
+        PARASAFE_STATE_FIELDS(PARASAFE_STATE_FIELD_LOAD)
+#undef PARASAFE_STATE_FIELD_LOAD
+        return s;
+    }
+    /**
+     * @brief 最近一次发布的快照：所有字段来自同一步，无锁
+     */
     StateSnapshot getState() const {
-        std::unique_lock<std::mutex> lock(const_cast<std::mutex&>(state_mutex));
-        return StateSnapshot{
-            position.load(std::memory_order_acquire),
-            velocity.load(std::memory_order_acquire),
-            acceleration.load(std::memory_order_acquire),
-            throttle.load(std::memory_order_acquire),
-            brake.load(std::memory_order_acquire),
-            thrust.load(std::memory_order_acquire),
-            drag_force.load(std::memory_order_acquire),
-            brake_force.load(std::memory_order_acquire),
-            simulation_time.load(std::memory_order_acquire),
-            pitch_angle.load(std::memory_order_acquire),
-            pitch_rate.load(std::memory_order_acquire),
-            pitch_control_output.load(std::memory_order_acquire)
-        };
+        return snapshot.load();
     }
     uint64_t getStateVersion() const {
         return state_version.load(std::memory_order_acquire);
     }
     bool waitForStateUpdate(uint64_t current_version, std::chrono::milliseconds timeout) {
-        auto start = std::chrono::steady_clock::now();
-        while (state_version.load(std::memory_order_acquire) == current_version) {
-            if (std::chrono::steady_clock::now() - start > timeout) {
-                return false;
-            }
-            std::this_thread::yield();
-        }
-        return true;
+        return waitForVersion(current_version, timeout) > current_version;
+    }
+
+    // 订阅接口：观察者（实时显示、外部工具等）先短暂自旋再休眠，空闲时不占用 CPU，发布快照后即被唤醒。
+    // 仿真停止（setSimulationRunning(false)）时所有等待立即返回。
+    /**
+     * @brief 等待发布的快照版本超过 version
+     * @param timeout 超时时间，默认不限时
+     * @return 返回时的快照版本（超时或仿真停止时可能仍不超过 version）
+     */
+    template <typename Rep = int64_t, typename Period = std::nano>
+    uint64_t waitForVersion(uint64_t version,
+                            std::chrono::duration<Rep, Period> timeout = std::chrono::duration<Rep, Period>::max()) {
+        state_changed.waitUntil([this, version] { return getStateVersion() > version; }, timeout);
+        return getStateVersion();
+    }
+
+    /**
+     * @brief 等待发布的快照中字段 field 的值不再等于 old_value
+     * @param timeout 超时时间，默认不限时
+     * @return 字段是否已改变（超时或仿真停止时为 false）
+     */
+    template <typename Rep = int64_t, typename Period = std::nano>
+    bool waitForFieldChange(StateField field, double old_value,
+                            std::chrono::duration<Rep, Period> timeout = std::chrono::duration<Rep, Period>::max()) {
+        return state_changed.waitUntil(
+            [this, field, old_value] { return snapshotValue(getState(), field) != old_value; }, timeout);
+    }
+
+    // 仿真时钟访问器：各组件通过状态空间取得本仿真的时钟，未绑定时使用进程默认时钟
+    void setClock(SimulationClock& clock) { simulation_clock.store(&clock, std::memory_order_release); }
+    SimulationClock& clock() const {
+        SimulationClock* bound = simulation_clock.load(std::memory_order_acquire);
+        return bound ? *bound : SimulationClock::getInstance();
     }
 
     // 控制标志访问器
     bool isSimulationRunning() const { return simulation_running.load(); }
-    void setSimulationRunning(bool value) { simulation_running.store(value); }
+    void setSimulationRunning(bool value) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            simulation_running.store(value, std::memory_order_release);
+        }
+        cv.notify_all();
+        // 仿真停止时释放所有快照订阅者，重新开始后恢复等待
+        if (value) state_changed.reset();
+        else state_changed.cancel();
+    }
     bool isThrottleControlEnabled() const { return throttle_control_enabled.load(); }
     void setThrottleControlEnabled(bool value) { throttle_control_enabled.store(value); }
     bool isBrakeControlEnabled() const { return brake_control_enabled.load(); }
@@ -214,6 +316,63 @@ public:
         log_detail("[SharedState] 最终停止通知已发送\n");
     }
 
+    // 等待仿真结束（simulation_running 经 setSimulationRunning(false) 置为 false）
+    void wait_for_simulation_end() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this] { return !simulation_running.load(std::memory_order_acquire); });
+        log_detail("[SharedState] 仿真结束等待完成\n");
+    }
+
+    /**
+     * @brief 写入检查点：所有状态变量、控制标志、飞行模式、控制权、最近发布的快照、后缓冲中尚未提交的写入和状态历史
+     *        （不含时钟绑定与同步原语）
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.beginSection("STAT");
+#define PARASAFE_STATE_FIELD_SAVE(Enum, member, ...) writer.write(member);
+        PARASAFE_STATE_FIELDS(PARASAFE_STATE_FIELD_SAVE)
+#undef PARASAFE_STATE_FIELD_SAVE
+#define PARASAFE_CONTROL_FLAG_SAVE(member) writer.write(member);
+        PARASAFE_CONTROL_FLAGS(PARASAFE_CONTROL_FLAG_SAVE)
+#undef PARASAFE_CONTROL_FLAG_SAVE
+        writer.write(simulation_running); writer.write(simulation_started); writer.write(final_stop_enabled);
+        writer.write(abort_triggered); writer.write(system_ready); writer.write(user_confirmed);
+        writer.write(target_speed); writer.write(abort_speed); writer.write(abort_speed_threshold);
+        writer.write(zero_velocity_count);
+        writer.write(flight_mode);
+        writer.write(control_auth.pilot_has_throttle_control); writer.write(control_auth.pilot_has_brake_control);
+        writer.write(control_auth.auto_system_has_throttle_control); writer.write(control_auth.auto_system_has_brake_control);
+        writer.write(snapshot.load());
+        writer.write(state_version);
+        next.saveCheckpoint(writer);
+        history.saveCheckpoint(writer);
+    }
+
+    /**
+     * @brief 从检查点恢复（字段顺序与 saveCheckpoint 一致）
+     */
+    void restoreCheckpoint(CheckpointReader& reader) {
+        if (!reader.expectSection("STAT")) return;
+#define PARASAFE_STATE_FIELD_RESTORE(Enum, member, ...) reader.read(member);
+        PARASAFE_STATE_FIELDS(PARASAFE_STATE_FIELD_RESTORE)
+#undef PARASAFE_STATE_FIELD_RESTORE
+#define PARASAFE_CONTROL_FLAG_RESTORE(member) reader.read(member);
+        PARASAFE_CONTROL_FLAGS(PARASAFE_CONTROL_FLAG_RESTORE)
+#undef PARASAFE_CONTROL_FLAG_RESTORE
+        reader.read(simulation_running); reader.read(simulation_started); reader.read(final_stop_enabled);
+        reader.read(abort_triggered); reader.read(system_ready); reader.read(user_confirmed);
+        reader.read(target_speed); reader.read(abort_speed); reader.read(abort_speed_threshold);
+        reader.read(zero_velocity_count);
+        reader.read(flight_mode);
+        reader.read(control_auth.pilot_has_throttle_control); reader.read(control_auth.pilot_has_brake_control);
+        reader.read(control_auth.auto_system_has_throttle_control); reader.read(control_auth.auto_system_has_brake_control);
+        snapshot.store(reader.read<StateSnapshot>());
+        reader.read(state_version);
+        next.restoreCheckpoint(reader);
+        history.restoreCheckpoint(reader);
+        cv.notify_all(); // 运行标志可能已改变
+    }
+
     // 原子更新状态变量
     void update_state(double new_position, double new_velocity, double new_acceleration) {
         position.store(new_position, std::memory_order_release);
@@ -317,17 +476,17 @@ public:
     }
 
     void printState() const {
+        if (!Logger::getInstance().isEnabled()) return; // 日志关闭时（如批量仿真）跳过字符串拼接
+        const StateSnapshot s = getState(); // 同一步的一致快照
         std::ostringstream oss;
         oss << std::fixed << std::setprecision(2);
-        oss << "时间: " << simulation_time.load() << "s, ";
-        oss << "位置: " << position.load() << "m, ";
-        oss << "速度: " << velocity.load() << "m/s, ";
-        oss << "加速度: " << acceleration.load() << "m/s², ";
-        oss << "油门: " << std::setprecision(3) << throttle.load() * 100 << "%, ";
-        oss << "刹车: " << std::setprecision(3) << brake.load() * 100 << "%, ";
-        oss << "推力: " << thrust.load() << "N, ";
-        oss << "阻力: " << drag_force.load() << "N, ";
-        oss << "刹车力: " << brake_force.load() << "N";
+        oss << "时间: " << s.simulation_time << "s";
+        for (size_t i = 0; i < kStateFieldCount; ++i) {
+            const StateFieldInfo& info = kStateFieldInfo[i];
+            if (!info.inLog()) continue;
+            oss << ", " << info.label << ": " << std::setprecision(info.display_precision)
+                << snapshotValue(s, static_cast<StateField>(i)) * info.display_scale << info.unit;
+        }
         
         // 添加飞行模式信息
         auto mode = flight_mode.load();
@@ -0,0 +1,91 @@
+/*
+ * @file simulation_checkpoint.hpp
+ * @brief 整个仿真的检查点保存与恢复头文件
+ *
+ * 一个检查点依次包含：时钟（时间、步数、步长）、共享状态空间的全部字段（含后缓冲中尚未提交的写入）、事件监测器的已触发事件、
+ * 控制器管理器的已触发事件及各控制器的运行状态和内部状态（如俯仰角保持控制器的积分项与上次误差）、
+ * 数据记录器的输出位置（可选）。恢复只是一次内存拷贝（外加数据文件截断），耗时为微秒级，
+ * 不需要从头重新仿真。
+ *
+ * 使用要求：
+ *   - 在步边界保存和恢复：融合执行器 / 任务图执行器的停止条件回调中或执行器运行前后
+ *   - 恢复时时钟必须处于停止状态；同步事件总线没有未分发的事件
+ *   - 恢复方与保存方使用相同的场景（事件定义、控制器组成）和同一构建的程序
+ *
+ * 典型用法（中止起飞：前 20 秒只仿真一次）：
+ *   std::string blob = SimulationCheckpoint::capture(state, clock, event_monitor, controller_manager, &recorder);
+ *   Checkpoint::saveToFile(blob, "output/checkpoint.bin");
+ *   ...
+ *   SimulationCheckpoint::restore(blob, state, clock, event_monitor, controller_manager, &recorder);
+ *   executor.run();   // 从检查点时刻继续
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <chrono>   // 恢复耗时
+#include <string>   // 检查点数据
+
+// ParaSAFE系统头文件
+#include "shared_state.hpp"                                // 共享状态空间
+#include "event_detection.hpp"                             // 事件监测
+#include "controller_manager.hpp"                          // 控制器管理器
+#include "../L_Simulation_Settings/simulation_clock.hpp"   // 仿真时钟
+#include "../L_Simulation_Settings/data_recorder.hpp"      // 数据记录
+#include "../L_Simulation_Settings/checkpoint.hpp"         // 检查点读写
+#include "../L_Simulation_Settings/logger.hpp"             // 日志系统
+
+namespace SimulationCheckpoint {
+
+    /**
+     * @brief 保存整个仿真的检查点
+     * @param recorder 数据记录器，为 nullptr 时不保存输出位置
+     * @return 检查点二进制数据
+     */
+    inline std::string capture(const SharedStateSpace& state, const SimulationClock& clock,
+                               const EventMonitorThread& event_monitor,
+                               const ControllerManagerThread& controller_manager,
+                               const DataRecorderThread* recorder = nullptr) {
+        CheckpointWriter writer;
+        clock.saveCheckpoint(writer);
+        state.saveCheckpoint(writer);
+        event_monitor.saveCheckpoint(writer);
+        controller_manager.saveCheckpoint(writer);
+        writer.write(recorder != nullptr);
+        if (recorder) recorder->saveCheckpoint(writer);
+        return writer.release();
+    }
+
+    /**
+     * @brief 从检查点恢复整个仿真
+     * @param recorder 数据记录器，为 nullptr 时忽略检查点中的输出位置
+     * @return 成功返回 true；失败时记录原因，仿真状态可能已部分恢复，不应继续运行
+     */
+    inline bool restore(const std::string& blob, SharedStateSpace& state, SimulationClock& clock,
+                        EventMonitorThread& event_monitor, ControllerManagerThread& controller_manager,
+                        DataRecorderThread* recorder = nullptr) {
+        const auto begin = std::chrono::steady_clock::now();
+        CheckpointReader reader(blob);
+        if (reader.ok() && !clock.restoreCheckpoint(reader) && reader.ok()) {
+            log_detail("[检查点] 恢复失败：时钟运行中\n");
+            return false;
+        }
+        state.restoreCheckpoint(reader);
+        event_monitor.restoreCheckpoint(reader);
+        controller_manager.restoreCheckpoint(reader);
+        const bool has_recorder = reader.read<bool>();
+        if (has_recorder && recorder) {
+            recorder->restoreCheckpoint(reader);
+        }
+        if (!reader.ok()) {
+            log_detail("[检查点] 恢复失败：" + reader.error() + "\n");
+            return false;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+        log_detail("[检查点] 已恢复到 t=" + std::to_string(clock.getCurrentTime()) + "s（步数 " +
+                   std::to_string(clock.getStepCount()) + "，" + std::to_string(blob.size()) + " 字节，耗时 " +
+                   std::to_string(elapsed) + "us）\n");
+        return true;
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * @file state_access.hpp
+ * @brief 共享状态空间读写集声明
+ *
+ * 各仿真组件（力学模型、动力学模型、控制器、事件监控、数据记录等）用 StateAccess 声明
+ * 自己每步读取和写入 SharedStateSpace 的哪些字段。任务图调度器据此建立每步的依赖图：
+ * 两个组件的读写集有冲突（写-读、读-写、写-写）时按声明顺序执行，否则可以并行。
+ *
+ * 写入后缓冲（SharedStateSpace::next）的写入用 Next* 字段表示：写者"写"后缓冲字段，状态空间处理
+ * "读"后缓冲字段并提交到真正的状态字段。步内读者只读已提交的状态字段，因此写后缓冲的组件与
+ * 读同名状态字段的组件之间不构成冲突。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <cstdint>            // 位掩码类型
+#include <initializer_list>   // 字段列表
+
+// ParaSAFE系统头文件
+#include "state_fields.hpp"   // 字段注册表
+
+/**
+ * @brief 共享状态空间字段（按依赖分析所需的粒度划分）
+ */
+enum class StateField : uint32_t {
+    // 运动/控制字段：由 state_fields.hpp 的注册表生成，下标 0 ~ kStateFieldCount-1
+#define PARASAFE_STATE_FIELD_ENUM(Enum, ...) Enum,
+    PARASAFE_STATE_FIELDS(PARASAFE_STATE_FIELD_ENUM)
+#undef PARASAFE_STATE_FIELD_ENUM
+    ControlFlags,        ///< *_control_enabled、abort_triggered、飞行模式、控制权、控制器启停
+    NextKinematics,      ///< 后缓冲中的位置/速度/加速度/力/仿真时间（动力学写入）
+    NextThrottle,        ///< 后缓冲中的油门
+    NextBrake,           ///< 后缓冲中的刹车
+    NextPitchControl,    ///< 后缓冲中的俯仰角控制输出
+    RecorderOutput,      ///< 数据记录输出（文件）
+    Count
+};
+
+using StateFieldMask = uint64_t;
+
+/**
+ * @brief 单个字段的位掩码
+ */
+constexpr StateFieldMask stateFieldBit(StateField field) {
+    return StateFieldMask{1} << static_cast<uint32_t>(field);
+}
+
+static_assert(static_cast<size_t>(StateField::ControlFlags) == kStateFieldCount,
+              "StateField 的运动/控制字段须与注册表一一对应");
+
+/**
+ * @brief 多个字段的位掩码
+ */
+inline StateFieldMask stateFieldMask(std::initializer_list<StateField> fields) {
+    StateFieldMask mask = 0;
+    for (StateField field : fields) mask |= stateFieldBit(field);
+    return mask;
+}
+
+/**
+ * @brief 所有字段的位掩码
+ */
+constexpr StateFieldMask kAllStateFields = (StateFieldMask{1} << static_cast<uint32_t>(StateField::Count)) - 1;
+
+/**
+ * @struct StateAccess
+ * @brief 组件每步的读集和写集
+ */
+struct StateAccess {
+    StateFieldMask reads = 0;   ///< 读取的字段
+    StateFieldMask writes = 0;  ///< 写入的字段
+
+    /**
+     * @brief 未声明读写集的组件：读写所有字段，与任何组件都串行
+     */
+    static constexpr StateAccess all() { return StateAccess{kAllStateFields, kAllStateFields}; }
+
+    /**
+     * @brief 由字段列表构造
+     */
+    static StateAccess of(std::initializer_list<StateField> read_fields,
+                          std::initializer_list<StateField> write_fields) {
+        return StateAccess{stateFieldMask(read_fields), stateFieldMask(write_fields)};
+    }
+
+    /**
+     * @brief 合并两个读写集（如动力学模型 + 其调用的力学模型）
+     */
+    StateAccess operator|(const StateAccess& other) const {
+        return StateAccess{reads | other.reads, writes | other.writes};
+    }
+
+    /**
+     * @brief 两个组件是否冲突（写-读、读-写、写-写）
+     */
+    bool conflictsWith(const StateAccess& other) const {
+        return (writes & (other.reads | other.writes)) != 0 || (reads & other.writes) != 0;
+    }
+};
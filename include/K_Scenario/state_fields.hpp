@@ -0,0 +1,141 @@
+/*
+ * @file state_fields.hpp
+ * @brief 共享状态字段注册表（编译期生成）
+ *
+ * 每步推进的运动/控制字段只在 PARASAFE_STATE_FIELDS 中登记一次，以下内容都由它展开生成，
+ * 按整数下标访问，不再逐处手写字段列表：
+ *   - StateField 枚举的前 kStateFieldCount 项（state_access.hpp）
+ *   - StateSnapshot 的成员、SharedStateSpace 的前缓冲原子变量及 field()/captureSnapshot()/检查点
+ *   - StepStateBuffer 按写者分块的布局（每块独占缓存行）
+ *   - SharedStateSpace::printState() 的日志项
+ *   - FileLogger 的 CSV 表头与数据列
+ * 可由配置文件设置的控制开关同样只在 PARASAFE_CONTROL_FLAGS 中登记一次（applyStateSettings 按名称查找）。
+ *
+ * 新增字段只需在表中加一行；字段顺序即 StateField 下标顺序，也是检查点中的写入顺序。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <array>     // 字段信息表
+#include <cstddef>   // size_t
+#include <cstdint>   // 写者枚举
+
+/**
+ * @brief 运动/控制字段表
+ *
+ * X(枚举名, 成员名, 写者, CSV 列名（"" 表示不输出）, CSV 精度, 日志名（"" 表示不输出）, 单位, 日志显示倍数, 日志精度)
+ *
+ * 写者（StateOwner）是每步写入该字段后缓冲的组件，后缓冲按写者分块、各块独占缓存行（step_state_buffer.hpp）。
+ */
+#define PARASAFE_STATE_FIELDS(X)                                                                              \
+    X(Position,           position,             Dynamics,     "position",    2, "位置",   "m",     1.0,   2) \
+    X(Velocity,           velocity,             Dynamics,     "velocity",    2, "速度",   "m/s",   1.0,   2) \
+    X(Acceleration,       acceleration,         Dynamics,     "acc",         2, "加速度", "m/s²",  1.0,   2) \
+    X(Throttle,           throttle,             Throttle,     "throttle",    4, "油门",   "%",     100.0, 3) \
+    X(Brake,              brake,                Brake,        "brake",       2, "刹车",   "%",     100.0, 3) \
+    X(Thrust,             thrust,               Dynamics,     "thrust",      2, "推力",   "N",     1.0,   3) \
+    X(DragForce,          drag_force,           Dynamics,     "drag",        2, "阻力",   "N",     1.0,   3) \
+    X(BrakeForce,         brake_force,          Dynamics,     "brake_force", 2, "刹车力", "N",     1.0,   3) \
+    X(PitchAngle,         pitch_angle,          Dynamics,     "",            2, "",       "rad",   1.0,   3) \
+    X(PitchRate,          pitch_rate,           Dynamics,     "",            2, "",       "rad/s", 1.0,   3) \
+    X(Altitude,           altitude,             Dynamics,     "",            2, "",       "m",     1.0,   2) \
+    X(NormalVelocity,     normal_velocity,      Dynamics,     "",            2, "",       "m/s",   1.0,   3) \
+    X(PitchControlOutput, pitch_control_output, PitchControl, "",            2, "",       "",      1.0,   3) \
+    X(SimulationTime,     simulation_time,      Dynamics,     "",            2, "",       "s",     1.0,   2)
+
+/**
+ * @brief 后缓冲字段的写者（与 StateAccess 中的 Next* 字段一一对应）
+ */
+enum class StateOwner : uint32_t {
+    Dynamics = 0,   ///< 动力学模型：运动状态、力、仿真时间（NextKinematics）
+    Throttle,       ///< 油门控制器 / 虚拟飞行员（NextThrottle）
+    Brake,          ///< 刹车控制器 / 虚拟飞行员（NextBrake）
+    PitchControl,   ///< 俯仰角保持控制器（NextPitchControl）
+    Count
+};
+
+constexpr size_t kStateOwnerCount = static_cast<size_t>(StateOwner::Count);
+
+/**
+ * @brief 可由配置文件（state_settings）设置的控制开关表
+ *
+ * X(成员名)，配置中的变量名与成员名相同
+ */
+#define PARASAFE_CONTROL_FLAGS(X) \
+    X(throttle_control_enabled)   \
+    X(brake_control_enabled)      \
+    X(cruise_control_enabled)     \
+    X(pitch_control_enabled)
+
+#define PARASAFE_STATE_FIELD_COUNT_ONE(...) +1
+/// 运动/控制字段数
+constexpr size_t kStateFieldCount = 0 PARASAFE_STATE_FIELDS(PARASAFE_STATE_FIELD_COUNT_ONE);
+#undef PARASAFE_STATE_FIELD_COUNT_ONE
+
+/**
+ * @struct StateFieldInfo
+ * @brief 单个字段的输出信息
+ */
+struct StateFieldInfo {
+    const char* name;          ///< 成员名
+    StateOwner owner;          ///< 写者
+    const char* csv_column;    ///< CSV 列名，"" 表示不输出
+    int csv_precision;         ///< CSV 小数位数
+    const char* label;         ///< 日志名，"" 表示不输出
+    const char* unit;          ///< 单位
+    double display_scale;      ///< 日志显示倍数（如油门、刹车显示为百分比）
+    int display_precision;     ///< 日志小数位数
+
+    constexpr bool inCsv() const { return csv_column[0] != '\0'; }
+    constexpr bool inLog() const { return label[0] != '\0'; }
+};
+
+/// 按 StateField 下标排列的字段信息
+constexpr std::array<StateFieldInfo, kStateFieldCount> kStateFieldInfo = {{
+#define PARASAFE_STATE_FIELD_INFO(Enum, member, owner, column, csv_precision, label, unit, scale, precision) \
+    StateFieldInfo{#member, StateOwner::owner, column, csv_precision, label, unit, scale, precision},
+    PARASAFE_STATE_FIELDS(PARASAFE_STATE_FIELD_INFO)
+#undef PARASAFE_STATE_FIELD_INFO
+}};
+
+/**
+ * @brief 字段在其写者块内的下标
+ */
+constexpr size_t stateFieldSlot(size_t field) {
+    size_t slot = 0;
+    for (size_t i = 0; i < field; ++i) {
+        if (kStateFieldInfo[i].owner == kStateFieldInfo[field].owner) ++slot;
+    }
+    return slot;
+}
+
+/// 按 StateField 下标排列的写者块内下标
+constexpr std::array<size_t, kStateFieldCount> kStateFieldSlots = [] {
+    std::array<size_t, kStateFieldCount> slots{};
+    for (size_t i = 0; i < kStateFieldCount; ++i) slots[i] = stateFieldSlot(i);
+    return slots;
+}();
+
+/**
+ * @brief 写者块中的字段数
+ */
+constexpr size_t stateOwnerFieldCount(StateOwner owner) {
+    size_t count = 0;
+    for (const StateFieldInfo& info : kStateFieldInfo) {
+        if (info.owner == owner) ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief 最大的写者块字段数（各块按此分配）
+ */
+constexpr size_t maxStateOwnerFieldCount() {
+    size_t max_count = 0;
+    for (size_t o = 0; o < kStateOwnerCount; ++o) {
+        const size_t count = stateOwnerFieldCount(static_cast<StateOwner>(o));
+        if (count > max_count) max_count = count;
+    }
+    return max_count;
+}
@@ -0,0 +1,347 @@
+/*
+ * @file state_history.hpp
+ * @brief 状态历史环形缓冲头文件
+ *
+ * StateHistory 保存最近 N 秒每步提交的快照，按字段分列存放（结构数组，每个字段一段连续的 double），
+ * 容量在 configure() 时一次分配，之后每步记录不分配内存。事件条件、分析代码通过 SharedStateSpace::history
+ * 直接查询历史，不必各自保存：
+ *   - valueAgo(field, Δ)：Δ 秒之前的值，O(1)
+ *   - mean(field, W)：最近 W 秒的均值，O(1)（逐步累加的前缀和）
+ *   - windowMin / windowMax：预先登记的字段与窗口上的最小/最大值，O(1)（单调队列，每步均摊 O(1) 维护）
+ *   - minOver / maxOver(field, W)：任意窗口的最小/最大值，O(W/dt) 顺序扫描
+ *   - timeSinceTrue(条件)：预先登记的条件持续成立的时间，O(1)（如"速度连续 2 秒下降"）
+ *
+ * 记录发生在发布快照时（SharedStateSpace::updateState，即步屏障 / 状态提交阶段），此时没有步内读者；
+ * 查询只应在仿真步内（事件检测、控制器、记录器）或仿真结束后进行。
+ *
+ * 典型用法：
+ *   state.history.configure(5.0, clock.getTimeStep());   // 保留 5 秒，须在仿真开始前调用
+ *   auto decel = state.history.watch([](const StateHistory& h) {
+ *       return h.size() > 1 && h.valueAgo(StateField::Velocity, h.timeStep()) > h.latest(StateField::Velocity);
+ *   });
+ *   event.trigger_condition = [decel](const SharedStateSpace& s) { return s.history.timeSinceTrue(decel) >= 2.0; };
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <algorithm>    // 最小/最大值
+#include <array>        // 按字段分列
+#include <cmath>        // 窗口换算
+#include <cstddef>      // size_t
+#include <cstdint>      // 检查点计数
+#include <functional>   // 条件
+#include <limits>       // 无数据时的返回值
+#include <vector>       // 预分配存储
+
+// ParaSAFE系统头文件
+#include "state_fields.hpp"                          // 字段注册表
+#include "state_access.hpp"                          // 字段枚举
+#include "../L_Simulation_Settings/checkpoint.hpp"   // 检查点读写
+#include "../L_Simulation_Settings/logger.hpp"       // 日志输出
+
+/**
+ * @class StateHistory
+ * @brief 最近 N 秒状态快照的结构数组环形缓冲
+ */
+class StateHistory {
+public:
+    using Condition = std::function<bool(const StateHistory&)>;
+
+    /**
+     * @brief 分配容量并清空历史（须在仿真开始前调用，未调用时不记录）
+     * @param window_seconds 保留的时长（秒）
+     * @param time_step 仿真步长（秒），相邻两条记录的时间间隔
+     */
+    void configure(double window_seconds, double time_step) {
+        time_step_ = time_step > 0.0 ? time_step : 0.01;
+        capacity_ = static_cast<size_t>(std::ceil(window_seconds / time_step_ - 1e-9)) + 1;
+        // 多留一格保存窗口起点之前的前缀和
+        for (auto& column : columns_) column.assign(capacity_ + 1, 0.0);
+        for (auto& column : prefix_sums_) column.assign(capacity_ + 1, 0.0);
+        times_.assign(capacity_ + 1, 0.0);
+        for (auto& extrema : extrema_) {
+            extrema.min_queue.assign(capacity_ + 1, 0);
+            extrema.max_queue.assign(capacity_ + 1, 0);
+        }
+        clear();
+    }
+
+    /**
+     * @brief 登记一个需要 O(1) 查询最小/最大值的字段与窗口（须在 configure() 之后、仿真开始前调用）
+     * @return 句柄，用于 windowMin / windowMax
+     */
+    size_t watchExtrema(StateField field, double window_seconds) {
+        Extrema extrema;
+        extrema.field = static_cast<size_t>(field);
+        extrema.samples = samplesIn(window_seconds);
+        extrema.min_queue.assign(capacity_ + 1, 0);
+        extrema.max_queue.assign(capacity_ + 1, 0);
+        extrema_.push_back(std::move(extrema));
+        return extrema_.size() - 1;
+    }
+
+    /**
+     * @brief 登记一个条件，每步记录后求值一次，用 timeSinceTrue 查询其持续成立的时间
+     * @return 句柄
+     */
+    size_t watch(Condition condition) {
+        watches_.push_back(Watch{std::move(condition), false, 0.0});
+        return watches_.size() - 1;
+    }
+
+    /**
+     * @brief 丢弃全部历史（保留容量与登记项）
+     */
+    void clear() {
+        count_ = 0;
+        head_ = 0;
+        for (auto& extrema : extrema_) {
+            extrema.min_begin = extrema.min_end = 0;
+            extrema.max_begin = extrema.max_end = 0;
+        }
+        for (auto& w : watches_) w.active = false;
+    }
+
+    /**
+     * @brief 记录一步提交的快照（由 SharedStateSpace 发布快照时调用）
+     */
+    template <typename Snapshot, typename Members>
+    void push(double time, const Snapshot& snapshot, const Members& members) {
+        if (capacity_ == 0) return;
+        const size_t previous = head_;
+        head_ = count_ == 0 ? 0 : next(head_);
+        ++count_;
+        times_[head_] = time;
+        for (size_t f = 0; f < kStateFieldCount; ++f) {
+            const double value = snapshot.*members[f];
+            columns_[f][head_] = value;
+            prefix_sums_[f][head_] = (count_ == 1 ? 0.0 : prefix_sums_[f][previous]) + value;
+        }
+        for (auto& extrema : extrema_) updateExtrema(extrema);
+        for (auto& w : watches_) {
+            const bool now = w.condition(*this);
+            if (now && !w.active) w.since = time;
+            w.active = now;
+        }
+    }
+
+    bool enabled() const { return capacity_ > 0; }
+    double timeStep() const { return time_step_; }
+
+    /**
+     * @brief 已保存的记录数（不超过容量）
+     */
+    size_t size() const { return std::min(count_, capacity_); }
+
+    /**
+     * @brief 最新一条记录的仿真时间
+     */
+    double latestTime() const { return count_ ? times_[head_] : 0.0; }
+
+    /**
+     * @brief 字段的最新值
+     */
+    double latest(StateField field) const { return count_ ? columns_[index(field)][head_] : 0.0; }
+
+    /**
+     * @brief 字段在 delta 秒之前的值，超出保存范围时返回最早的一条
+     */
+    double valueAgo(StateField field, double delta) const {
+        if (count_ == 0) return 0.0;
+        const size_t back = std::min(stepsIn(delta), size() - 1);
+        return columns_[index(field)][ago(back)];
+    }
+
+    /**
+     * @brief 最近 window 秒（含端点的各步记录）的均值
+     */
+    double mean(StateField field, double window) const {
+        if (count_ == 0) return 0.0;
+        const size_t n = std::min(samplesIn(window), size());
+        const auto& sums = prefix_sums_[index(field)];
+        // 窗口起点之前的前缀和：窗口覆盖全部历史时为 0（历史刚开始）或已被覆盖的前一格
+        const double before = n < count_ ? sums[ago(n)] : 0.0;
+        return (sums[head_] - before) / static_cast<double>(n);
+    }
+
+    /**
+     * @brief 已登记窗口上的最小值，无记录时为 +inf
+     */
+    double windowMin(size_t handle) const {
+        const Extrema& e = extrema_[handle];
+        return e.min_begin == e.min_end ? std::numeric_limits<double>::infinity()
+                                        : columns_[e.field][e.min_queue[e.min_begin % (capacity_ + 1)]];
+    }
+
+    /**
+     * @brief 已登记窗口上的最大值，无记录时为 -inf
+     */
+    double windowMax(size_t handle) const {
+        const Extrema& e = extrema_[handle];
+        return e.max_begin == e.max_end ? -std::numeric_limits<double>::infinity()
+                                        : columns_[e.field][e.max_queue[e.max_begin % (capacity_ + 1)]];
+    }
+
+    /**
+     * @brief 任意窗口上的最小值（顺序扫描），无记录时为 +inf
+     */
+    double minOver(StateField field, double window) const {
+        double result = std::numeric_limits<double>::infinity();
+        const size_t n = std::min(samplesIn(window), size());
+        for (size_t i = 0; i < n; ++i) result = std::min(result, columns_[index(field)][ago(i)]);
+        return result;
+    }
+
+    /**
+     * @brief 任意窗口上的最大值（顺序扫描），无记录时为 -inf
+     */
+    double maxOver(StateField field, double window) const {
+        double result = -std::numeric_limits<double>::infinity();
+        const size_t n = std::min(samplesIn(window), size());
+        for (size_t i = 0; i < n; ++i) result = std::max(result, columns_[index(field)][ago(i)]);
+        return result;
+    }
+
+    /**
+     * @brief 已登记条件自最近一次变为成立以来的时间（秒），当前不成立时为 -1
+     */
+    double timeSinceTrue(size_t handle) const {
+        const Watch& w = watches_[handle];
+        return w.active ? latestTime() - w.since : -1.0;
+    }
+
+    /**
+     * @brief 写入检查点：全部历史记录与条件状态（登记项本身由代码重新登记）
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.beginSection("HIST");
+        writer.write(static_cast<uint64_t>(count_));
+        writer.write(static_cast<uint64_t>(head_));
+        writer.write(static_cast<uint64_t>(slots()));
+        for (size_t i = 0; i < slots(); ++i) writer.write(times_[i]);
+        for (size_t f = 0; f < kStateFieldCount; ++f) {
+            for (size_t i = 0; i < slots(); ++i) writer.write(columns_[f][i]);
+            for (size_t i = 0; i < slots(); ++i) writer.write(prefix_sums_[f][i]);
+        }
+        writer.write(static_cast<uint64_t>(extrema_.size()));
+        for (const auto& e : extrema_) {
+            writer.write(static_cast<uint64_t>(e.min_begin)); writer.write(static_cast<uint64_t>(e.min_end));
+            writer.write(static_cast<uint64_t>(e.max_begin)); writer.write(static_cast<uint64_t>(e.max_end));
+            for (size_t i = 0; i < slots(); ++i) writer.write(static_cast<uint64_t>(e.min_queue[i]));
+            for (size_t i = 0; i < slots(); ++i) writer.write(static_cast<uint64_t>(e.max_queue[i]));
+        }
+        writer.write(static_cast<uint64_t>(watches_.size()));
+        for (const auto& w : watches_) {
+            writer.write(w.active);
+            writer.write(w.since);
+        }
+    }
+
+    /**
+     * @brief 从检查点恢复（须已按保存时相同的时长 configure() 并登记相同的窗口与条件，否则读过该段并清空历史）
+     */
+    void restoreCheckpoint(CheckpointReader& reader) {
+        if (!reader.expectSection("HIST")) return;
+        const size_t count = static_cast<size_t>(reader.read<uint64_t>());
+        const size_t head = static_cast<size_t>(reader.read<uint64_t>());
+        const size_t saved_slots = static_cast<size_t>(reader.read<uint64_t>());
+        const bool same_layout = saved_slots == slots();
+        std::vector<double> discard(same_layout ? 0 : saved_slots);
+        const auto readColumn = [&](std::vector<double>& column) {
+            for (size_t i = 0; i < saved_slots; ++i) reader.read(same_layout ? column[i] : discard[i]);
+        };
+        readColumn(times_);
+        for (size_t f = 0; f < kStateFieldCount; ++f) {
+            readColumn(columns_[f]);
+            readColumn(prefix_sums_[f]);
+        }
+
+        const size_t extrema_count = static_cast<size_t>(reader.read<uint64_t>());
+        const bool same_extrema = same_layout && extrema_count == extrema_.size();
+        Extrema scratch;
+        scratch.min_queue.resize(saved_slots);
+        scratch.max_queue.resize(saved_slots);
+        for (size_t k = 0; k < extrema_count; ++k) {
+            Extrema& e = same_extrema ? extrema_[k] : scratch;
+            e.min_begin = static_cast<size_t>(reader.read<uint64_t>());
+            e.min_end = static_cast<size_t>(reader.read<uint64_t>());
+            e.max_begin = static_cast<size_t>(reader.read<uint64_t>());
+            e.max_end = static_cast<size_t>(reader.read<uint64_t>());
+            for (size_t i = 0; i < saved_slots; ++i) e.min_queue[i] = static_cast<size_t>(reader.read<uint64_t>());
+            for (size_t i = 0; i < saved_slots; ++i) e.max_queue[i] = static_cast<size_t>(reader.read<uint64_t>());
+        }
+
+        const size_t watch_count = static_cast<size_t>(reader.read<uint64_t>());
+        const bool same_watches = same_extrema && watch_count == watches_.size();
+        for (size_t k = 0; k < watch_count; ++k) {
+            Watch scratch_watch{};
+            Watch& w = same_watches ? watches_[k] : scratch_watch;
+            reader.read(w.active);
+            reader.read(w.since);
+        }
+
+        if (same_watches) {
+            count_ = count;
+            head_ = head;
+        } else {
+            clear();
+            if (reader.ok()) log_detail("[StateHistory] 警告：检查点中的历史配置与当前不同，历史已清空\n");
+        }
+    }
+
+private:
+    // 单调队列：保存槽位下标，队首为窗口内的最小（最大）值；队列本身也是容量 capacity_+1 的环
+    struct Extrema {
+        size_t field = 0;
+        size_t samples = 1;
+        std::vector<size_t> min_queue;
+        std::vector<size_t> max_queue;
+        size_t min_begin = 0, min_end = 0;
+        size_t max_begin = 0, max_end = 0;
+    };
+
+    struct Watch {
+        Condition condition;
+        bool active;     ///< 上一次求值是否成立
+        double since;    ///< 最近一次变为成立的时间
+    };
+
+    static size_t index(StateField field) { return static_cast<size_t>(field); }
+    // 槽位数：容量多一格，未配置时为 0
+    size_t slots() const { return times_.size(); }
+    size_t next(size_t slot) const { return slot + 1 == slots() ? 0 : slot + 1; }
+    // 最新记录之前第 back 条记录所在的槽位
+    size_t ago(size_t back) const { return (head_ + slots() - back % slots()) % slots(); }
+    // delta 秒对应的步数
+    size_t stepsIn(double delta) const {
+        return delta <= 0.0 ? 0 : static_cast<size_t>(std::floor(delta / time_step_ + 1e-6));
+    }
+    // window 秒内（含两端）的记录条数
+    size_t samplesIn(double window) const { return std::min(stepsIn(window) + 1, capacity_ > 0 ? capacity_ : 1); }
+
+    void updateExtrema(Extrema& e) {
+        const size_t ring = slots();
+        const auto& column = columns_[e.field];
+        const double value = column[head_];
+        // 弹出已滑出窗口的队首：队首槽位距最新记录不少于 samples 条时过期
+        const auto expired = [&](size_t slot) { return (head_ + ring - slot) % ring >= e.samples; };
+        while (e.min_begin != e.min_end && expired(e.min_queue[e.min_begin % ring])) ++e.min_begin;
+        while (e.max_begin != e.max_end && expired(e.max_queue[e.max_begin % ring])) ++e.max_begin;
+        // 从队尾弹出不再可能成为最值的记录
+        while (e.min_begin != e.min_end && column[e.min_queue[(e.min_end - 1) % ring]] >= value) --e.min_end;
+        while (e.max_begin != e.max_end && column[e.max_queue[(e.max_end - 1) % ring]] <= value) --e.max_end;
+        e.min_queue[e.min_end++ % ring] = head_;
+        e.max_queue[e.max_end++ % ring] = head_;
+    }
+
+    std::array<std::vector<double>, kStateFieldCount> columns_;       ///< 每个字段一列
+    std::array<std::vector<double>, kStateFieldCount> prefix_sums_;   ///< 每个字段的前缀和
+    std::vector<double> times_;                                       ///< 每条记录的仿真时间
+    std::vector<Extrema> extrema_;
+    std::vector<Watch> watches_;
+    double time_step_ = 0.01;
+    size_t capacity_ = 0;   ///< 保存的记录条数上限
+    size_t count_ = 0;      ///< 累计记录条数
+    size_t head_ = 0;       ///< 最新记录的槽位
+};
@@ -0,0 +1,134 @@
+/*
+ * @file step_state_buffer.hpp
+ * @brief 步状态后缓冲头文件
+ *
+ * 共享状态空间采用前/后双缓冲：SharedStateSpace 中的状态字段是前缓冲，保存已提交的第 k 步状态，
+ * 本步内所有组件（动力学、事件检测、控制器、数据记录）都只读前缓冲；动力学和控制器把第 k+1 步的值
+ * 写入后缓冲（StepStateBuffer），步屏障处由 SharedStateSpace::commitStep() 一次提交到前缓冲。
+ * 因此同一步内各组件读到的状态与执行顺序、线程调度无关。
+ *
+ * 后缓冲按 StateField 下标保存各运动/控制字段（state_fields.hpp 注册表中的全部字段），并用位掩码记录本步写过
+ * 哪些字段；提交时只复制写过的字段，本步没有写者的字段保持不变（包括步外直接写入前缓冲的初始化、
+ * 参数覆盖等）。每个字段每步只应有一个写者，多个写者写同一字段时以最后一次写入为准。
+ *
+ * 写入与提交之间由时钟屏障（或单线程执行器的阶段顺序）保证先后，写入本身无锁、不分配内存。
+ * 各写者的字段分块存放、各占独立的缓存行，并发写入不会互相伪共享。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <array>     // 字段值
+#include <atomic>    // 无锁写入
+#include <cstddef>   // size_t
+#include <cstdint>   // 写入掩码
+
+// ParaSAFE系统头文件
+#include "state_access.hpp"                          // 字段枚举
+#include "../L_Simulation_Settings/checkpoint.hpp"   // 检查点读写
+
+/**
+ * @class StepStateBuffer
+ * @brief 下一步状态的后缓冲
+ *
+ * 按写者（StateOwner）分块：每块含该写者的字段值和写入掩码，alignas(64) 独占缓存行。
+ * 线程模式下动力学、油门、刹车、俯仰控制器并发写入各自的块，写入互不失效对方的缓存行；
+ * 提交方在步屏障处逐块读取。
+ */
+class StepStateBuffer {
+public:
+    /// 双缓冲的字段：注册表中的全部运动/控制字段（均为 double）
+    static constexpr size_t kFieldCount = kStateFieldCount;
+    static_assert(kFieldCount <= 32, "写入掩码为 32 位");
+
+    /**
+     * @brief 字段是否经后缓冲提交
+     */
+    static constexpr bool isBuffered(StateField field) {
+        return static_cast<size_t>(field) < kFieldCount;
+    }
+
+    /**
+     * @brief 写入字段在下一步的值（本步内由该字段的写者线程调用）
+     */
+    void write(StateField field, double value) {
+        const size_t index = static_cast<size_t>(field);
+        OwnerBlock& block = blockOf(index);
+        block.values[kStateFieldSlots[index]].store(value, std::memory_order_relaxed);
+        block.written.fetch_or(uint32_t{1} << index, std::memory_order_release);
+    }
+
+    /**
+     * @brief 本步是否写过该字段
+     */
+    bool isWritten(StateField field) const {
+        const size_t index = static_cast<size_t>(field);
+        return (blockOf(index).written.load(std::memory_order_acquire) & (uint32_t{1} << index)) != 0;
+    }
+
+    /**
+     * @brief 字段在后缓冲中的值（仅在 isWritten() 时有意义）
+     */
+    double value(StateField field) const {
+        const size_t index = static_cast<size_t>(field);
+        return blockOf(index).values[kStateFieldSlots[index]].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 取出本步写过的字段掩码并清空（提交方调用）
+     */
+    uint32_t take() {
+        uint32_t written = 0;
+        for (OwnerBlock& block : blocks_) written |= block.written.exchange(0, std::memory_order_acq_rel);
+        return written;
+    }
+
+    /**
+     * @brief 丢弃本步尚未提交的写入
+     */
+    void clear() {
+        for (OwnerBlock& block : blocks_) block.written.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief 写入检查点：尚未提交的字段（控制器在本步写入、下一步才生效的值）
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.beginSection("NEXT");
+        uint32_t written = 0;
+        for (const OwnerBlock& block : blocks_) written |= block.written.load(std::memory_order_acquire);
+        writer.write(written);
+        for (size_t i = 0; i < kFieldCount; ++i) {
+            if (written & (uint32_t{1} << i)) writer.write(blockOf(i).values[kStateFieldSlots[i]]);
+        }
+    }
+
+    /**
+     * @brief 从检查点恢复：替换全部未提交的写入
+     */
+    void restoreCheckpoint(CheckpointReader& reader) {
+        if (!reader.expectSection("NEXT")) return;
+        const uint32_t written = reader.read<uint32_t>();
+        uint32_t block_written[kStateOwnerCount] = {};
+        for (size_t i = 0; i < kFieldCount; ++i) {
+            if (!(written & (uint32_t{1} << i))) continue;
+            reader.read(blockOf(i).values[kStateFieldSlots[i]]);
+            block_written[static_cast<size_t>(kStateFieldInfo[i].owner)] |= uint32_t{1} << i;
+        }
+        for (size_t o = 0; o < kStateOwnerCount; ++o) {
+            blocks_[o].written.store(reader.ok() ? block_written[o] : 0, std::memory_order_release);
+        }
+    }
+
+private:
+    // 一个写者的字段：掩码与值放在同一块，写者每步只触及自己的缓存行
+    struct alignas(64) OwnerBlock {
+        std::atomic<uint32_t> written{0};
+        std::array<std::atomic<double>, maxStateOwnerFieldCount()> values{};
+    };
+
+    OwnerBlock& blockOf(size_t index) { return blocks_[static_cast<size_t>(kStateFieldInfo[index].owner)]; }
+    const OwnerBlock& blockOf(size_t index) const { return blocks_[static_cast<size_t>(kStateFieldInfo[index].owner)]; }
+
+    std::array<OwnerBlock, kStateOwnerCount> blocks_{};
+};
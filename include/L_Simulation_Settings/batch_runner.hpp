@@ -0,0 +1,145 @@
+/*
+ * @file batch_runner.hpp
+ * @brief 批量仿真运行器头文件
+ *
+ * 在一个固定大小的线程池上并发运行多个独立仿真。每个仿真使用自己的 SimulationContext
+ * 和 FusedStepExecutor（单线程执行），因此池中每个工作线程同一时刻只运行一个仿真，
+ * 线程数默认等于硬件线程数，不随仿真数量增长。
+ *
+ * 典型用法：
+ *   BatchRunner runner;                          // 默认 hardware_concurrency 个工作线程
+ *   for (double v : abort_speeds) {
+ *       runner.submit([v]() { runOneSimulation(v); });
+ *   }
+ *   runner.wait();                               // 等待所有已提交的仿真结束
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <thread>               // 工作线程
+#include <vector>               // 线程表
+#include <deque>                // 任务队列
+#include <functional>           // 任务类型
+#include <mutex>                // 互斥锁
+#include <condition_variable>   // 条件变量
+#include <exception>            // 任务异常
+#include <string>               // 线程名称
+
+// ParaSAFE系统头文件
+#include "thread_name_util.hpp" // 线程命名工具
+#include "logger.hpp"           // 日志系统
+
+/**
+ * @class BatchRunner
+ * @brief 固定线程数的批量仿真运行器
+ *
+ * 任务按提交顺序取出执行；任务内抛出的异常被记录并计数，不影响其他仿真。
+ */
+class BatchRunner {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief 构造并启动工作线程
+     * @param thread_count 工作线程数，0 表示使用硬件线程数
+     */
+    explicit BatchRunner(size_t thread_count = 0) {
+        if (thread_count == 0) thread_count = std::thread::hardware_concurrency();
+        if (thread_count == 0) thread_count = 1;
+        workers_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            workers_.emplace_back(&BatchRunner::workerLoop, this, i);
+        }
+        log_detail("[批量运行器] 已启动 " + std::to_string(thread_count) + " 个工作线程\n");
+    }
+
+    ~BatchRunner() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            shutdown_ = true;
+        }
+        cv_task_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+    BatchRunner(const BatchRunner&) = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+
+    /**
+     * @brief 提交一个仿真任务
+     */
+    void submit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            tasks_.push_back(std::move(task));
+            pending_++;
+        }
+        cv_task_.notify_one();
+    }
+
+    /**
+     * @brief 等待所有已提交的任务完成
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_done_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+    /**
+     * @brief 工作线程数
+     */
+    size_t getThreadCount() const { return workers_.size(); }
+
+    /**
+     * @brief 抛出异常的任务数
+     */
+    size_t getFailedCount() const {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return failed_;
+    }
+
+private:
+    void workerLoop(size_t index) {
+        ThreadNaming::set_current_thread_name("BatchWorker" + std::to_string(index));
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_task_.wait(lock, [this] { return shutdown_ || !tasks_.empty(); });
+                if (tasks_.empty()) return; // 仅在关闭且队列为空时退出
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+
+            bool failed = false;
+            try {
+                task();
+            } catch (const std::exception& e) {
+                failed = true;
+                log_detail(std::string("[批量运行器] 仿真任务异常: ") + e.what() + "\n");
+            } catch (...) {
+                failed = true;
+                log_detail("[批量运行器] 仿真任务发生未知异常\n");
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                if (failed) failed_++;
+                pending_--;
+                if (pending_ == 0) cv_done_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<Task> tasks_;
+    mutable std::mutex mtx_;
+    std::condition_variable cv_task_;
+    std::condition_variable cv_done_;
+    size_t pending_ = 0;    ///< 已提交但未完成的任务数
+    size_t failed_ = 0;     ///< 抛出异常的任务数
+    bool shutdown_ = false;
+};
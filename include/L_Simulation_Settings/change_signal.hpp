@@ -0,0 +1,115 @@
+/*
+ * @file change_signal.hpp
+ * @brief 变化通知：观察者等待某个条件成立，发布者每次发布后通知
+ *
+ * 用于实时显示、外部工具等观察者等待共享状态更新（见 SharedStateSpace::waitForVersion），替代
+ * "循环检查 + yield" 的忙等：观察者先短暂自旋（SpinWait::defaultSpinLimit），仍未满足时休眠，
+ * 空闲时不占用 CPU，发布后在内核唤醒延迟（微秒级）内醒来。
+ *
+ *   - 不限时等待：C++20 下在纪元字上 std::atomic::wait（futex / WaitOnAddress）
+ *   - 限时等待、以及 C++17 下的所有等待：条件变量 wait_until
+ *   - 发布者每次只做一次原子自增和一次原子读取，没有等待者时不加锁、不做系统调用
+ *   - cancel() 唤醒所有等待者并使之后的等待立即返回，直到 reset()
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <atomic>               // 纪元与等待者计数
+#include <chrono>               // 超时
+#include <condition_variable>   // 限时等待
+#include <cstdint>              // 纪元类型
+#include <mutex>                // 条件变量配套互斥锁
+
+// ParaSAFE系统头文件
+#include "spin_wait.hpp"        // 自旋让步、atomic::wait 封装
+
+/**
+ * @class ChangeSignal
+ * @brief 多观察者、单发布者的变化通知
+ */
+class ChangeSignal {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 发布一次变化（发布者在更新被观察的数据之后调用）
+     */
+    void notify() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) == 0) return;
+        wakeAll();
+    }
+
+    /**
+     * @brief 取消：唤醒所有等待者，之后的等待立即返回，直到 reset()
+     */
+    void cancel() {
+        cancelled_.store(true, std::memory_order_seq_cst);
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        wakeAll();
+    }
+
+    void reset() { cancelled_.store(false, std::memory_order_release); }
+
+    bool isCancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 等待 ready() 成立、超时或被取消
+     * @param ready 条件（在发布后重新检查，可能被多次调用）
+     * @param timeout 超时时间，duration::max() 表示不限时
+     * @return 返回时 ready() 是否成立
+     */
+    template <typename Ready, typename Rep, typename Period>
+    bool waitUntil(Ready ready, std::chrono::duration<Rep, Period> timeout) {
+        const int spin_limit = SpinWait::defaultSpinLimit();
+        for (int i = 0; i < spin_limit; ++i) {
+            if (ready()) return true;
+            if (isCancelled()) return false;
+            SpinWait::cpuRelax();
+        }
+
+        const bool unbounded = timeout == std::chrono::duration<Rep, Period>::max();
+        const Clock::time_point deadline = unbounded ? Clock::time_point::max()
+            : Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        bool satisfied = false;
+        while (true) {
+            const uint32_t seen = epoch_.load(std::memory_order_seq_cst);
+            if ((satisfied = ready()) || isCancelled()) break;
+#if defined(__cpp_lib_atomic_wait)
+            if (unbounded) {
+                epoch_.wait(seen, std::memory_order_seq_cst);
+                continue;
+            }
+#endif
+            std::unique_lock<std::mutex> lock(mutex_);
+            const auto changed = [this, seen] { return epoch_.load(std::memory_order_seq_cst) != seen; };
+            if (unbounded) {
+                cv_.wait(lock, changed);
+            } else if (!cv_.wait_until(lock, deadline, changed)) {
+                satisfied = ready();
+                break;
+            }
+        }
+        waiters_.fetch_sub(1, std::memory_order_seq_cst);
+        return satisfied;
+    }
+
+private:
+    void wakeAll() {
+#if defined(__cpp_lib_atomic_wait)
+        epoch_.notify_all();
+#endif
+        // 经过互斥锁再通知：等待者要么已在 wait 中，要么加锁后检查时已能看到新纪元
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        cv_.notify_all();
+    }
+
+    std::atomic<uint32_t> epoch_{0};      ///< 每次发布或取消加一
+    std::atomic<uint32_t> waiters_{0};    ///< 已进入休眠阶段的等待者数
+    std::atomic<bool> cancelled_{false};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
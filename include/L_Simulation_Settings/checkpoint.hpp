@@ -0,0 +1,182 @@
+/*
+ * @file checkpoint.hpp
+ * @brief 仿真检查点二进制读写头文件
+ *
+ * 检查点是一段紧凑的二进制数据（std::string 承载），由各组件依次写入自己的分段：
+ *
+ *     文件头（魔数 "PSCK" + 格式版本） | 分段标签 + 字段 | 分段标签 + 字段 | ...
+ *
+ * 字段按本机字节序原样写入（平凡可复制类型直接 memcpy，字符串为长度 + 字节），
+ * 检查点只用于同一构建的仿真程序之间保存和恢复，不作为跨平台交换格式。
+ * 每个分段以4字节标签开头，读取时逐段核对，组件增删字段后读取旧检查点会在对应分段报错。
+ *
+ * 任一分段的字段或顺序变化时递增格式版本（kVersion），旧版本的检查点在文件头即被拒绝：
+ *   1  初始格式
+ *   2  STAT 增加纵向状态（高度、法向速度）
+ *   3  STAT 按状态字段表（state_fields.hpp）的顺序写入
+ *   4  增加状态历史分段 HIST（StateHistory）
+ *
+ * 读取出错（数据截断、标签不符）时 CheckpointReader 进入失败状态，后续读取返回默认值，
+ * 调用方在最后检查 ok() 并通过 error() 取得原因。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <atomic>        // 原子字段读写
+#include <cstdint>       // 整数类型
+#include <cstring>       // memcpy
+#include <fstream>       // 检查点文件
+#include <iterator>      // istreambuf_iterator
+#include <string>        // 数据缓冲区
+#include <type_traits>   // is_trivially_copyable
+
+/**
+ * @class CheckpointWriter
+ * @brief 检查点写入器
+ */
+class CheckpointWriter {
+public:
+    static constexpr uint32_t kMagic = 0x4B435350;   ///< "PSCK"（小端）
+    static constexpr uint32_t kVersion = 4;          ///< 格式版本（变化记录见文件头）
+
+    CheckpointWriter() {
+        write(kMagic);
+        write(kVersion);
+    }
+
+    /**
+     * @brief 开始一个分段
+     * @param tag 4个字符的分段标签，如 "STAT"
+     */
+    void beginSection(const char (&tag)[5]) {
+        data_.append(tag, 4);
+    }
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "检查点字段必须是平凡可复制类型");
+        data_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void write(const std::atomic<T>& value) {
+        write(value.load(std::memory_order_acquire));
+    }
+
+    void writeString(const std::string& value) {
+        write(static_cast<uint32_t>(value.size()));
+        data_.append(value);
+    }
+
+    const std::string& data() const { return data_; }
+    std::string release() { return std::move(data_); }
+
+private:
+    std::string data_;
+};
+
+/**
+ * @class CheckpointReader
+ * @brief 检查点读取器
+ */
+class CheckpointReader {
+public:
+    explicit CheckpointReader(const std::string& data) : data_(data) {
+        if (read<uint32_t>() != CheckpointWriter::kMagic) {
+            fail("不是检查点数据（魔数不符）");
+        } else if (read<uint32_t>() != CheckpointWriter::kVersion) {
+            fail("检查点格式版本不符");
+        }
+    }
+
+    /**
+     * @brief 核对分段标签
+     * @return 标签相符返回 true
+     */
+    bool expectSection(const char (&tag)[5]) {
+        if (!ok_) return false;
+        if (offset_ + 4 > data_.size() || data_.compare(offset_, 4, tag, 4) != 0) {
+            fail(std::string("缺少分段 ") + tag);
+            return false;
+        }
+        offset_ += 4;
+        return true;
+    }
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable<T>::value, "检查点字段必须是平凡可复制类型");
+        T value{};
+        if (!ok_) return value;
+        if (offset_ + sizeof(T) > data_.size()) {
+            fail("检查点数据截断");
+            return value;
+        }
+        std::memcpy(&value, data_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return value;
+    }
+
+    template <typename T>
+    void read(T& target) {
+        target = read<T>();
+    }
+
+    template <typename T>
+    void read(std::atomic<T>& target) {
+        target.store(read<T>(), std::memory_order_release);
+    }
+
+    std::string readString() {
+        const uint32_t size = read<uint32_t>();
+        if (!ok_) return {};
+        if (offset_ + size > data_.size()) {
+            fail("检查点数据截断");
+            return {};
+        }
+        std::string value = data_.substr(offset_, size);
+        offset_ += size;
+        return value;
+    }
+
+    bool ok() const { return ok_; }
+    const std::string& error() const { return error_; }
+
+    /**
+     * @brief 标记读取失败（数据与当前仿真不相容时由各组件调用），之后的读取全部返回默认值
+     */
+    void fail(const std::string& reason) {
+        if (ok_) error_ = reason;
+        ok_ = false;
+    }
+
+private:
+
+    const std::string& data_;
+    size_t offset_ = 0;
+    bool ok_ = true;
+    std::string error_;
+};
+
+namespace Checkpoint {
+    /**
+     * @brief 把检查点写入文件
+     */
+    inline bool saveToFile(const std::string& data, const std::string& filename) {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief 从文件读取检查点，失败时返回 false
+     */
+    inline bool loadFromFile(const std::string& filename, std::string& data) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) return false;
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+}
@@ -0,0 +1,221 @@
+/*
+ * @file control_channel.hpp
+ * @brief 本地仿真控制通道（命名管道）头文件
+ *
+ * 替代键盘轮询：外部进程向命名管道写入一行命令控制仿真，无需控制台焦点，也可用于无界面批量运行。
+ * 读取线程阻塞在管道上，没有命令时不占用 CPU、没有轮询延迟。
+ *
+ * 平台实现：
+ *   - Linux：工作目录下的 FIFO（默认 simulation_control.fifo），例如
+ *       echo pause  > simulation_control.fifo
+ *       echo resume > simulation_control.fifo
+ *       echo stop   > simulation_control.fifo
+ *   - Windows：命名管道 \\.\pipe\ParaSAFE_control，例如
+ *       echo stop > \\.\pipe\ParaSAFE_control
+ *
+ * 命令按行分隔，首尾空白忽略，命令的含义由调用方的处理函数决定。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <atomic>       // 关闭标志
+#include <functional>   // 命令处理函数
+#include <string>       // 命令与路径
+#include <cerrno>       // errno
+#include <cstring>      // strerror
+
+// ParaSAFE系统头文件
+#include "logger.hpp"   // 日志系统
+
+// 平台头文件
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>      // open
+#include <poll.h>       // poll
+#include <sys/stat.h>   // mkfifo、stat
+#include <unistd.h>     // read、write、close、unlink、pipe
+#endif
+
+/**
+ * @class ControlChannel
+ * @brief 阻塞读取命名管道中按行写入的控制命令
+ */
+class ControlChannel {
+public:
+    using CommandHandler = std::function<void(const std::string&)>;
+
+    /**
+     * @brief 默认通道路径
+     */
+    static std::string defaultPath() {
+#if defined(_WIN32)
+        return "\\\\.\\pipe\\ParaSAFE_control";
+#else
+        return "simulation_control.fifo";
+#endif
+    }
+
+    explicit ControlChannel(std::string path = defaultPath()) : path_(std::move(path)) {}
+
+    ~ControlChannel() {
+        close();
+#if !defined(_WIN32)
+        if (fd_ >= 0) ::close(fd_);
+        if (wake_fds_[0] >= 0) ::close(wake_fds_[0]);
+        if (wake_fds_[1] >= 0) ::close(wake_fds_[1]);
+        if (created_) ::unlink(path_.c_str());
+#endif
+    }
+
+    ControlChannel(const ControlChannel&) = delete;
+    ControlChannel& operator=(const ControlChannel&) = delete;
+
+    /**
+     * @brief 设置通道路径（须在 open() 之前调用）
+     */
+    void setPath(const std::string& path) { path_ = path; }
+    const std::string& path() const { return path_; }
+
+    /**
+     * @brief 创建并打开通道
+     * @return 成功返回 true；失败时记录日志，仿真照常运行但不能接收外部命令
+     */
+    bool open() {
+        closing_.store(false, std::memory_order_release);
+#if defined(_WIN32)
+        return true; // 管道实例在 run() 中逐个连接创建
+#else
+        if (fd_ >= 0) return true;
+        if (::mkfifo(path_.c_str(), 0600) == 0) {
+            created_ = true;
+        } else if (errno != EEXIST) {
+            log_detail("[控制通道] 创建 FIFO 失败: " + path_ + " (" + std::strerror(errno) + ")\n");
+            return false;
+        }
+        struct stat st{};
+        if (::stat(path_.c_str(), &st) != 0 || !S_ISFIFO(st.st_mode)) {
+            log_detail("[控制通道] " + path_ + " 已存在且不是 FIFO\n");
+            return false;
+        }
+        // 以读写方式打开：自身持有一个写端，写入方关闭后 poll 不会持续返回 POLLHUP
+        fd_ = ::open(path_.c_str(), O_RDWR | O_NONBLOCK);
+        if (fd_ < 0) {
+            log_detail("[控制通道] 打开 FIFO 失败: " + path_ + " (" + std::strerror(errno) + ")\n");
+            return false;
+        }
+        if (::pipe(wake_fds_) != 0) {
+            log_detail("[控制通道] 创建唤醒管道失败\n");
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        return true;
+#endif
+    }
+
+    /**
+     * @brief 读取命令并调用处理函数，直到 close() 被调用（阻塞，在控制线程中运行）
+     */
+    void run(const CommandHandler& handler) {
+        serving_.store(true, std::memory_order_release);
+#if defined(_WIN32)
+        while (!closing_.load(std::memory_order_acquire)) {
+            HANDLE pipe = CreateNamedPipeA(path_.c_str(), PIPE_ACCESS_INBOUND, PIPE_TYPE_BYTE | PIPE_WAIT,
+                                           1, 0, 4096, 0, nullptr);
+            if (pipe == INVALID_HANDLE_VALUE) {
+                log_detail("[控制通道] 创建命名管道失败: " + path_ + "\n");
+                break;
+            }
+            const BOOL connected = ConnectNamedPipe(pipe, nullptr) ? TRUE : (GetLastError() == ERROR_PIPE_CONNECTED);
+            if (connected && !closing_.load(std::memory_order_acquire)) {
+                char chunk[256];
+                DWORD n = 0;
+                while (ReadFile(pipe, chunk, sizeof(chunk), &n, nullptr) && n > 0) {
+                    consume(chunk, n, handler);
+                }
+                flush(handler);
+            }
+            DisconnectNamedPipe(pipe);
+            CloseHandle(pipe);
+        }
+#else
+        if (fd_ < 0) {
+            serving_.store(false, std::memory_order_release);
+            return;
+        }
+        pollfd fds[2] = {{fd_, POLLIN, 0}, {wake_fds_[0], POLLIN, 0}};
+        while (!closing_.load(std::memory_order_acquire)) {
+            if (::poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) continue;
+                log_detail("[控制通道] poll 失败: " + std::string(std::strerror(errno)) + "\n");
+                break;
+            }
+            if (fds[1].revents) break;
+            if (fds[0].revents & POLLIN) {
+                char chunk[256];
+                ssize_t n;
+                while ((n = ::read(fd_, chunk, sizeof(chunk))) > 0) {
+                    consume(chunk, static_cast<size_t>(n), handler);
+                }
+            }
+        }
+#endif
+        serving_.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief 关闭通道，使 run() 返回（可从其他线程调用）
+     */
+    void close() {
+        if (closing_.exchange(true, std::memory_order_acq_rel)) return;
+#if defined(_WIN32)
+        // 自连一次管道，使阻塞在 ConnectNamedPipe / ReadFile 上的 run() 返回
+        for (int attempt = 0; attempt < 50 && serving_.load(std::memory_order_acquire); ++attempt) {
+            HANDLE client = CreateFileA(path_.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+            if (client != INVALID_HANDLE_VALUE) {
+                CloseHandle(client);
+                break;
+            }
+            WaitNamedPipeA(path_.c_str(), 20);
+        }
+#else
+        if (wake_fds_[1] >= 0) {
+            const char byte = 1;
+            (void)::write(wake_fds_[1], &byte, 1);
+        }
+#endif
+    }
+
+private:
+    // 按行切分读到的数据
+    void consume(const char* data, size_t size, const CommandHandler& handler) {
+        for (size_t i = 0; i < size; ++i) {
+            if (data[i] == '\n') {
+                flush(handler);
+            } else {
+                pending_.push_back(data[i]);
+            }
+        }
+    }
+
+    void flush(const CommandHandler& handler) {
+        std::string command;
+        command.swap(pending_);
+        const size_t first = command.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return;
+        command = command.substr(first, command.find_last_not_of(" \t\r") - first + 1);
+        if (handler) handler(command);
+    }
+
+    std::string path_;
+    std::string pending_;                  ///< 未以换行结束的部分命令
+    std::atomic<bool> closing_{false};
+    std::atomic<bool> serving_{false};
+#if !defined(_WIN32)
+    int fd_ = -1;
+    int wake_fds_[2] = {-1, -1};           ///< 唤醒 poll 的自管道
+    bool created_ = false;                 ///< FIFO 由本对象创建，析构时删除
+#endif
+};
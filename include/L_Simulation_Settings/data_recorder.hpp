@@ -6,6 +6,7 @@
 #include <vector>
 #include <mutex>
 #include "../K_Scenario/shared_state.hpp"
+#include "../K_Scenario/state_access.hpp"
 #include <stdexcept>
 #include <map>
 #include <chrono>
@@ -16,7 +17,9 @@
 #include <condition_variable>
 #include <functional>
 #include <any>
+#include <filesystem>
 #include "logger.hpp"
+#include "checkpoint.hpp"
 #include "thread_name_util.hpp"
 
 struct SimulationData {
@@ -30,32 +33,31 @@ struct SimulationData {
 class FileLogger {
 private:
     std::string filename_;
+    std::string data_path_; // 数据文件路径
     std::mutex mtx_;
     std::ofstream data_file_;
     double last_time_ = -1.0; // 上一次记录的时间戳
 
 public:
-    FileLogger(const std::string& filename)
-        : filename_(filename) {
+    FileLogger(const std::string& filename, const std::string& data_path = "output/data.csv")
+        : filename_(filename), data_path_(data_path) {
         // 先清空文件并写入表头
-        data_file_.open("output/data.csv", std::ios::out | std::ios::trunc);
+        data_file_.open(data_path_, std::ios::out | std::ios::trunc);
         if (data_file_.is_open()) {
-            data_file_ << std::left
-                       << std::setw(12) << "time"
-                       << std::setw(12) << "position"
-                       << std::setw(12) << "velocity"
-                       << std::setw(12) << "acc"
-                       << std::setw(12) << "throttle"
-                       << std::setw(12) << "brake"
-                       << std::setw(12) << "thrust"
-                       << std::setw(12) << "drag"
-                       << std::setw(12) << "brake_force"
-                       << std::endl;
+            // 表头：time 加注册表中输出到 CSV 的字段（state_fields.hpp）
+            std::string columns = "time";
+            data_file_ << std::left << std::setw(12) << "time";
+            for (const StateFieldInfo& info : kStateFieldInfo) {
+                if (!info.inCsv()) continue;
+                data_file_ << std::setw(12) << info.csv_column;
+                columns += std::string(", ") + info.csv_column;
+            }
+            data_file_ << std::endl;
             data_file_.flush();
             data_file_.close(); // 关闭文件，避免与后续数据输出冲突
-            log_detail("[FileLogger] CSV表头已写入: time, position, velocity, acc, throttle, brake, thrust, drag, brake_force\n");
+            log_detail("[FileLogger] CSV表头已写入: " + columns + "\n");
         } else {
-            log_detail("[FileLogger] 错误：无法打开output/data.csv文件\n");
+            log_detail("[FileLogger] 错误：无法打开" + data_path_ + "文件\n");
         }
     }
 
@@ -63,9 +65,40 @@ public:
         if (data_file_.is_open()) data_file_.close();
     }
 
-    void recordData(const std::map<std::string, double>& data) {
+    /**
+     * @brief 写入检查点：上一次记录的时间戳和数据文件当前长度
+     */
+    void saveCheckpoint(CheckpointWriter& writer) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        std::error_code ec;
+        uint64_t size = std::filesystem::file_size(data_path_, ec);
+        if (ec) size = 0;
+        writer.write(last_time_);
+        writer.write(size);
+    }
+
+    /**
+     * @brief 从检查点恢复：数据文件比检查点时长时截断到检查点位置，丢弃检查点之后写入的行
+     *
+     * 新建的 FileLogger（只有表头）从检查点恢复后，数据从检查点之后的第一行接着写入。
+     */
+    void restoreCheckpoint(CheckpointReader& reader) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        reader.read(last_time_);
+        const uint64_t size = reader.read<uint64_t>();
+        std::error_code ec;
+        const uint64_t current_size = std::filesystem::file_size(data_path_, ec);
+        if (!ec && size > 0 && current_size > size) {
+            std::filesystem::resize_file(data_path_, size, ec);
+            if (ec) log_detail("[FileLogger] 警告：截断" + data_path_ + "失败: " + ec.message() + "\n");
+        }
+    }
+
+    /**
+     * @brief 输出一行数据：time 列为记录时间点，其余列按注册表顺序取自快照
+     */
+    void recordData(double current_time, const StateSnapshot& s) {
         std::lock_guard<std::mutex> lock(mtx_);
-        double current_time = data.at("time");
 
         // 验证时间戳，必须严格递增
         if (current_time <= last_time_) {
@@ -77,26 +110,22 @@ public:
         last_time_ = current_time; // 更新时间戳
 
         // 重新打开文件，追加模式
-        data_file_.open("output/data.csv", std::ios::out | std::ios::app);
+        data_file_.open(data_path_, std::ios::out | std::ios::app);
         if (data_file_.is_open()) {
             data_file_ << std::left << std::fixed
-                       << std::setprecision(2) // 默认精度为2
-                       << std::setw(12) << current_time
-                       << std::setw(12) << data.at("position")
-                       << std::setw(12) << data.at("velocity")
-                       << std::setw(12) << data.at("acceleration")
-                       << std::setprecision(4) // throttle精度为3
-                       << std::setw(12) << data.at("throttle")
-                       << std::setprecision(2) // 恢复默认精度为2
-                       << std::setw(12) << data.at("brake")
-                       << std::setw(12) << data.at("thrust")
-                       << std::setw(12) << data.at("drag")
-                       << std::setw(12) << data.at("brake_force")
-                       << std::endl;
+                       << std::setprecision(2) // time 精度为2
+                       << std::setw(12) << current_time;
+            for (size_t i = 0; i < kStateFieldCount; ++i) {
+                const StateFieldInfo& info = kStateFieldInfo[i];
+                if (!info.inCsv()) continue;
+                data_file_ << std::setprecision(info.csv_precision)
+                           << std::setw(12) << snapshotValue(s, static_cast<StateField>(i));
+            }
+            data_file_ << std::endl;
             data_file_.flush();
             data_file_.close(); // 写入后立即关闭文件
         } else {
-            log_detail("[FileLogger] 错误：无法打开output/data.csv文件进行写入\n");
+            log_detail("[FileLogger] 错误：无法打开" + data_path_ + "文件进行写入\n");
         }
     }
 };
@@ -124,77 +153,145 @@ public:
     }
     bool isRunning() const { return running_.load(); }
 
-private:
-    void run() {
-        ThreadNaming::set_current_thread_name("DataRecorder");
-        clock_.registerThread();
-        size_t output_count = 0;
-        size_t current_step = 0; // 记录当前线程处理到的步数
+    /**
+     * @brief 设置记录周期（必须在 start() 之前调用）
+     * @param period 记录周期（秒），0 表示每个时间步记录一次（默认）
+     *
+     * 独立线程模式下按 SimulationClock::divisorForPeriod 换算为速率分频，记录线程只在调度步被唤醒。
+     */
+    void setRecordPeriod(double period) { record_period_ = period > 0.0 ? period : 0.0; }
+
+    /**
+     * @brief 记录周期对应的速率分频
+     */
+    int getRateDivisor() const { return clock_.divisorForPeriod(record_period_); }
+
+    /**
+     * @brief recordStep() 每步读写的共享状态字段
+     */
+    static StateAccess stateAccess() {
+        // 读取注册表中输出到 CSV 的字段和判断记录时间点用的仿真时间
+        StateFieldMask reads = stateFieldBit(StateField::SimulationTime);
+        for (size_t i = 0; i < kStateFieldCount; ++i) {
+            if (kStateFieldInfo[i].inCsv()) reads |= stateFieldBit(static_cast<StateField>(i));
+        }
+        return StateAccess{reads, stateFieldBit(StateField::RecorderOutput)};
+    }
 
+    /**
+     * @brief 输出初始状态（time=0.00）
+     *
+     * 独立线程模式下由 run() 在进入循环前调用，单线程执行器模式下由主程序在执行器启动前调用。
+     */
+    void recordInitialState() {
+        // 仿真开始前没有并发写者：以初始状态发布第一个快照，独立线程模式下各读者从第一步起即可读到有效快照
+        state_.publishSnapshot();
         // 先输出一次初始状态，time=0.00
         {
             double t = 0.0;
-            output_count++;
-            log_detail("[DataRecorder] 初始输出 步数=0 current_time=0.00 输出次数=" + std::to_string(output_count) + "\n");
-            std::map<std::string, double> data = {
-                {"time", t},
-                {"position", state_.position.load()},
-                {"velocity", state_.velocity.load()},
-                {"acceleration", state_.acceleration.load()},
-                {"throttle", state_.throttle.load()},
-                {"brake", state_.brake.load()},
-                {"thrust", state_.thrust.load()},
-                {"drag", state_.drag_force.load()},
-                {"brake_force", state_.brake_force.load()}
-            };
-            logger_.recordData(data);
-            log_detail("[DataRecorder] 初始输出完成 步数=0 current_time=0.00 输出次数=" + std::to_string(output_count) + "\n");
+            output_count_++;
+            log_detail("[DataRecorder] 初始输出 步数=0 current_time=0.00 输出次数=" + std::to_string(output_count_) + "\n");
+            record(t, state_.getState());
+            log_detail("[DataRecorder] 初始输出完成 步数=0 current_time=0.00 输出次数=" + std::to_string(output_count_) + "\n");
         }
 
-        // 从0.01秒开始，按时间步长递增记录数据
-        double next_time = 0.01; // 下一个要记录的时间点
-        
+        // 从第一个记录周期开始，按记录周期递增记录数据
+        next_time_ = recordInterval(); // 下一个要记录的时间点
+    }
+
+    /**
+     * @brief 记录一个仿真步的数据（执行器模式）
+     *
+     * 已提交状态的仿真时间到达下一个记录时间点时输出一行数据。融合执行器 / 任务图执行器中记录阶段
+     * 排在状态提交之后，读到的是本步刚提交的快照。
+     */
+    void recordStep() {
+        recordSnapshot(state_.getState());
+    }
+
+    /**
+     * @brief 写入检查点：已输出行数、下一个记录时间点、数据文件位置
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.beginSection("RECD");
+        writer.write(static_cast<uint64_t>(output_count_));
+        writer.write(next_time_);
+        logger_.saveCheckpoint(writer);
+    }
+
+    /**
+     * @brief 从检查点恢复，之后 recordStep() 从检查点之后的下一个记录时间点继续输出
+     */
+    void restoreCheckpoint(CheckpointReader& reader) {
+        if (!reader.expectSection("RECD")) return;
+        output_count_ = static_cast<size_t>(reader.read<uint64_t>());
+        reader.read(next_time_);
+        logger_.restoreCheckpoint(reader);
+    }
+
+private:
+    void run() {
+        ThreadNaming::set_current_thread_name("DataRecorder");
+        const int rate_divisor = getRateDivisor();
+
+        // 在注册到时钟之前输出初始状态：注册完成前时钟不会发布第一步，步屏障尚未开始提交和发布快照
+        recordInitialState();
+
+        clock_.registerThread(rate_divisor);
+        size_t current_step = 0; // 记录当前线程处理到的步数
+
         while (running_ && clock_.isRunning()) {
-            clock_.waitForNextStep(current_step);
+            clock_.waitForNextStep(current_step, rate_divisor);
             current_step = clock_.getStepCount(); // 更新为最新的时钟步数
 
-            double current_clock_time = clock_.getCurrentTime();
-            
-            // 如果时钟时间已经超过了下一个要记录的时间点，就记录数据
-            if (current_clock_time >= next_time) {
-                output_count++;
-                log_detail("[DataRecorder] 线程(" + ThreadNaming::get_current_thread_name() + ") " +
-                                  "步数=" + std::to_string(clock_.getStepCount()) +
-                                  " current_time=" + std::to_string(next_time) +
-                                  " 输出次数=" + std::to_string(output_count) + "\n");
-                // 采集数据
-                std::map<std::string, double> data = {
-                    {"time", next_time},
-                    {"position", state_.position.load()},
-                    {"velocity", state_.velocity.load()},
-                    {"acceleration", state_.acceleration.load()},
-                    {"throttle", state_.throttle.load()},
-                    {"brake", state_.brake.load()},
-                    {"thrust", state_.thrust.load()},
-                    {"drag", state_.drag_force.load()},
-                    {"brake_force", state_.brake_force.load()}
-                };
-                logger_.recordData(data);
-                log_detail("[DataRecorder] 输出完成 步数=" + std::to_string(clock_.getStepCount()) +
-                                  " current_time=" + std::to_string(next_time) +
-                                  " 输出次数=" + std::to_string(output_count) + "\n");
-                
-                // 更新下一个要记录的时间点
-                next_time += 0.01; // 按时间步长递增
-            }
+            // 与动力学、控制器线程并发：读取上一个步屏障提交并发布的快照（第 k 步读到第 k-1 步的状态）
+            recordSnapshot(state_.getState());
             
             clock_.notifyStepCompleted();
         }
-        clock_.unregisterThread();
+        // 时钟停止前的最后一个步屏障提交的状态（已记录过时按快照时间跳过）
+        recordSnapshot(state_.getState());
+        clock_.unregisterThread(rate_divisor);
+    }
+
+    // 快照的仿真时间到达下一个记录时间点时输出一行数据
+    // 按快照自身的时间判断，因此独立线程模式下同一快照被读到两次（或读到尚未推进的快照）时不会重复输出；
+    // 降频记录时独立线程在调度步读到的是上一步的快照，可能晚一个记录周期才输出
+    void recordSnapshot(const StateSnapshot& s) {
+        // 记录时间点按周期累加、仿真时间按步长累加，二者的浮点舍入不同，留半个步长的容差
+        if (s.simulation_time >= next_time_ - 0.5 * clock_.getTimeStep()) {
+            const double next_time = next_time_;
+            output_count_++;
+            log_detail("[DataRecorder] 线程(" + ThreadNaming::get_current_thread_name() + ") " +
+                              "步数=" + std::to_string(clock_.getStepCount()) +
+                              " current_time=" + std::to_string(next_time) +
+                              " 输出次数=" + std::to_string(output_count_) + "\n");
+            // 输出数据
+            record(next_time, s);
+            log_detail("[DataRecorder] 输出完成 步数=" + std::to_string(clock_.getStepCount()) +
+                              " current_time=" + std::to_string(next_time) +
+                              " 输出次数=" + std::to_string(output_count_) + "\n");
+            
+            // 更新下一个要记录的时间点
+            next_time_ += recordInterval(); // 按记录周期递增
+        }
     }
+
+    void record(double time, const StateSnapshot& s) {
+        logger_.recordData(time, s);
+    }
+
+    // 相邻两行数据的时间间隔：未设置记录周期时为时间步长
+    double recordInterval() const {
+        return record_period_ > 0.0 ? clock_.getTimeStep() * getRateDivisor() : clock_.getTimeStep();
+    }
+
     SharedStateSpace& state_;
     SimulationClock& clock_;
     FileLogger& logger_;
     std::atomic<bool> running_;
     std::thread thread_;
+    size_t output_count_ = 0;  // 已输出行数
+    double next_time_ = 0.01;  // 下一个要记录的时间点
+    double record_period_ = 0.0; // 记录周期（秒），0 表示每步记录
 };
\ No newline at end of file
@@ -0,0 +1,286 @@
+/*
+ * @file deterministic_replay.hpp
+ * @brief 确定性记录/回放头文件
+ *
+ * 多线程模式下控制器与动力学通过原子变量直接竞争，异步事件总线的4个工作线程分发顺序不定，
+ * 两次运行做的计算不同，无法逐位复现，也无法比较两次运行的耗时。确定性模式由三部分组成：
+ *   - 固定组件顺序：融合执行器（或任务图执行器）+ 同步事件总线，每步按 动力学→状态提交→事件→控制器→数据记录 执行
+ *   - 外部输入在步边界生效：控制通道的 stop 命令不再由控制线程立即执行，而是排队到下一个步结束时由执行器线程施加
+ *   - 记录/回放日志：记录每个外部命令和事件分发所在的步，以及每步的状态摘要（状态空间检查点的 FNV-1a 哈希）
+ *
+ * 回放时按日志在相同的步施加外部命令（忽略控制通道的 stop），逐步核对事件分发与状态摘要，
+ * 发现第一个不一致的步即报告；回放不与墙钟同步，按最快速度运行。
+ * 暂停/恢复只影响墙钟，不改变计算结果，因此不记录。
+ *
+ * 日志为文本格式，每行一条：
+ *     # ParaSAFE replay log v1
+ *     dt 0.01
+ *     D <步数> <状态摘要>     （第一条为开始运行时的状态）
+ *     E <步数> <事件名称>
+ *     C <步数> <命令>
+ *
+ * 典型用法（融合执行器）：
+ *   DeterministicSession session(ReplayMode::Record, "output/replay_log.txt");
+ *   bus.setDispatchObserver([&](const std::string& e) { session.onEventDispatched(clock.getStepCount(), e); });
+ *   simulation_control.setDeterministicSession(&session);   // 步结束时施加外部命令
+ *   session.begin(state);
+ *   executor.run();
+ *   session.finish();
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <cstdint>     // 摘要与步数
+#include <fstream>     // 日志文件
+#include <mutex>       // 外部命令队列
+#include <sstream>     // 日志解析
+#include <string>      // 命令与事件名称
+#include <vector>      // 日志条目
+
+// ParaSAFE系统头文件
+#include "../K_Scenario/shared_state.hpp"   // 共享状态空间
+#include "checkpoint.hpp"                   // 状态序列化（摘要）
+#include "logger.hpp"                       // 日志系统
+
+/**
+ * @brief 记录/回放模式
+ */
+enum class ReplayMode {
+    Off,      ///< 不记录
+    Record,   ///< 记录外部命令、事件分发和状态摘要
+    Replay    ///< 按日志施加外部命令并逐步核对
+};
+
+/**
+ * @struct ReplayEntry
+ * @brief 日志中的一条记录
+ */
+struct ReplayEntry {
+    enum class Kind : char {
+        Digest = 'D',    ///< 步结束时的状态摘要
+        Event = 'E',     ///< 事件分发
+        Command = 'C'    ///< 外部命令
+    };
+    Kind kind;
+    uint64_t step;
+    std::string payload;   ///< 摘要（十六进制）、事件名称或命令
+};
+
+/**
+ * @class DeterministicSession
+ * @brief 一次确定性运行的记录或回放
+ *
+ * onEventDispatched() 与 endStep() 在执行器线程调用；submitCommand() 可从控制通道线程调用。
+ */
+class DeterministicSession {
+public:
+    explicit DeterministicSession(ReplayMode mode, std::string path = "output/replay_log.txt")
+        : mode_(mode), path_(std::move(path)) {}
+
+    ReplayMode mode() const { return mode_; }
+    bool enabled() const { return mode_ != ReplayMode::Off; }
+    const std::string& path() const { return path_; }
+
+    /**
+     * @brief 开始运行（初始化或从检查点恢复之后）：记录模式写入初始状态摘要，回放模式加载日志并核对初始状态
+     * @return 回放日志读取失败或初始状态不一致时返回 false
+     */
+    bool begin(const SharedStateSpace& state) {
+        if (mode_ == ReplayMode::Off) return true;
+        entries_.clear();
+        cursor_digest_ = cursor_event_ = cursor_command_ = 0;
+        diverged_ = false;
+        divergence_.clear();
+        if (mode_ == ReplayMode::Replay) {
+            if (!load()) return false;
+            if (dt_ != state.clock().getTimeStep()) {
+                fail(0, "步长不一致（日志 " + std::to_string(dt_) + "s，当前 " +
+                        std::to_string(state.clock().getTimeStep()) + "s）");
+                return false;
+            }
+            log_detail("[回放] 已加载 " + path_ + "，共 " + std::to_string(entries_.size()) + " 条记录\n");
+        } else {
+            dt_ = state.clock().getTimeStep();
+        }
+        checkDigest(static_cast<uint64_t>(state.clock().getStepCount()), state);
+        return !diverged_;
+    }
+
+    /**
+     * @brief 外部命令（控制通道线程调用）：记录模式排队到下一个步结束时施加，回放模式忽略
+     */
+    void submitCommand(const std::string& command) {
+        if (mode_ == ReplayMode::Replay) {
+            log_detail("[回放] 忽略外部命令 " + command + "，外部命令按日志施加\n");
+            return;
+        }
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_commands_.push_back(command);
+    }
+
+    /**
+     * @brief 事件分发（执行器线程调用，由 EventBus 的分发观察者转发）
+     */
+    void onEventDispatched(uint64_t step, const std::string& event) {
+        if (mode_ == ReplayMode::Record) {
+            entries_.push_back({ReplayEntry::Kind::Event, step, event});
+        } else if (mode_ == ReplayMode::Replay && !diverged_) {
+            const ReplayEntry* expected = next(ReplayEntry::Kind::Event, cursor_event_);
+            if (!expected || expected->step != step || expected->payload != event) {
+                fail(step, "事件分发不一致：当前 " + event + "，日志 " +
+                           (expected ? expected->payload + "（第 " + std::to_string(expected->step) + " 步）" : "无"));
+            }
+        }
+    }
+
+    /**
+     * @brief 步结束（执行器线程调用）：记录或核对状态摘要
+     * @return 本步结束时应施加的外部命令
+     */
+    std::vector<std::string> endStep(uint64_t step, const SharedStateSpace& state) {
+        std::vector<std::string> commands;
+        if (mode_ == ReplayMode::Record) {
+            {
+                std::lock_guard<std::mutex> lock(pending_mutex_);
+                commands.swap(pending_commands_);
+            }
+            for (const auto& command : commands) entries_.push_back({ReplayEntry::Kind::Command, step, command});
+        } else if (mode_ == ReplayMode::Replay) {
+            while (const ReplayEntry* entry = peek(ReplayEntry::Kind::Command, cursor_command_)) {
+                if (entry->step != step) break;
+                commands.push_back(entry->payload);
+                next(ReplayEntry::Kind::Command, cursor_command_);
+            }
+        }
+        if (enabled()) checkDigest(step, state);
+        return commands;
+    }
+
+    /**
+     * @brief 结束运行：记录模式写出日志，回放模式检查是否有未回放的记录
+     * @return 记录写出成功或回放逐位一致返回 true
+     */
+    bool finish() {
+        if (mode_ == ReplayMode::Record) {
+            if (!save()) {
+                log_detail("[记录] 写入回放日志失败: " + path_ + "\n");
+                return false;
+            }
+            log_detail("[记录] 已写入回放日志 " + path_ + "，共 " + std::to_string(entries_.size()) + " 条记录\n");
+            return true;
+        }
+        if (mode_ == ReplayMode::Replay) {
+            if (!diverged_ && peek(ReplayEntry::Kind::Digest, cursor_digest_)) {
+                fail(peek(ReplayEntry::Kind::Digest, cursor_digest_)->step, "回放提前结束");
+            }
+            if (!diverged_) log_detail("[回放] 回放与记录逐位一致\n");
+            return !diverged_;
+        }
+        return true;
+    }
+
+    bool diverged() const { return diverged_; }
+    const std::string& divergence() const { return divergence_; }
+
+    /**
+     * @brief 状态摘要：状态空间检查点数据的 FNV-1a 哈希，覆盖所有状态变量与控制标志
+     */
+    static uint64_t digest(const SharedStateSpace& state) {
+        CheckpointWriter writer;
+        state.saveCheckpoint(writer);
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char byte : writer.data()) {
+            hash ^= byte;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+private:
+    void checkDigest(uint64_t step, const SharedStateSpace& state) {
+        std::ostringstream hex;
+        hex << std::hex << digest(state);
+        if (mode_ == ReplayMode::Record) {
+            entries_.push_back({ReplayEntry::Kind::Digest, step, hex.str()});
+        } else if (!diverged_) {
+            const ReplayEntry* expected = next(ReplayEntry::Kind::Digest, cursor_digest_);
+            if (!expected || expected->step != step || expected->payload != hex.str()) {
+                fail(step, "状态摘要不一致（t=" + std::to_string(state.simulation_time.load()) + "s）");
+            }
+        }
+    }
+
+    // 回放：查看某类记录的下一条（不前进）
+    const ReplayEntry* peek(ReplayEntry::Kind kind, size_t& cursor) const {
+        while (cursor < entries_.size() && entries_[cursor].kind != kind) ++cursor;
+        return cursor < entries_.size() ? &entries_[cursor] : nullptr;
+    }
+
+    // 回放：取出某类记录的下一条
+    const ReplayEntry* next(ReplayEntry::Kind kind, size_t& cursor) const {
+        const ReplayEntry* entry = peek(kind, cursor);
+        if (entry) ++cursor;
+        return entry;
+    }
+
+    void fail(uint64_t step, const std::string& reason) {
+        diverged_ = true;
+        divergence_ = "第 " + std::to_string(step) + " 步: " + reason;
+        log_detail("[回放] 与记录不一致，" + divergence_ + "\n");
+    }
+
+    bool save() const {
+        std::ofstream file(path_, std::ios::trunc);
+        if (!file.is_open()) return false;
+        file << "# ParaSAFE replay log v1\n";
+        file.precision(17);
+        file << "dt " << dt_ << "\n";
+        for (const auto& entry : entries_) {
+            file << static_cast<char>(entry.kind) << ' ' << entry.step << ' ' << entry.payload << '\n';
+        }
+        return static_cast<bool>(file);
+    }
+
+    bool load() {
+        std::ifstream file(path_);
+        if (!file.is_open()) {
+            fail(0, "无法打开回放日志 " + path_);
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream iss(line);
+            std::string tag;
+            iss >> tag;
+            if (tag == "dt") {
+                iss >> dt_;
+                continue;
+            }
+            ReplayEntry entry{ReplayEntry::Kind::Digest, 0, {}};
+            const bool known_tag = tag == "D" || tag == "E" || tag == "C";
+            if (!known_tag || !(iss >> entry.step)) {
+                fail(0, "回放日志格式错误: " + line);
+                return false;
+            }
+            entry.kind = static_cast<ReplayEntry::Kind>(tag[0]);
+            iss >> std::ws;
+            std::getline(iss, entry.payload);
+            entries_.push_back(std::move(entry));
+        }
+        return true;
+    }
+
+    const ReplayMode mode_;
+    std::string path_;
+    double dt_ = 0.0;
+    std::vector<ReplayEntry> entries_;          ///< 记录模式为已记录条目，回放模式为日志条目
+    size_t cursor_digest_ = 0;                  ///< 回放：下一条待核对的摘要
+    size_t cursor_event_ = 0;                   ///< 回放：下一条待核对的事件
+    size_t cursor_command_ = 0;                 ///< 回放：下一条待施加的命令
+    bool diverged_ = false;
+    std::string divergence_;
+    std::mutex pending_mutex_;
+    std::vector<std::string> pending_commands_; ///< 记录模式：待在步结束时施加的外部命令
+};
@@ -0,0 +1,129 @@
+/*
+ * @file fused_step_executor.hpp
+ * @brief 单线程融合步进执行器头文件
+ *
+ * 默认情况下，动力学、状态空间、事件检测、各控制器和数据记录各占一个线程，
+ * 每步在仿真时钟屏障上同步两次，而每个线程在两次同步之间只做很少的工作。
+ * 本执行器把这些组件作为有序的阶段回调，在一个线程内依次执行：
+ *
+ *     动力学 → 状态提交 → 事件检测 → 控制器 → 数据记录
+ *
+ * 每步没有线程切换，执行顺序固定，结果可复现；批量仿真时可以每个核心跑一个仿真。
+ * 状态提交阶段相当于多线程模式的步屏障：两次提交之间各组件只读已提交的状态、写入后缓冲，
+ * 因此与多线程模式得到相同的状态序列。
+ *
+ * 使用要求：
+ *   - 事件总线使用 EventBus::DispatchMode::Synchronous，事件在事件检测阶段内同步分发
+ *   - 控制器管理器调用 setExternallyStepped(true)，控制器启动时不创建线程
+ *   - 各组件不调用 start()，由执行器直接调用其单步接口
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <array>            // 阶段表
+#include <functional>       // 阶段回调
+#include <string>           // 阶段名称
+#include <atomic>           // 停止标志
+
+// ParaSAFE系统头文件
+#include "../K_Scenario/shared_state.hpp"   // 共享状态空间
+#include "simulation_clock.hpp"             // 仿真时钟
+#include "thread_name_util.hpp"             // 线程命名工具
+#include "logger.hpp"                       // 日志系统
+
+/**
+ * @brief 融合执行器的阶段，按枚举顺序执行
+ */
+enum class FusedStage {
+    Dynamics = 0,   ///< 动力学模型推进
+    StateCommit,    ///< 提交后缓冲、发布快照（StateManagerThread::processStep）
+    Events,         ///< 事件检测（EventMonitorThread::checkEventsOnce）
+    Controllers,    ///< 控制器（ControllerManagerThread::stepControllers）
+    Recorder,       ///< 数据记录（DataRecorderThread::recordStep）
+    Count
+};
+
+/**
+ * @class FusedStepExecutor
+ * @brief 在一个线程内按固定顺序执行所有仿真组件的执行器
+ */
+class FusedStepExecutor {
+public:
+    using StageCallback = std::function<void()>;
+
+    FusedStepExecutor(SimulationClock& clock, SharedStateSpace& state)
+        : clock_(clock), state_(state) {}
+
+    /**
+     * @brief 设置某个阶段的回调
+     * @param stage 阶段
+     * @param callback 阶段回调，未设置的阶段跳过
+     * @param rate_divisor 速率分频，阶段只在步数为其整数倍时执行（与 SimulationClock::registerThread 含义一致）
+     */
+    void setStage(FusedStage stage, StageCallback callback, int rate_divisor = 1) {
+        stages_[static_cast<size_t>(stage)] = std::move(callback);
+        divisors_[static_cast<size_t>(stage)] = rate_divisor < 1 ? 1 : rate_divisor;
+    }
+
+    /**
+     * @brief 设置每步结束时检查的停止条件
+     * @param condition 返回 true 时执行器在本步结束后停止
+     *
+     * 停止条件在所有阶段之后、每步都检查（不受阶段分频影响），停止时刻与线程调度无关。
+     */
+    void setStopCondition(std::function<bool()> condition) {
+        stop_condition_ = std::move(condition);
+    }
+
+    /**
+     * @brief 推进时钟并按顺序执行一个仿真步的所有阶段
+     */
+    void stepOnce() {
+        clock_.advanceStep();
+        const uint64_t step = static_cast<uint64_t>(clock_.getStepCount());
+        for (size_t i = 0; i < stages_.size(); ++i) {
+            if (stages_[i] && SimulationClock::isStepDue(step, divisors_[i])) stages_[i]();
+        }
+        executed_steps_++;
+        if (stop_condition_ && stop_condition_()) stop();
+    }
+
+    /**
+     * @brief 在当前线程运行仿真，直到时钟停止或仿真结束
+     */
+    void run() {
+        ThreadNaming::set_current_thread_name("FusedExecutor");
+        stop_requested_ = false;
+        clock_.startExternalStepping();
+        log_detail("[融合执行器] 开始运行\n");
+        while (!stop_requested_.load(std::memory_order_acquire) &&
+               state_.simulation_running.load(std::memory_order_acquire)) {
+            if (!clock_.waitWhilePaused()) break;
+            stepOnce();
+        }
+        clock_.stop();
+        log_detail("[融合执行器] 运行结束，共执行 " + std::to_string(executed_steps_) + " 步\n");
+    }
+
+    /**
+     * @brief 请求停止（可从其他线程调用）
+     */
+    void stop() {
+        stop_requested_ = true;
+    }
+
+    /**
+     * @brief 已执行的步数
+     */
+    size_t getExecutedSteps() const { return executed_steps_; }
+
+private:
+    SimulationClock& clock_;
+    SharedStateSpace& state_;
+    std::array<StageCallback, static_cast<size_t>(FusedStage::Count)> stages_;
+    std::array<int, static_cast<size_t>(FusedStage::Count)> divisors_{1, 1, 1, 1, 1};
+    std::function<bool()> stop_condition_;
+    std::atomic<bool> stop_requested_{false};
+    size_t executed_steps_ = 0;
+};
@@ -0,0 +1,146 @@
+/*
+ * @file latency_histogram.hpp
+ * @brief 无锁对数-线性延迟直方图头文件
+ *
+ * HDR 风格的直方图：每个 2 的幂区间再均分为 32 个子桶，相对误差不超过 1/32（约 3%），
+ * 覆盖 1ns 到约 39 小时。记录只有一次 relaxed fetch_add（外加最大值的 CAS），
+ * 可以在时钟屏障的每步热路径上由多个线程同时调用；读取分位数时不需要停止记录。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <atomic>    // 无锁计数
+#include <array>     // 桶数组
+#include <cstdint>   // 整数类型
+#if defined(_MSC_VER)
+#include <intrin.h>  // _BitScanReverse64
+#endif
+
+/**
+ * @struct LatencySummary
+ * @brief 直方图的分位数摘要（单位：纳秒）
+ */
+struct LatencySummary {
+    uint64_t count = 0;   ///< 样本数
+    uint64_t p50 = 0;     ///< 中位数
+    uint64_t p99 = 0;     ///< 99 分位
+    uint64_t p999 = 0;    ///< 99.9 分位
+    uint64_t max = 0;     ///< 最大值
+    double mean = 0.0;    ///< 平均值
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief 无锁对数-线性延迟直方图
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;                           ///< 每个 2 的幂区间的子桶数 = 2^5
+    static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+    static constexpr int kMaxExponent = 47;                            ///< 最大可区分值约 2^47 ns
+    static constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+    /**
+     * @brief 记录一个样本（纳秒），超出范围的值计入最后一个桶
+     */
+    void record(uint64_t value_ns) {
+        counts_[bucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value_ns, std::memory_order_relaxed);
+        uint64_t prev = max_.load(std::memory_order_relaxed);
+        while (value_ns > prev && !max_.compare_exchange_weak(prev, value_ns, std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * @brief 样本数
+     */
+    uint64_t count() const { return total_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 分位数（纳秒），返回所在桶的上界（不超过最大值）
+     * @param quantile 0~1
+     */
+    uint64_t percentile(double quantile) const {
+        const uint64_t total = count();
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(total) + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                const uint64_t upper = bucketUpperBound(i);
+                const uint64_t max = max_.load(std::memory_order_relaxed);
+                return upper < max ? upper : max;
+            }
+        }
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief p50/p99/p999/max 摘要
+     */
+    LatencySummary summary() const {
+        LatencySummary s;
+        s.count = count();
+        if (s.count == 0) return s;
+        s.p50 = percentile(0.50);
+        s.p99 = percentile(0.99);
+        s.p999 = percentile(0.999);
+        s.max = max_.load(std::memory_order_relaxed);
+        s.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(s.count);
+        return s;
+    }
+
+    /**
+     * @brief 清零（与 record 并发调用时，清零期间的样本可能部分丢失）
+     */
+    void reset() {
+        for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+        total_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 值所在的桶下标
+     *
+     * 小于 2*kSubBuckets 的值每个值一个桶；更大的值按最高位所在的 2 的幂区间分组，
+     * 区间内取最高的 kSubBucketBits+1 位作为子桶。
+     */
+    static size_t bucketIndex(uint64_t value) {
+        if (value < 2 * kSubBuckets) return static_cast<size_t>(value);
+        const int msb = highestBit(value);
+        if (msb > kMaxExponent) return kBucketCount - 1;
+        const int shift = msb - kSubBucketBits;
+        return static_cast<size_t>((shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets));
+    }
+
+    /**
+     * @brief 桶内最大值
+     */
+    static uint64_t bucketUpperBound(size_t index) {
+        if (index < 2 * kSubBuckets) return index;
+        const int shift = static_cast<int>(index / kSubBuckets) - 1;
+        const uint64_t lower = ((index % kSubBuckets) + kSubBuckets) << shift;
+        return lower + (uint64_t{1} << shift) - 1;
+    }
+
+private:
+    static int highestBit(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> counts_{};
+    std::atomic<uint64_t> total_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
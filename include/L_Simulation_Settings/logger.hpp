@@ -7,7 +7,12 @@
 #include <iomanip>
 #include <sstream>
 #include <atomic>
+#include <thread>
+#include <vector>
+#include <iterator>
 #include "version.hpp"
+#include "mpsc_ring.hpp"
+#include "change_signal.hpp"
 
 class Logger {
 public:
@@ -21,24 +26,11 @@ public:
     void log(const std::string& msg, Level level) {
         if (!enabled.load()) return;
 
-        std::string timestamp = getTimestamp();
-        std::string log_message = timestamp + msg + "\n";
-
-        if (level == Level::BRIEF || level == Level::DETAIL) {
-            std::lock_guard<std::mutex> lock(brief_mutex);
-            if (brief_file.is_open()) {
-                brief_file << log_message;
-                brief_file.flush();
-            }
-        }
-
-        if (level == Level::DETAIL) {
-            std::lock_guard<std::mutex> lock(detail_mutex);
-            if (detail_file.is_open()) {
-                detail_file << log_message;
-                detail_file.flush();
-            }
-        }
+        // 写线程在第一条日志时启动，日志始终关闭（如批量仿真）时不创建线程
+        std::call_once(writer_started, [this] { writer = std::thread(&Logger::writerLoop, this); });
+        // 时间戳在调用线程取得，文件写入交给后台写线程；写线程休眠时才需要唤醒
+        records.push(Record{getTimestamp() + msg + "\n", level});
+        records_changed.notify();
     }
 
     void logVersionInfo() {
@@ -61,11 +53,21 @@ public:
     bool isEnabled() const { return enabled.load(); }
 
 private:
+    struct Record {
+        std::string text;
+        Level level = Level::BRIEF;
+    };
+
+    static constexpr size_t RECORD_CAPACITY = 4096;   // 待写日志条数上限，写满时调用线程等待
+    static constexpr size_t WRITE_BATCH = 256;        // 写线程每批最多写入的条数
+
     std::ofstream brief_file;
     std::ofstream detail_file;
-    std::mutex brief_mutex;
-    std::mutex detail_mutex;
     std::atomic<bool> enabled{true};
+    MpscRing<Record> records{RECORD_CAPACITY};
+    ChangeSignal records_changed;   // 推入或关闭后通知，写线程空闲时在此休眠
+    std::once_flag writer_started;
+    std::thread writer;
 
     Logger() {
         // 先清空文件
@@ -76,12 +78,40 @@ private:
         detail_file.open("output/log_detail.txt", std::ios::app);
     }
     ~Logger() {
+        // 关闭后写线程写完剩余日志再退出
+        records.close();
+        records_changed.notify();
+        if (writer.joinable()) writer.join();
         if (brief_file.is_open()) brief_file.close();
         if (detail_file.is_open()) detail_file.close();
     }
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
+    // 后台写线程：成批取出日志写入文件，每批只刷新一次
+    void writerLoop() {
+        std::vector<Record> batch;
+        batch.reserve(WRITE_BATCH);
+        while (true) {
+            batch.clear();
+            records.popBatch(std::back_inserter(batch), WRITE_BATCH);
+            if (batch.empty()) {
+                if (records.isClosed() && records.empty()) return;
+                // 环空时休眠到有日志推入或关闭（已预留未发布的槽位使 empty() 为假，只会短暂重试）
+                records_changed.waitUntil([this] { return !records.empty() || records.isClosed(); },
+                                          std::chrono::steady_clock::duration::max());
+                continue;
+            }
+            for (const Record& record : batch) {
+                // BRIEF 和 DETAIL 都写入概要日志，DETAIL 另写入详细日志
+                if (brief_file.is_open()) brief_file << record.text;
+                if (record.level == Level::DETAIL && detail_file.is_open()) detail_file << record.text;
+            }
+            if (brief_file.is_open()) brief_file.flush();
+            if (detail_file.is_open()) detail_file.flush();
+        }
+    }
+
     std::string getTimestamp() {
         auto now = std::chrono::system_clock::now();
         auto now_time_t = std::chrono::system_clock::to_time_t(now);
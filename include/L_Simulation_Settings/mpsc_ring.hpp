@@ -0,0 +1,152 @@
+/*
+ * @file mpsc_ring.hpp
+ * @brief 固定容量无锁多生产者单消费者环形缓冲头文件
+ *
+ * MpscRing 用于多个仿真线程向单个后台线程投递消息（如日志记录），替代"互斥锁 + deque + notify_one"
+ * 的队列：容量在构造时固定，推入不加锁、不分配节点内存，也不唤醒消费者。
+ *
+ * 实现要点：
+ *   - 生产者用一次 CAS 在 tail_ 上预留连续 n 个槽位（批量推入只做一次预留），写入后逐槽发布序号
+ *   - 消费者按序号顺序取出已发布的槽位，取完一批后才推进 head_ 归还空间
+ *   - 已预留但尚未发布的槽位会挡住其后的槽位，消费者不会越过它乱序取出
+ *   - close() 之后推入一律失败；消费者取空后 isClosed() && empty() 即可退出，阻塞中的生产者也会返回
+ *
+ * 元素类型需可默认构造、可移动赋值。只能有一个消费者线程。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <atomic>    // 无锁下标与槽位序号
+#include <cstddef>   // size_t
+#include <thread>    // 队列满时让出时间片
+#include <utility>   // std::move
+#include <vector>    // 槽位数组
+
+/**
+ * @class MpscRing
+ * @brief 固定容量、支持批量推入/取出的无锁 MPSC 环形缓冲
+ */
+template <typename T>
+class MpscRing {
+public:
+    /**
+     * @brief 构造环形缓冲
+     * @param capacity 容量，向上取整为 2 的幂
+     */
+    explicit MpscRing(size_t capacity) {
+        size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        capacity_ = rounded;
+        mask_ = rounded - 1;
+        slots_ = std::vector<Slot>(rounded);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief 推入一个元素，队列满或已关闭时立即返回 false
+     */
+    bool tryPush(T value) {
+        return tryPushBatch(&value, 1);
+    }
+
+    /**
+     * @brief 一次预留推入 first 起的 n 个元素（移动），空间不足或已关闭时立即返回 false，不推入任何元素
+     */
+    template <typename Iterator>
+    bool tryPushBatch(Iterator first, size_t n) {
+        if (n == 0) return true;
+        if (n > capacity_) return false;
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            if (closed_.load(std::memory_order_acquire)) return false;
+            const size_t head = head_.load(std::memory_order_acquire);
+            if (pos + n > head + capacity_) {
+                // 空间不足：确认不是读到了过期的 tail_ 再报告已满
+                const size_t current = tail_.load(std::memory_order_relaxed);
+                if (current == pos) return false;
+                pos = current;
+                continue;
+            }
+            if (tail_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed, std::memory_order_relaxed)) break;
+        }
+        for (size_t i = 0; i < n; ++i, ++first) {
+            Slot& slot = slots_[(pos + i) & mask_];
+            slot.value = std::move(*first);
+            slot.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 推入一个元素，队列满时让出时间片等待消费者，已关闭时返回 false
+     */
+    bool push(T value) {
+        return pushBatch(&value, 1);
+    }
+
+    /**
+     * @brief 批量推入，队列满时等待，已关闭或 n 超过容量时返回 false
+     */
+    template <typename Iterator>
+    bool pushBatch(Iterator first, size_t n) {
+        if (n > capacity_) return false;
+        while (!tryPushBatch(first, n)) {
+            if (closed_.load(std::memory_order_acquire)) return false;
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    /**
+     * @brief 取出最多 max 个已发布的元素写入输出迭代器 out（仅消费者线程调用）
+     * @return 取出的个数，没有可取元素时为 0（不阻塞）
+     */
+    template <typename OutputIterator>
+    size_t popBatch(OutputIterator out, size_t max) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (count < max) {
+            Slot& slot = slots_[(head + count) & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != head + count + 1) break;
+            *out = std::move(slot.value);
+            ++out;
+            ++count;
+        }
+        // 一批取完后统一归还空间，生产者看到新的 head_ 时槽位已经读完
+        if (count > 0) head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief 关闭：之后的推入失败，阻塞在推入中的生产者返回；已推入的元素仍可取出
+     */
+    void close() { closed_.store(true, std::memory_order_release); }
+
+    bool isClosed() const { return closed_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 没有已推入（含已预留未发布）的元素
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    // 每个槽位独占缓存行，相邻槽位的生产者互不干扰
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence{0};   ///< 位置 pos 的元素发布后为 pos + 1
+        T value{};
+    };
+
+    std::vector<Slot> slots_;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> tail_{0};   ///< 生产者预留位置
+    alignas(64) std::atomic<size_t> head_{0};   ///< 消费者已取出位置
+    std::atomic<bool> closed_{false};
+};
@@ -0,0 +1,86 @@
+/*
+ * @file seqlock.hpp
+ * @brief 顺序锁（seqlock）头文件
+ *
+ * 单写者、多读者的无锁一致性快照：
+ *   - 写者：序号置为奇数 → 写入数据 → 序号置为下一个偶数，从不等待读者
+ *   - 读者：读序号 → 复制数据 → 再读序号，两次相同且为偶数即得到一致的副本，否则重试
+ *
+ * 数据按 64 位字保存在原子变量中（relaxed 读写），读写并发时没有数据竞争；
+ * 序号与数据相邻并按缓存行对齐，12 个 double 的状态快照占两个缓存行，读者一次复制完成。
+ *
+ * 只允许一个写者；多个写者须由调用方串行化。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <atomic>        // 序号与数据字
+#include <cstdint>       // uint64_t
+#include <cstring>       // memcpy
+#include <type_traits>   // is_trivially_copyable
+
+// ParaSAFE系统头文件
+#include "spin_wait.hpp" // cpuRelax
+
+/**
+ * @class SeqLock
+ * @brief 单写者顺序锁
+ * @tparam T 平凡可复制类型
+ */
+template <typename T>
+class alignas(64) SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock 只能保存平凡可复制类型");
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    SeqLock() = default;
+    explicit SeqLock(const T& value) { store(value); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /**
+     * @brief 写入新值（仅限单个写者，不等待读者）
+     */
+    void store(const T& value) {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+        const uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) words_[i].store(words[i], std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief 读取一致的副本（写入进行中时重试，不加锁）
+     */
+    T load() const {
+        uint64_t words[kWords];
+        uint64_t before;
+        uint64_t after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            if (before & 1) {
+                SpinWait::cpuRelax();
+                continue;
+            }
+            for (size_t i = 0; i < kWords; ++i) words[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief 已写入的次数
+     */
+    uint64_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    std::atomic<uint64_t> seq_{0};
+    std::atomic<uint64_t> words_[kWords] = {};
+};
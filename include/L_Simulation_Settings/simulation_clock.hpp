@@ -9,8 +9,15 @@
 #include <thread>
 #include <vector>
 #include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include "thread_name_util.hpp"
 #include "logger.hpp"
+#include "spin_wait.hpp"
+#include "latency_histogram.hpp"
+#include "checkpoint.hpp"
+#include <memory>
 
 /**
  * @class SimulationClock
@@ -21,12 +28,64 @@
  * 2. 多线程同步
  * 3. 仿真状态管理
  * 
- * 使用单例模式确保全局只有一个时钟实例
+ * 步进屏障有两种实现（见 BarrierMode）：
+ * - Mutex：互斥锁 + 条件变量，所有参与线程竞争同一把锁
+ * - SpinWait：无锁计数屏障，先自旋再进入 atomic::wait（futex）休眠，适合参与线程较多的场景
+ * 两种模式对外保持相同的 registerThread / waitForNextStep / notifyStepCompleted 约定。
+ * 
+ * 多速率调度：参与线程注册时可指定速率分频 N（每 N 个时间步参与一次，也可由 divisorForPeriod 从周期换算）。
+ * 相同分频的线程组成一个速率组，每组有独立的唤醒通道；第 k 步只唤醒、只等待 k % N == 0 的组，
+ * 屏障参与数随该步实际调度的工作量变化。
+ * 
+ * 时间推进有三种运行模式（见 RunMode）：
+ * - AsFastAsPossible：不等待墙钟，用于批量仿真
+ * - RealTime：按 steady_clock 绝对截止时间推进，仿真时间与墙钟 1:1
+ * - ScaledRealTime：按 N 倍实时推进（N 由 setRunMode 的 time_scale 指定）
+ * 节拍采用绝对截止时间（sleep_until），单步睡眠误差不会累积；运行统计（实际实时因子、超时步数）
+ * 由 getRunStats() 取得，或在停止后调用 reportRunStats() 写入日志。
+ * 
+ * 每个仿真持有自己的时钟实例（见 SimulationContext），各组件通过 SharedStateSpace::clock() 取得；
+ * getInstance() 保留为进程默认时钟，供单仿真程序和未绑定时钟的状态空间使用。
  */
 class SimulationClock {
 public:
     /**
-     * @brief 获取时钟单例实例
+     * @brief 步进屏障实现方式
+     */
+    enum class BarrierMode {
+        Mutex,      ///< 互斥锁 + 条件变量（默认）
+        SpinWait    ///< 无锁计数 + 纪元翻转，自旋后 atomic::wait 休眠
+    };
+
+    /**
+     * @brief 时间推进运行模式
+     */
+    enum class RunMode {
+        AsFastAsPossible,   ///< 尽可能快（默认），不与墙钟同步
+        RealTime,           ///< 实时：仿真时间与墙钟 1:1
+        ScaledRealTime      ///< N 倍实时：仿真时间 = N × 墙钟时间
+    };
+
+    /**
+     * @brief 运行统计
+     */
+    struct RunStats {
+        uint64_t steps = 0;             ///< 本次运行推进的步数
+        double sim_elapsed = 0.0;       ///< 本次运行推进的仿真时间（秒）
+        double wall_elapsed = 0.0;      ///< 本次运行的墙钟时间（秒，不含暂停）
+        double real_time_factor = 0.0;  ///< 实际实时因子 = 仿真时间 / 墙钟时间
+        uint64_t overruns = 0;          ///< 节拍模式下错过截止时间的步数
+        double max_lag = 0.0;           ///< 节拍模式下最大滞后（秒）
+    };
+
+    /**
+     * @brief 构造一个独立的仿真时钟
+     * @param step_size 时间步长（秒）
+     */
+    explicit SimulationClock(double step_size = 0.01) : dt(step_size) {}
+
+    /**
+     * @brief 获取进程默认时钟
      * @return SimulationClock& 时钟实例的引用
      */
     static SimulationClock& getInstance() {
@@ -34,20 +93,270 @@ public:
         return instance;
     }
 
+    /**
+     * @brief 最多支持的不同速率分频数
+     */
+    static constexpr int kMaxRateGroups = 16;
+
     /**
      * @brief 注册线程
+     * @param rate_divisor 速率分频，线程只参与步数为其整数倍的时间步（默认每步参与）
      */
-    void registerThread() {
+    void registerThread(int rate_divisor = 1) {
+        const int group = rateGroupIndex(rate_divisor);
+        rate_counts[group].fetch_add(1, std::memory_order_acq_rel);
         registered_threads++;
-        log_detail("[时钟] 一个线程已注册，总注册线程数: " + std::to_string(registered_threads.load()) + "\n");
+        bindLatencyRecord();
+        log_detail("[时钟] 一个线程已注册(分频=" + std::to_string(rate_divisors[group]) + ")，总注册线程数: " + std::to_string(registered_threads.load()) + "\n");
+        if (registered_threads.load() <= start_participants.load(std::memory_order_relaxed)) {
+            // start() 可能正在等待常驻参与线程注册
+            std::lock_guard<std::mutex> lock(mtx);
+            cv_step_end.notify_all();
+        }
     }
 
     /**
      * @brief 注销线程
+     * @param rate_divisor 注册时使用的速率分频
      */
-    void unregisterThread() {
+    void unregisterThread(int rate_divisor = 1) {
+        const int group = rateGroupIndex(rate_divisor);
+        rate_counts[group].fetch_sub(1, std::memory_order_acq_rel);
         registered_threads--;
-        log_detail("[时钟] 一个线程已注销，总注册线程数: " + std::to_string(registered_threads.load()) + "\n");
+        unbindLatencyRecord();
+        log_detail("[时钟] 一个线程已注销(分频=" + std::to_string(rate_divisors[group]) + ")，总注册线程数: " + std::to_string(registered_threads.load()) + "\n");
+        if (barrier_mode.load(std::memory_order_acquire) == BarrierMode::SpinWait) {
+            // 注销可能使"已完成数 >= 注册数"成立，需要唤醒等待中的主循环重新判断
+            signalArrivalIfComplete();
+        } else {
+            std::lock_guard<std::mutex> lock(mtx);
+            cv_step_end.notify_one();
+        }
+    }
+
+    /**
+     * @brief 设置步进屏障实现方式
+     * @param mode 屏障模式
+     * @note 必须在 start() 之前、任何线程注册之前调用
+     */
+    void setBarrierMode(BarrierMode mode) {
+        if (running.load(std::memory_order_acquire)) {
+            log_detail("[时钟] 警告：时钟运行中，忽略屏障模式切换\n");
+            return;
+        }
+        barrier_mode.store(mode, std::memory_order_release);
+        log_detail(std::string("[时钟] 屏障模式: ") + (mode == BarrierMode::SpinWait ? "SpinWait" : "Mutex") + "\n");
+    }
+
+    /**
+     * @brief 获取步进屏障实现方式
+     */
+    BarrierMode getBarrierMode() const {
+        return barrier_mode.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 把更新周期换算为速率分频
+     * @param period 期望的更新周期（秒）
+     * @return 分频（至少为1），按当前时间步长四舍五入
+     */
+    int divisorForPeriod(double period) const {
+        const double step = dt.load(std::memory_order_acquire);
+        if (period <= step || step <= 0.0) return 1;
+        return static_cast<int>(std::llround(period / step));
+    }
+
+    /**
+     * @brief 判断给定步数是否为该分频的调度步
+     */
+    static bool isStepDue(uint64_t step, int rate_divisor) {
+        return rate_divisor <= 1 || step % static_cast<uint64_t>(rate_divisor) == 0;
+    }
+
+    /**
+     * @brief 设置 SpinWait 模式下进入休眠前的自旋次数
+     * @param limit 自旋次数，0 表示直接休眠
+     */
+    void setSpinLimit(int limit) {
+        spin_limit.store(limit < 0 ? 0 : limit, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 单个参与线程的步内延迟摘要
+     */
+    struct ParticipantLatencySummary {
+        std::string name;      ///< 线程名（ThreadNaming）
+        LatencySummary work;   ///< 被唤醒 → notifyStepCompleted，即本线程每步的执行时间
+        LatencySummary idle;   ///< 上一次 notifyStepCompleted → 下一次被唤醒，即在屏障上等待其他线程的时间
+    };
+
+    /**
+     * @brief 开启或关闭参与线程的延迟统计（默认开启）
+     *
+     * 开启时每个参与线程每步多两次 steady_clock::now() 和两次无锁直方图记录。
+     */
+    void setLatencyTracking(bool enabled) {
+        latency_tracking.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief stop() 时是否把延迟统计报表写入日志（默认关闭，也可在停止后调用 reportLatency()）
+     */
+    void setLatencyReportOnStop(bool enabled) {
+        latency_report_on_stop.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 各参与线程的延迟摘要，按注册顺序排列；同名线程（如重启的控制器）合并统计
+     */
+    std::vector<ParticipantLatencySummary> getLatencySummaries() const {
+        std::lock_guard<std::mutex> lock(latency_mtx);
+        std::vector<ParticipantLatencySummary> result;
+        result.reserve(latency_records.size());
+        for (const auto& record : latency_records) {
+            result.push_back({record->name, record->work.summary(), record->idle.summary()});
+        }
+        return result;
+    }
+
+    /**
+     * @brief 清零所有参与线程的延迟统计
+     */
+    void resetLatency() {
+        std::lock_guard<std::mutex> lock(latency_mtx);
+        for (auto& record : latency_records) {
+            record->work.reset();
+            record->idle.reset();
+        }
+    }
+
+    /**
+     * @brief 延迟统计报表（单位：微秒）
+     *
+     * 执行时间 p99 最大的线程就是拖慢屏障的线程；其等待时间通常最短。
+     */
+    std::string latencyReport() const {
+        const auto summaries = getLatencySummaries();
+        std::ostringstream oss;
+        oss << "[时钟] 参与线程步内延迟（us）: work = 唤醒→完成，idle = 完成→下一次唤醒\n";
+        oss << std::left << std::setw(22) << "  thread" << std::right << std::setw(10) << "count"
+            << std::setw(10) << "work_p50" << std::setw(10) << "p99" << std::setw(10) << "p999" << std::setw(10) << "max"
+            << std::setw(10) << "idle_p50" << std::setw(10) << "p99" << std::setw(10) << "p999" << std::setw(10) << "max" << "\n";
+        oss << std::fixed << std::setprecision(1);
+        auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        for (const auto& s : summaries) {
+            oss << std::left << std::setw(22) << ("  " + s.name) << std::right << std::setw(10) << s.work.count
+                << std::setw(10) << us(s.work.p50) << std::setw(10) << us(s.work.p99)
+                << std::setw(10) << us(s.work.p999) << std::setw(10) << us(s.work.max)
+                << std::setw(10) << us(s.idle.p50) << std::setw(10) << us(s.idle.p99)
+                << std::setw(10) << us(s.idle.p999) << std::setw(10) << us(s.idle.max) << "\n";
+        }
+        return oss.str();
+    }
+
+    /**
+     * @brief 把延迟统计报表写入日志（可在运行中随时调用；setLatencyReportOnStop(true) 时 stop() 自动调用一次）
+     */
+    void reportLatency() const {
+        log_brief(latencyReport());
+    }
+
+    /**
+     * @brief 设置启动前须注册的参与线程数
+     * @param count 常驻参与线程数（如状态空间、事件监测、动力学、数据记录），0 表示不等待（默认）
+     * @note 必须在 start() 之前调用
+     *
+     * 各线程在自己的线程内注册，时钟线程可能先于它们运行；若时钟线程使用实时优先级或
+     * 绑定在同一核心上，未注册的线程会错过大量时间步。设置后 start() 先等待注册数达到
+     * count，再发布第一步。运行中由事件启动的控制器线程不计入。
+     */
+    void setStartParticipants(int count) {
+        start_participants.store(count < 0 ? 0 : count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 设置步结束回调
+     * @param hook 所有参与线程完成一步后、发布下一步前在时钟线程中调用（不持锁），返回 true 时停止时钟
+     * @note 必须在 start() 之前设置，时钟停止后才能清除
+     *
+     * 用于多线程模式下在步内判断停止条件（SimulationControlThread::checkStopConditions），
+     * 仿真恰好在满足条件的那一步结束。外部步进模式不调用，由执行器的停止条件负责。
+     */
+    void setStepEndHook(std::function<bool()> hook) {
+        step_end_hook = std::move(hook);
+    }
+
+    /**
+     * @brief 设置步提交回调
+     * @param hook 所有参与线程完成一步后、步结束回调之前在时钟线程中调用（不持锁）
+     * @note 必须在 start() 之前设置，时钟停止后才能清除
+     *
+     * 用于多线程模式下在步屏障处提交共享状态空间的后缓冲（StateManagerThread::processStep）：
+     * 此时所有参与线程都在等待下一步，提交与读写者没有并发；停止条件看到的是已提交的状态。
+     */
+    void setStepCommitHook(std::function<void()> hook) {
+        step_commit_hook = std::move(hook);
+    }
+
+    /**
+     * @brief 设置时间推进运行模式
+     * @param mode 运行模式
+     * @param time_scale ScaledRealTime 模式下的倍速（>0），其他模式忽略
+     * @note 必须在 start() 之前调用
+     */
+    void setRunMode(RunMode mode, double time_scale = 1.0) {
+        if (running.load(std::memory_order_acquire)) {
+            log_detail("[时钟] 警告：时钟运行中，忽略运行模式切换\n");
+            return;
+        }
+        run_mode = mode;
+        pace_scale = (mode == RunMode::ScaledRealTime && time_scale > 0.0) ? time_scale : 1.0;
+        log_detail("[时钟] 运行模式: " + runModeName(mode) + "，倍速: " + std::to_string(pace_scale) + "\n");
+    }
+
+    /**
+     * @brief 获取时间推进运行模式
+     */
+    RunMode getRunMode() const {
+        return run_mode;
+    }
+
+    /**
+     * @brief 获取本次（或最近一次）运行的统计
+     */
+    RunStats getRunStats() const {
+        RunStats stats;
+        stats.steps = time_steps.load(std::memory_order_acquire) - run_start_steps;
+        stats.sim_elapsed = current_time.load(std::memory_order_acquire) - run_start_sim_time;
+        const int64_t end_ns = running.load(std::memory_order_acquire)
+            ? std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - run_start_wall).count()
+            : run_end_ns.load(std::memory_order_acquire);
+        stats.wall_elapsed = std::max<int64_t>(0, end_ns - paused_ns.load(std::memory_order_acquire)) * 1e-9;
+        stats.real_time_factor = stats.wall_elapsed > 0.0 ? stats.sim_elapsed / stats.wall_elapsed : 0.0;
+        stats.overruns = overrun_count.load(std::memory_order_acquire);
+        stats.max_lag = max_lag_ns.load(std::memory_order_acquire) * 1e-9;
+        return stats;
+    }
+
+    /**
+     * @brief 把本次（或最近一次）运行的统计写入日志（stop() 不再自动输出，由调用方在时钟停止后按需调用）
+     */
+    void reportRunStats() const {
+        const RunStats stats = getRunStats();
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3)
+            << "[时钟] 运行统计: 模式=" << runModeName(run_mode)
+            << ", 步数=" << stats.steps
+            << ", 仿真时间=" << stats.sim_elapsed << "s"
+            << ", 墙钟时间=" << stats.wall_elapsed << "s"
+            << ", 实时因子=" << stats.real_time_factor;
+        if (run_mode != RunMode::AsFastAsPossible) {
+            oss << " (目标 " << pace_scale << ")"
+                << ", 超时步数=" << stats.overruns
+                << ", 最大滞后=" << stats.max_lag * 1000.0 << "ms";
+        }
+        oss << "\n";
+        log_brief(oss.str());
     }
 
     /**
@@ -57,26 +366,38 @@ public:
      */
     void start() {
         if (running) return;
+        beginRun();
         running = true;
         paused = false;
+        completed_threads = 0;
+        waitForStartParticipants();
         log_detail("[时钟] 主循环开始，初始化步骤完成标志\n");
 
+        if (barrier_mode.load(std::memory_order_acquire) == BarrierMode::SpinWait) {
+            runSpinBarrierLoop();
+            log_detail("[时钟] 主循环结束\n");
+            return;
+        }
+
         // 先推进一次时间，唤醒所有线程进入第一步
+        paceStep(current_time.load() + dt.load());
         {
             std::unique_lock<std::mutex> lock(mtx);
-            current_time.store(current_time.load() + dt);
+            current_time.store(current_time.load() + dt.load());
             time_steps++;
             log_detail("[时钟] (初始化) 时间步推进: 时间=" + std::to_string(current_time.load()) + ", 步数=" + std::to_string(time_steps.load()) + "\n");
-            cv_step_start.notify_all();
+            notifyDueGroups(time_steps.load());
         }
 
         while (running.load(std::memory_order_acquire)) {
             std::unique_lock<std::mutex> lock(mtx);
 
             // 1. 等待所有已注册线程完成上一步
-            log_detail("[时钟] 等待所有线程完成当前步骤: completed=" + std::to_string(completed_threads.load()) + ", registered=" + std::to_string(registered_threads.load()) + "\n");
+            if (traceEnabled()) {
+                log_detail("[时钟] 等待所有线程完成当前步骤: completed=" + std::to_string(completed_threads.load()) + ", expected=" + std::to_string(expectedParticipants(time_steps.load())) + "\n");
+            }
             cv_step_end.wait(lock, [this] {
-                return completed_threads.load() >= registered_threads.load() || !running.load();
+                return completed_threads.load() >= expectedParticipants(time_steps.load()) || !running.load();
             });
 
             if (!running.load()) break;
@@ -84,35 +405,112 @@ public:
             // 重置完成计数器
             completed_threads = 0;
 
-            // 2. 检查是否暂停，如果暂停则等待恢复
+            // 2. 步提交回调与步结束回调（停止条件）：参与线程都在等待下一步，回调可能调用 stop()，不持锁调用
+            if (step_commit_hook) {
+                lock.unlock();
+                step_commit_hook();
+                lock.lock();
+            }
+            if (step_end_hook) {
+                lock.unlock();
+                const bool stop_now = step_end_hook();
+                if (stop_now) {
+                    stop();
+                    break;
+                }
+                lock.lock();
+            }
+
+            // 3. 检查是否暂停，如果暂停则等待恢复
             while (paused.load() && running.load()) {
                 log_detail("[时钟] 仿真暂停中，等待恢复...\n");
-                cv_step_start.wait(lock, [this] {
-                    return !paused.load() || !running.load();
-                });
+                waitForResume(lock);
                 if (!running.load()) break;
             }
 
             if (!running.load()) break;
 
-            // 3. 推进时间并通知所有线程开始新步骤
-            current_time.store(current_time.load() + dt);
+            // 4. 节拍模式下等到本步的墙钟截止时间（不持锁睡眠）
+            if (run_mode != RunMode::AsFastAsPossible) {
+                lock.unlock();
+                paceStep(current_time.load() + dt.load());
+                lock.lock();
+                if (!running.load()) break;
+            }
+
+            // 5. 推进时间并通知所有线程开始新步骤
+            current_time.store(current_time.load() + dt.load());
             time_steps++;
-            log_detail("[时钟] 时间步推进: 时间=" + std::to_string(current_time.load()) + ", 步数=" + std::to_string(time_steps.load()) + "\n");
-            cv_step_start.notify_all();
+            if (traceEnabled()) {
+                log_detail("[时钟] 时间步推进: 时间=" + std::to_string(current_time.load()) + ", 步数=" + std::to_string(time_steps.load()) + "\n");
+            }
+            notifyDueGroups(time_steps.load());
         }
         log_detail("[时钟] 主循环结束\n");
     }
 
+    /**
+     * @brief 以外部步进方式启动时钟（单线程执行器使用）
+     *
+     * 只设置运行状态，不进入屏障主循环；时间由 advanceStep() 推进。
+     */
+    void startExternalStepping() {
+        if (running) return;
+        beginRun();
+        running = true;
+        paused = false;
+        log_detail("[时钟] 外部步进模式启动\n");
+    }
+
+    /**
+     * @brief 外部步进：推进一个时间步
+     *
+     * 不经过屏障，由调用线程（单线程执行器）直接推进时间和步数；节拍模式下先等到本步截止时间。
+     */
+    void advanceStep() {
+        paceStep(current_time.load(std::memory_order_relaxed) + dt.load(std::memory_order_relaxed));
+        current_time.store(current_time.load(std::memory_order_relaxed) + dt.load(std::memory_order_relaxed),
+                           std::memory_order_release);
+        time_steps.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 外部步进模式下等待暂停解除
+     * @return 时钟仍在运行返回true
+     */
+    bool waitWhilePaused() {
+        if (!paused.load(std::memory_order_acquire)) return running.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mtx);
+        waitForResume(lock);
+        return running.load(std::memory_order_acquire);
+    }
+
     /**
      * @brief 停止仿真时钟
      * 
      * 设置运行状态为false，并通知所有等待的线程
      */
     void stop() {
-        running = false;
-        cv_step_start.notify_all();
-        cv_step_end.notify_all();
+        if (running.exchange(false)) {
+            run_end_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - run_start_wall).count(), std::memory_order_release);
+            if (latency_report_on_stop.load(std::memory_order_relaxed) && latency_tracking.load(std::memory_order_relaxed)) {
+                reportLatency();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            cv_step_start.notify_all();
+            cv_step_end.notify_all();
+            for (auto& cv : cv_group) cv.notify_all();
+        }
+        // SpinWait 模式：翻转所有纪元，唤醒所有在 atomic::wait 上休眠的线程
+        for (auto& epoch : group_epoch) {
+            epoch.fetch_add(1, std::memory_order_release);
+            SpinWait::notifyAll(epoch);
+        }
+        arrival_epoch.fetch_add(1, std::memory_order_release);
+        SpinWait::notifyAll(arrival_epoch);
     }
 
     /**
@@ -131,7 +529,11 @@ public:
      * 设置暂停状态为false，时钟将继续推进时间
      */
     void resume() {
-        paused = false;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            paused = false;
+        }
+        cv_step_start.notify_all();
         log_detail("[时钟] 仿真已恢复\n");
     }
 
@@ -167,8 +569,7 @@ public:
      * @return double 时间步长（秒）
      */
     double getTimeStep() const {
-        std::lock_guard<std::mutex> lock(mtx);
-        return dt;
+        return dt.load(std::memory_order_acquire);
     }
 
     /**
@@ -181,31 +582,56 @@ public:
 
     /**
      * @brief 等待下一个时间步
+     * @param last_processed_step 本线程上次处理的步数
+     * @param rate_divisor 速率分频，须与注册时一致；只在步数为其整数倍时返回
      */
-    void waitForNextStep(size_t last_processed_step) {
+    void waitForNextStep(size_t last_processed_step, int rate_divisor = 1) {
+        const int group = rateGroupIndex(rate_divisor);
+        const int divisor = rate_divisors[group];
+        if (barrier_mode.load(std::memory_order_acquire) == BarrierMode::SpinWait) {
+            spinWaitForNextStep(last_processed_step, group, divisor);
+            markLatencyWakeup();
+            return;
+        }
+        const bool trace = traceEnabled();
         // 日志：进入 waitForNextStep
-        log_detail("[时钟] 线程(" + ThreadNaming::get_current_thread_name() +
-                          ") 进入 waitForNextStep(), 等待步数 > " + std::to_string(last_processed_step) + "\n");
+        if (trace) {
+            log_detail("[时钟] 线程(" + ThreadNaming::get_current_thread_name() +
+                              ") 进入 waitForNextStep(), 等待步数 > " + std::to_string(last_processed_step) + "\n");
+        }
         std::unique_lock<std::mutex> lock(mtx);
         
-        // 等待时钟步数超过上次处理的步数
-        cv_step_start.wait(lock, [this, last_processed_step] { 
-            return time_steps.load() > last_processed_step || !running; 
+        // 等待时钟步数超过上次处理的步数，且为本线程的调度步
+        cv_group[group].wait(lock, [this, last_processed_step, divisor] { 
+            const uint64_t step = time_steps.load();
+            return (step > last_processed_step && isStepDue(step, divisor)) || !running; 
         });
-
-        log_detail("[时钟] 线程(" + ThreadNaming::get_current_thread_name() + ") 收到时间步通知，步数=" + std::to_string(time_steps.load()) + "\n");
-        // 日志：离开 waitForNextStep
-        log_detail("[时钟] 线程(" + ThreadNaming::get_current_thread_name() +
-                          ") 离开 waitForNextStep(), 步数=" + std::to_string(time_steps.load()) + "\n");
+        lock.unlock();
+        markLatencyWakeup();
+
+        if (trace) {
+            log_detail("[时钟] 线程(" + ThreadNaming::get_current_thread_name() + ") 收到时间步通知，步数=" + std::to_string(time_steps.load()) + "\n");
+            // 日志：离开 waitForNextStep
+            log_detail("[时钟] 线程(" + ThreadNaming::get_current_thread_name() +
+                              ") 离开 waitForNextStep(), 步数=" + std::to_string(time_steps.load()) + "\n");
+        }
     }
 
     /**
      * @brief 通知时钟当前步骤已完成
      */
     void notifyStepCompleted() {
+        markLatencyCompleted();
+        if (barrier_mode.load(std::memory_order_acquire) == BarrierMode::SpinWait) {
+            int done = completed_threads.fetch_add(1, std::memory_order_acq_rel) + 1;
+            if (done >= expectedParticipants(time_steps.load(std::memory_order_acquire))) {
+                signalArrival();
+            }
+            return;
+        }
         std::lock_guard<std::mutex> lock(mtx);
         completed_threads++;
-        log_detail("[时钟] 线程(" + ThreadNaming::get_current_thread_name() + ") 通知步骤已完成，completed_threads=" + std::to_string(completed_threads.load()) + "/" + std::to_string(registered_threads.load()) + "\n");
+        if (traceEnabled()) log_detail("[时钟] 线程(" + ThreadNaming::get_current_thread_name() + ") 通知步骤已完成，completed_threads=" + std::to_string(completed_threads.load()) + "/" + std::to_string(expectedParticipants(time_steps.load())) + "\n");
         cv_step_end.notify_one();
     }
 
@@ -218,68 +644,374 @@ public:
     }
 
     void setTimeStep(double new_dt) {
-        std::lock_guard<std::mutex> lock(mtx);
-        dt = new_dt;
+        dt.store(new_dt, std::memory_order_release);
+    }
+
+    /**
+     * @brief 写入检查点：当前仿真时间、步数、步长
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.beginSection("CLCK");
+        writer.write(current_time);
+        writer.write(time_steps);
+        writer.write(dt);
+    }
+
+    /**
+     * @brief 从检查点恢复时间、步数、步长（时钟必须处于停止状态）
+     * @return 时钟运行中返回 false，不做任何修改
+     */
+    bool restoreCheckpoint(CheckpointReader& reader) {
+        if (running.load(std::memory_order_acquire)) {
+            log_detail("[时钟] 警告：时钟运行中，不能从检查点恢复\n");
+            return false;
+        }
+        if (!reader.expectSection("CLCK")) return false;
+        reader.read(current_time);
+        reader.read(time_steps);
+        reader.read(dt);
+        return reader.ok();
     }
 
+    ~SimulationClock() = default;
+    SimulationClock(const SimulationClock&) = delete;
+    SimulationClock& operator=(const SimulationClock&) = delete;
+
 private:
-    static SimulationClock* instance;
     mutable std::mutex mtx;
     std::condition_variable cv_step_start;
     std::condition_variable cv_step_end;
     std::atomic<uint64_t> time_steps{0};
-    double dt;
+    std::atomic<double> dt;
 
     std::atomic<bool> running{false};
     std::atomic<double> current_time{0.0};
     std::atomic<int> registered_threads{0};
-    std::atomic<int> waiting_threads{0};
+    std::atomic<int> start_participants{0};  ///< start() 发布第一步前须注册的线程数
+    std::function<bool()> step_end_hook;     ///< 步结束回调，只在 start() 之前设置
+    std::function<void()> step_commit_hook;  ///< 步提交回调，只在 start() 之前设置
+
+    // 参与线程延迟统计：记录按线程名合并，只追加不删除；时间戳保存在线程局部的绑定中
+    struct ParticipantLatency {
+        std::string name;
+        LatencyHistogram work;   ///< 唤醒 → 完成
+        LatencyHistogram idle;   ///< 完成 → 下一次唤醒
+    };
+    struct LatencyBinding {
+        const SimulationClock* clock = nullptr;   ///< 绑定的时钟（进程内可有多个时钟）
+        ParticipantLatency* record = nullptr;
+        int64_t wake_ns = 0;                      ///< 本步被唤醒的时刻，0 表示尚未唤醒
+        int64_t last_done_ns = 0;                 ///< 上一步完成的时刻，0 表示尚未完成过
+    };
+    std::atomic<bool> latency_tracking{true};
+    std::atomic<bool> latency_report_on_stop{false};
+    mutable std::mutex latency_mtx;
+    std::vector<std::unique_ptr<ParticipantLatency>> latency_records;
     std::atomic<int> completed_threads{0};
     std::atomic<bool> paused{false};
 
+    // SpinWait 屏障状态：两个 32 位纪元字（futex 友好），各自只朝一个方向翻转
+    std::atomic<BarrierMode> barrier_mode{BarrierMode::Mutex};
+    std::atomic<uint32_t> arrival_epoch{0};  ///< 最后一个到达的线程翻转，主循环在其上等待
+    std::atomic<int> spin_limit{SpinWait::defaultSpinLimit()};
+
+    // 速率组：分频只追加不删除，组数以 release 发布，读取方无锁扫描
+    int rate_divisors[kMaxRateGroups] = {1};                    ///< 各组分频，组0固定为1
+    std::atomic<int> rate_group_count{1};                       ///< 已分配的组数
+    std::atomic<int> rate_counts[kMaxRateGroups] = {};          ///< 各组已注册线程数
+    std::condition_variable cv_group[kMaxRateGroups];           ///< Mutex 模式：各组的步骤开始通知
+    std::atomic<uint32_t> group_epoch[kMaxRateGroups] = {};     ///< SpinWait 模式：组的调度步发布时翻转，组内线程在其上等待
+
+    // 运行模式与节拍状态：只在 start() 之前配置，节拍由推进时间的线程（主循环或外部执行器）独占
+    RunMode run_mode{RunMode::AsFastAsPossible};
+    double pace_scale{1.0};                                 ///< 倍速，RealTime 为 1
+    std::chrono::steady_clock::time_point run_start_wall;   ///< 本次运行开始的墙钟时刻
+    std::chrono::steady_clock::time_point pace_origin;      ///< 节拍基准时刻（暂停后顺延）
+    double run_start_sim_time{0.0};                         ///< 本次运行开始时的仿真时间
+    uint64_t run_start_steps{0};                            ///< 本次运行开始时的步数
+    std::atomic<int64_t> run_end_ns{0};                     ///< 运行结束时刻（相对 run_start_wall，纳秒）
+    std::atomic<int64_t> paused_ns{0};                      ///< 累计暂停时长（纳秒）
+    std::atomic<uint64_t> overrun_count{0};                 ///< 错过截止时间的步数
+    std::atomic<int64_t> max_lag_ns{0};                     ///< 最大滞后（纳秒）
+
+    static std::string runModeName(RunMode mode) {
+        switch (mode) {
+            case RunMode::AsFastAsPossible: return "AsFastAsPossible";
+            case RunMode::RealTime: return "RealTime";
+            case RunMode::ScaledRealTime: return "ScaledRealTime";
+        }
+        return "Unknown";
+    }
+
     /**
-     * @brief 私有构造函数
-     * 
-     * 初始化时钟状态：
-     * - 当前时间设为0
-     * - 上一步时间设为0
-     * - 运行状态设为false
+     * @brief 查找（必要时分配）分频对应的速率组
+     * @return 组下标；组数已满时退化为组0（每步参与）
      */
-    SimulationClock(double step_size = 0.01) : dt(step_size) {}
+    int rateGroupIndex(int rate_divisor) {
+        if (rate_divisor <= 1) return 0;
+        const int count = rate_group_count.load(std::memory_order_acquire);
+        for (int g = 0; g < count; ++g) {
+            if (rate_divisors[g] == rate_divisor) return g;
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        const int locked_count = rate_group_count.load(std::memory_order_relaxed);
+        for (int g = 0; g < locked_count; ++g) {
+            if (rate_divisors[g] == rate_divisor) return g;
+        }
+        if (locked_count >= kMaxRateGroups) {
+            log_detail("[时钟] 警告：速率组已满，分频 " + std::to_string(rate_divisor) + " 按每步参与处理\n");
+            return 0;
+        }
+        rate_divisors[locked_count] = rate_divisor;
+        rate_group_count.store(locked_count + 1, std::memory_order_release);
+        return locked_count;
+    }
 
     /**
-     * @brief 默认析构函数
+     * @brief 第 step 步需要等待的参与线程数（调度到该步的各组注册数之和）
      */
-    ~SimulationClock() {
-        if (master_thread.joinable()) {
-            master_thread.join();
+    int expectedParticipants(uint64_t step) const {
+        const int count = rate_group_count.load(std::memory_order_acquire);
+        int expected = 0;
+        for (int g = 0; g < count; ++g) {
+            if (isStepDue(step, rate_divisors[g])) expected += rate_counts[g].load(std::memory_order_acquire);
         }
+        return expected;
     }
 
     /**
-     * @brief 删除拷贝构造函数
+     * @brief Mutex 模式：只唤醒第 step 步调度到的组（调用方持有 mtx）
      */
-    SimulationClock(const SimulationClock&) = delete;
+    void notifyDueGroups(uint64_t step) {
+        const int count = rate_group_count.load(std::memory_order_acquire);
+        for (int g = 0; g < count; ++g) {
+            if (isStepDue(step, rate_divisors[g])) cv_group[g].notify_all();
+        }
+    }
+
+    static LatencyBinding& latencyBinding() {
+        static thread_local LatencyBinding binding;
+        return binding;
+    }
+
+    static int64_t latencyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 
     /**
-     * @brief 删除赋值运算符
+     * @brief 注册时把当前线程绑定到以其线程名命名的延迟记录
      */
-    SimulationClock& operator=(const SimulationClock&) = delete;
+    void bindLatencyRecord() {
+        const std::string name = ThreadNaming::get_current_thread_name();
+        ParticipantLatency* record = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(latency_mtx);
+            for (auto& existing : latency_records) {
+                if (existing->name == name) {
+                    record = existing.get();
+                    break;
+                }
+            }
+            if (!record) {
+                latency_records.push_back(std::make_unique<ParticipantLatency>());
+                record = latency_records.back().get();
+                record->name = name;
+            }
+        }
+        latencyBinding() = LatencyBinding{this, record, 0, 0};
+    }
+
+    void unbindLatencyRecord() {
+        LatencyBinding& binding = latencyBinding();
+        if (binding.clock == this) binding = LatencyBinding{};
+    }
+
+    /**
+     * @brief 参与线程被唤醒：记录等待时间（上一次完成 → 本次唤醒）
+     */
+    void markLatencyWakeup() {
+        LatencyBinding& binding = latencyBinding();
+        if (binding.clock != this || !latency_tracking.load(std::memory_order_relaxed)) return;
+        binding.wake_ns = latencyNowNs();
+        if (binding.last_done_ns != 0) binding.record->idle.record(static_cast<uint64_t>(binding.wake_ns - binding.last_done_ns));
+    }
+
+    /**
+     * @brief 参与线程完成本步：记录执行时间（本次唤醒 → 完成）
+     */
+    void markLatencyCompleted() {
+        LatencyBinding& binding = latencyBinding();
+        if (binding.clock != this || !latency_tracking.load(std::memory_order_relaxed)) return;
+        binding.last_done_ns = latencyNowNs();
+        if (binding.wake_ns != 0) binding.record->work.record(static_cast<uint64_t>(binding.last_done_ns - binding.wake_ns));
+        binding.wake_ns = 0;
+    }
+
+    /**
+     * @brief 等待常驻参与线程注册（见 setStartParticipants）
+     */
+    void waitForStartParticipants() {
+        const int expected = start_participants.load(std::memory_order_relaxed);
+        if (expected <= 0) return;
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_step_end.wait(lock, [this, expected] {
+            return registered_threads.load() >= expected || !running.load();
+        });
+        log_detail("[时钟] " + std::to_string(registered_threads.load()) + " 个参与线程已注册，开始发布时间步\n");
+        beginRun(); // 墙钟统计从第一步开始，不含等待注册的时间
+    }
+
+    /**
+     * @brief 记录本次运行的起点并清零统计（含延迟统计，报表只反映本次运行）
+     */
+    void beginRun() {
+        resetLatency();
+        run_start_wall = std::chrono::steady_clock::now();
+        pace_origin = run_start_wall;
+        run_start_sim_time = current_time.load(std::memory_order_acquire);
+        run_start_steps = time_steps.load(std::memory_order_acquire);
+        run_end_ns.store(0, std::memory_order_relaxed);
+        paused_ns.store(0, std::memory_order_relaxed);
+        overrun_count.store(0, std::memory_order_relaxed);
+        max_lag_ns.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 节拍：等到仿真时间 next_sim_time 对应的墙钟截止时间
+     * @param next_sim_time 即将发布的步骤的仿真时间
+     *
+     * 截止时间 = 节拍基准 + (next_sim_time - 起始仿真时间) / 倍速，是绝对时刻而非相对睡眠，
+     * 因此某一步睡过头或计算超时后，后续步骤会自动追回，误差不累积。
+     * 到达时已超过截止时间的步骤计为一次超时。
+     */
+    void paceStep(double next_sim_time) {
+        if (run_mode == RunMode::AsFastAsPossible) return;
+        const auto deadline = pace_origin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>((next_sim_time - run_start_sim_time) / pace_scale));
+        const auto now = std::chrono::steady_clock::now();
+        if (now < deadline) {
+            std::this_thread::sleep_until(deadline);
+            return;
+        }
+        overrun_count.fetch_add(1, std::memory_order_relaxed);
+        const int64_t lag = std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline).count();
+        if (lag > max_lag_ns.load(std::memory_order_relaxed)) {
+            max_lag_ns.store(lag, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 在 cv_step_start 上等待暂停解除，并把暂停时长从节拍和统计中扣除
+     * @param lock 已持有的 mtx 锁
+     */
+    void waitForResume(std::unique_lock<std::mutex>& lock) {
+        const auto pause_begin = std::chrono::steady_clock::now();
+        cv_step_start.wait(lock, [this] {
+            return !paused.load() || !running.load();
+        });
+        const auto pause_length = std::chrono::steady_clock::now() - pause_begin;
+        pace_origin += pause_length;
+        paused_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(pause_length).count(),
+                            std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 详细日志是否开启，关闭时跳过每步日志字符串的拼接
+     */
+    bool traceEnabled() const {
+        return Logger::getInstance().isEnabled();
+    }
 
-    std::thread master_thread;
+    /**
+     * @brief SpinWait 模式：推进时间并发布新步骤
+     *
+     * 完成计数必须在发布前清零：参与线程一旦观察到新的步数就可能立即到达。
+     */
+    void publishSpinStep() {
+        completed_threads.store(0, std::memory_order_relaxed);
+        current_time.store(current_time.load(std::memory_order_relaxed) + dt.load(std::memory_order_relaxed),
+                           std::memory_order_release);
+        const uint64_t step = time_steps.fetch_add(1, std::memory_order_release) + 1;
+        const int count = rate_group_count.load(std::memory_order_acquire);
+        for (int g = 0; g < count; ++g) {
+            if (isStepDue(step, rate_divisors[g])) {
+                group_epoch[g].fetch_add(1, std::memory_order_release);
+                SpinWait::notifyAll(group_epoch[g]);
+            }
+        }
+    }
 
-    void masterLoop() {
+    /**
+     * @brief SpinWait 模式主循环
+     *
+     * 发布步骤（翻转调度组的 group_epoch）→ 等待本步调度的线程全部到达（arrival_epoch 被最后到达者翻转）→ 下一步。
+     * 等待前先读取纪元再检查条件，条件在两者之间成立时纪元必然已变化，不会丢失唤醒。
+     */
+    void runSpinBarrierLoop() {
+        paceStep(current_time.load(std::memory_order_relaxed) + dt.load(std::memory_order_relaxed));
+        publishSpinStep();
         while (running.load(std::memory_order_acquire)) {
-            std::unique_lock<std::mutex> lock(mtx);
+            uint32_t seen = arrival_epoch.load(std::memory_order_acquire);
+            while (running.load(std::memory_order_acquire) &&
+                   completed_threads.load(std::memory_order_acquire) < expectedParticipants(time_steps.load(std::memory_order_acquire))) {
+                SpinWait::waitWhileEqual(arrival_epoch, seen, spin_limit.load(std::memory_order_relaxed));
+                seen = arrival_epoch.load(std::memory_order_acquire);
+            }
+            if (!running.load(std::memory_order_acquire)) break;
 
-            // 更新时间和步数
-            current_time.store(current_time.load(std::memory_order_acquire) + dt, std::memory_order_release);
-            time_steps++;
-            log_detail("  [时钟] 时间步更新: 时间=" + std::to_string(current_time.load(std::memory_order_acquire)) + ", 步数=" + std::to_string(time_steps.load(std::memory_order_acquire)) + "\n");
+            if (step_commit_hook) step_commit_hook();
+            if (step_end_hook && step_end_hook()) {
+                stop();
+                break;
+            }
+
+            if (paused.load(std::memory_order_acquire)) {
+                std::unique_lock<std::mutex> lock(mtx);
+                log_detail("[时钟] 仿真暂停中，等待恢复...\n");
+                waitForResume(lock);
+                if (!running.load()) break;
+            }
 
-            // 等待一个时间步
-            std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(dt * 1000)));
+            paceStep(current_time.load(std::memory_order_relaxed) + dt.load(std::memory_order_relaxed));
+            if (!running.load(std::memory_order_acquire)) break;
+            publishSpinStep();
+        }
+    }
+
+    /**
+     * @brief SpinWait 模式：参与线程等待步数超过 last_processed_step 且为本组的调度步
+     */
+    void spinWaitForNextStep(size_t last_processed_step, int group, int divisor) {
+        const int limit = spin_limit.load(std::memory_order_relaxed);
+        std::atomic<uint32_t>& epoch = group_epoch[group];
+        while (true) {
+            uint32_t seen = epoch.load(std::memory_order_acquire);
+            const uint64_t step = time_steps.load(std::memory_order_acquire);
+            if ((step > last_processed_step && isStepDue(step, divisor)) ||
+                !running.load(std::memory_order_acquire)) {
+                return;
+            }
+            SpinWait::waitWhileEqual(epoch, seen, limit);
+        }
+    }
+
+    /**
+     * @brief SpinWait 模式：翻转到达纪元并唤醒主循环
+     */
+    void signalArrival() {
+        arrival_epoch.fetch_add(1, std::memory_order_release);
+        SpinWait::notifyOne(arrival_epoch);
+    }
+
+    /**
+     * @brief SpinWait 模式：若所有仍注册的线程均已到达，则唤醒主循环
+     *
+     * 可能与最后到达者重复翻转纪元，主循环会重新检查计数，重复翻转无害。
+     */
+    void signalArrivalIfComplete() {
+        if (completed_threads.load(std::memory_order_acquire) >= expectedParticipants(time_steps.load(std::memory_order_acquire))) {
+            signalArrival();
         }
-        log_detail("  [时钟] 主循环结束\n");
     }
 }; 
\ No newline at end of file
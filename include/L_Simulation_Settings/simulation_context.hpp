@@ -0,0 +1,53 @@
+/*
+ * @file simulation_context.hpp
+ * @brief 仿真上下文头文件
+ *
+ * 一个仿真上下文持有一次仿真独占的时钟、共享状态空间和事件总线。
+ * 构造时把时钟绑定到状态空间（SharedStateSpace::setClock），此后用该状态空间构造的
+ * 控制器、事件监控、初始状态等组件都通过 state.clock() 使用本上下文的时钟，
+ * 因此同一进程内可以同时运行多个互不干扰的仿真（见 BatchRunner）。
+ *
+ * 典型用法：
+ *   SimulationContext ctx;                       // 默认同步事件总线，配合 FusedStepExecutor
+ *   AbortTakeoffInitialState::initializeMotionState(ctx.state, aircraftConfig);
+ *   ControllerManagerThread manager(ctx.state, ctx.bus);
+ *   FusedStepExecutor executor(ctx.clock, ctx.state);
+ */
+
+#pragma once
+
+// ParaSAFE系统头文件
+#include "simulation_clock.hpp"                 // 仿真时钟
+#include "../K_Scenario/shared_state.hpp"       // 共享状态空间
+#include "../K_Scenario/event_bus.hpp"          // 事件总线
+
+/**
+ * @struct SimulationContext
+ * @brief 一次仿真独占的时钟、状态空间和事件总线
+ *
+ * 成员按依赖顺序声明：事件总线引用状态空间，状态空间引用时钟。
+ */
+struct SimulationContext {
+    SimulationClock clock;      ///< 本仿真的时钟
+    SharedStateSpace state;     ///< 本仿真的共享状态空间（已绑定 clock）
+    EventBus bus;               ///< 本仿真的事件总线
+
+    /**
+     * @brief 构造仿真上下文
+     * @param mode 事件总线分发模式，批量仿真使用单线程执行器时应为 Synchronous
+     * @param step_size 时间步长（秒），场景初始状态通常会按配置重新设置
+     */
+    explicit SimulationContext(EventBus::DispatchMode mode = EventBus::DispatchMode::Synchronous,
+                               double step_size = 0.01)
+        : clock(step_size), bus(bindClock(state, clock), mode) {}
+
+    SimulationContext(const SimulationContext&) = delete;
+    SimulationContext& operator=(const SimulationContext&) = delete;
+
+private:
+    // 在事件总线构造之前把时钟绑定到状态空间
+    static SharedStateSpace& bindClock(SharedStateSpace& state, SimulationClock& clock) {
+        state.setClock(clock);
+        return state;
+    }
+};
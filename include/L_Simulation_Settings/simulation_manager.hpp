@@ -1,18 +1,24 @@
 #pragma once
 
 #include <iostream>
-#include <windows.h>
 #include <thread>
 #include <chrono>
 #include <atomic>
 #include <memory>
 #include <sstream>
 #include <iomanip>
+#include <mutex>
 #include "../K_Scenario/shared_state.hpp"
 #include "../K_Scenario/event_bus.hpp"
 #include "../L_Simulation_Settings/simulation_clock.hpp"
+#include "../L_Simulation_Settings/stop_conditions.hpp"
+#include "../L_Simulation_Settings/control_channel.hpp"
+#include "../L_Simulation_Settings/deterministic_replay.hpp"
 
 // 仿真控制线程类
+//
+// 停止条件在步内求值（执行器的停止条件或时钟的步结束回调），仿真恰好在满足条件的步结束；
+// 暂停/恢复/结束命令来自本地控制通道（见 control_channel.hpp），控制线程阻塞在通道上，不轮询。
 class SimulationControlThread {
 private:
     SharedStateSpace& state;
@@ -20,91 +26,89 @@ private:
     std::thread control_thread;
     std::atomic<bool> running{false};
     std::atomic<bool> paused{false};
+    StopConditionSet stop_conditions = StopConditions::defaults();
+    std::mutex stop_mutex;
+    std::string stop_reason;
+    ControlChannel channel;
+    bool hook_installed = false;
+    DeterministicSession* session = nullptr;
 
     void run() {
+        ThreadNaming::set_current_thread_name("SimulationControl");
         log_detail("[仿真控制] 仿真控制线程已启动\n");
-        log_detail("[仿真控制] 按空格键暂停/恢复仿真，按ESC键结束仿真\n");
-        
-        bool last_space_pressed = false;
-        bool last_esc_pressed = false;
-        
-        while (running) {
-            // 检查空格键（暂停/恢复）
-            bool space_pressed = (GetAsyncKeyState(VK_SPACE) & 0x8000) != 0;
-            if (space_pressed && !last_space_pressed) {
-                if (paused.load()) {
-                    // 恢复仿真
-                    paused.store(false);
-                    state.simulation_running.store(true);
-                    SimulationClock::getInstance().resume();
-                    log_detail("[仿真控制] 仿真已恢复\n");
-                } else {
-                    // 暂停仿真
-                    paused.store(true);
-                    state.simulation_running.store(false);
-                    SimulationClock::getInstance().pause();
-                    log_detail("[仿真控制] 仿真已暂停\n");
-                }
-            }
-            last_space_pressed = space_pressed;
-            
-            // 检查ESC键（结束仿真）
-            bool esc_pressed = (GetAsyncKeyState(VK_ESCAPE) & 0x8000) != 0;
-            if (esc_pressed && !last_esc_pressed) {
-                log_detail("[仿真控制] 用户按ESC键，准备结束仿真\n");
-                state.simulation_running.store(false);
-                SimulationClock::getInstance().stop();
-                break;
-            }
-            last_esc_pressed = esc_pressed;
-            
-            // 检查位置或时间超限条件
-            if (state.position.load() > 1500.0 || state.simulation_time.load() > 180.0) {
-                double current_position = state.position.load();
-                double current_time = state.simulation_time.load();
-                
-                std::ostringstream oss;
-                oss << "[仿真控制] 检测到仿真停止条件：\n";
-                oss << "  当前位置: " << std::fixed << std::setprecision(2) << current_position << "m\n";
-                oss << "  当前时间: " << std::fixed << std::setprecision(2) << current_time << "s\n";
-                
-                if (current_position > 1000.0) {
-                    oss << "  停止原因: 位置超过1000米限制\n";
-                }
-                if (current_time > 60.0) {
-                    oss << "  停止原因: 时间超过60秒限制\n";
-                }
-                oss << "[仿真控制] 自动结束仿真\n";
-                
-                log_detail(oss.str());
-                state.simulation_running.store(false);
-                SimulationClock::getInstance().stop();
-                break;
-            }
-            
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-        }
-        
+        log_detail("[仿真控制] 向 " + channel.path() + " 写入 pause / resume / stop 控制仿真\n");
+        channel.run([this](const std::string& command) { handleCommand(command); });
         log_detail("[仿真控制] 仿真控制线程已结束\n");
     }
 
+    void requestStop(const std::string& reason) {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex);
+            if (stop_reason.empty()) stop_reason = reason;
+        }
+        state.setSimulationRunning(false);
+        state.clock().stop();
+    }
+
 public:
-    SimulationControlThread(SharedStateSpace& state, EventBus& bus) 
+    SimulationControlThread(SharedStateSpace& state, EventBus& bus)
         : state(state), bus(bus) {}
 
+    ~SimulationControlThread() { stop(); }
+
+    /**
+     * @brief 设置本场景的停止条件（替换默认的位置 1500 米 / 时间 180 秒限制）
+     * @note 须在 start() 或执行器运行之前调用
+     */
+    void setStopConditions(StopConditionSet conditions) { stop_conditions = std::move(conditions); }
+
+    /**
+     * @brief 追加一个停止条件
+     */
+    void addStopCondition(StopCondition condition) { stop_conditions.add(std::move(condition)); }
+
+    /**
+     * @brief 设置控制通道路径（须在 start() 之前调用）
+     */
+    void setControlChannelPath(const std::string& path) { channel.setPath(path); }
+
+    /**
+     * @brief 设置确定性记录/回放会话（融合执行器 / 任务图执行器，须在运行之前调用）
+     *
+     * 设置后 stop 命令不再立即执行，而是交给会话，在下一个步结束时由 checkStopConditions() 施加；
+     * 回放模式下 stop 命令来自回放日志。暂停/恢复不影响计算结果，仍立即执行。
+     */
+    void setDeterministicSession(DeterministicSession* deterministic_session) { session = deterministic_session; }
+
+    /**
+     * @brief 启动控制线程，并把停止条件挂到时钟的步结束回调上（多线程模式）
+     * @note 须在时钟启动之前调用
+     */
     void start() {
         if (!running) {
             running = true;
-            control_thread = std::thread(&SimulationControlThread::run, this);
+            state.clock().setStepEndHook([this]() { return checkStopConditions(); });
+            hook_installed = true;
+            if (channel.open()) {
+                control_thread = std::thread(&SimulationControlThread::run, this);
+            }
         }
     }
 
+    /**
+     * @brief 停止控制线程（须在时钟停止之后调用）
+     */
     void stop() {
         if (running) {
             running = false;
+            channel.close();
             if (control_thread.joinable()) {
                 control_thread.join();
             }
+            if (hook_installed) {
+                state.clock().setStepEndHook(nullptr);
+                hook_installed = false;
+            }
         }
     }
 
@@ -114,6 +118,76 @@ public:
         }
     }
 
+    /**
+     * @brief 处理一条控制命令：pause / resume / stop
+     * @return 命令有效返回 true
+     */
+    bool handleCommand(const std::string& command) {
+        if (command == "pause") {
+            if (!paused.exchange(true)) {
+                state.clock().pause();
+                log_detail("[仿真控制] 仿真已暂停\n");
+            }
+        } else if (command == "resume") {
+            if (paused.exchange(false)) {
+                state.clock().resume();
+                log_detail("[仿真控制] 仿真已恢复\n");
+            }
+        } else if (command == "stop") {
+            if (session && session->enabled()) {
+                session->submitCommand(command); // 在下一个步结束时施加
+                return true;
+            }
+            log_detail("[仿真控制] 收到结束命令，准备结束仿真\n");
+            if (paused.exchange(false)) state.clock().resume();
+            requestStop("用户结束仿真");
+        } else {
+            log_detail("[仿真控制] 未知命令: " + command + "（可用命令: pause / resume / stop）\n");
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 求值停止条件，满足时结束仿真
+     * @return 是否已结束仿真
+     *
+     * 每步调用一次：融合执行器 / 任务图执行器作为停止条件调用，多线程模式由时钟的步结束回调调用。
+     * 设置了确定性会话时，先记录/核对本步状态并施加本步的外部命令。
+     */
+    bool checkStopConditions() {
+        if (session && session->enabled()) {
+            for (const auto& command : session->endStep(static_cast<uint64_t>(state.clock().getStepCount()), state)) {
+                if (command == "stop") {
+                    log_detail("[仿真控制] 第 " + std::to_string(state.clock().getStepCount()) + " 步施加结束命令\n");
+                    requestStop("用户结束仿真");
+                    return true;
+                }
+            }
+        }
+        const StopCondition* hit = stop_conditions.evaluate(state);
+        if (!hit) return false;
+
+        std::ostringstream oss;
+        oss << "[仿真控制] 检测到仿真停止条件：\n";
+        oss << "  当前位置: " << std::fixed << std::setprecision(2) << state.position.load() << "m\n";
+        oss << "  当前时间: " << std::fixed << std::setprecision(2) << state.simulation_time.load() << "s\n";
+        oss << "  停止原因: " << hit->reason << "\n";
+        oss << "[仿真控制] 自动结束仿真\n";
+        log_detail(oss.str());
+
+        requestStop(hit->reason);
+        return true;
+    }
+
+    /**
+     * @brief 仿真结束原因（停止条件的原因或用户结束），仿真未结束时为空
+     */
+    std::string getStopReason() {
+        std::lock_guard<std::mutex> lock(stop_mutex);
+        return stop_reason;
+    }
+
     bool isRunning() const { return running.load(); }
     bool isPaused() const { return paused.load(); }
 };
@@ -124,46 +198,31 @@ namespace SimulationManager {
 inline void simulationManagerThread(SharedStateSpace& state, EventBus& bus) {
     // 确保初始状态正确
     state.simulation_started.store(false);
-    state.simulation_running.store(true);
-    
+    state.setSimulationRunning(true);
+
     // 等待所有组件初始化完成
     std::this_thread::sleep_for(std::chrono::seconds(1));
-    
+
     // 输出初始化完成提示
     log_detail("\n==========================================\n");
     log_detail("        仿真系统初始化完成\n");
     log_detail("==========================================\n");
-    
-    // 等待仿真开始
-    while (!state.simulation_started.load() && state.simulation_running.load()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-    
+
+    // 等待仿真开始（notify_start 或仿真结束时唤醒）
+    state.wait_for_start();
+
     // 设置系统就绪和用户确认状态
     state.system_ready.store(true);
     state.user_confirmed.store(true);
-    
+
     // 直接设置仿真开始状态，不发布事件
     state.simulation_started.store(true);
     log_detail("[状态] 仿真已开始\n");
 
-    // 等待用户按ESC键来停止模拟
-    log_detail("模拟运行中... 按ESC键停止\n");
-    while (state.simulation_running) {
-        if (GetAsyncKeyState(VK_ESCAPE) & 0x8000) {
-            // 直接设置仿真停止状态，不发布事件
-            state.simulation_running.store(false);
-            log_detail("[仿真控制] 检测到用户按ESC键\n");
-            log_detail("[仿真控制] 用户主动停止仿真\n");
-            log_detail("[状态] 用户按ESC键，仿真停止\n");
-            break;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-
-    // 停止模拟
-    state.simulation_running = false;
-    log_detail("[状态] 设置 simulation_running = false\n");
+    // 等待仿真结束（停止条件或控制通道的 stop 命令）
+    log_detail("模拟运行中... 向控制通道写入 stop 结束仿真\n");
+    state.wait_for_simulation_end();
+    log_detail("[状态] 仿真停止\n");
 }
 
 // 启动仿真管理线程
@@ -171,4 +230,4 @@ inline std::thread startSimulationManager(SharedStateSpace& state, EventBus& bus
     return std::thread(simulationManagerThread, std::ref(state), std::ref(bus));
 }
 
-} // namespace SimulationManager 
\ No newline at end of file
+} // namespace SimulationManager
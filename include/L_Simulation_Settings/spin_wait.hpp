@@ -0,0 +1,100 @@
+/*
+ * @file spin_wait.hpp
+ * @brief 自旋-休眠两段式等待工具
+ *
+ * 本文件为仿真时钟等热点同步路径提供"先短暂自旋，再进入内核等待"的原子变量等待工具。
+ * C++20 下使用 std::atomic::wait/notify（Linux 上为 futex，Windows 上为 WaitOnAddress），
+ * C++17 下退化为自旋 + yield。
+ *
+ * 主要功能：
+ *   - cpuRelax：自旋循环中的CPU让步指令
+ *   - waitWhileEqual：等待原子变量离开给定值
+ *   - notifyAll / notifyOne：唤醒等待者
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <atomic>       // 原子操作
+#include <thread>       // std::this_thread::yield, hardware_concurrency
+#include <version>      // __cpp_lib_atomic_wait 特性宏
+
+#if defined(_MSC_VER)
+#include <intrin.h>     // _mm_pause / __yield
+#endif
+
+namespace SpinWait {
+
+    /**
+     * @brief 默认自旋次数
+     * 单核机器上自旋只会抢占持有者的时间片，因此直接进入休眠等待。
+     */
+    inline int defaultSpinLimit() {
+        static const int limit = std::thread::hardware_concurrency() > 1 ? 4000 : 0;
+        return limit;
+    }
+
+    /**
+     * @brief 自旋循环中的CPU让步提示
+     */
+    inline void cpuRelax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+        __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /**
+     * @brief 等待原子变量的值不再等于 old
+     * @param value 被等待的原子变量
+     * @param old 进入等待时观察到的旧值
+     * @param spin_limit 进入休眠前的最大自旋次数
+     *
+     * 可能因虚假唤醒提前返回，调用方需在循环中重新检查自己的条件。
+     */
+    template <typename T>
+    inline void waitWhileEqual(const std::atomic<T>& value, T old, int spin_limit = defaultSpinLimit()) {
+        for (int i = 0; i < spin_limit; ++i) {
+            if (value.load(std::memory_order_acquire) != old) return;
+            cpuRelax();
+        }
+#if defined(__cpp_lib_atomic_wait)
+        value.wait(old, std::memory_order_acquire);
+#else
+        while (value.load(std::memory_order_acquire) == old) {
+            std::this_thread::yield();
+        }
+#endif
+    }
+
+    /**
+     * @brief 唤醒所有等待该原子变量的线程
+     */
+    template <typename T>
+    inline void notifyAll(std::atomic<T>& value) {
+#if defined(__cpp_lib_atomic_wait)
+        value.notify_all();
+#else
+        (void)value;
+#endif
+    }
+
+    /**
+     * @brief 唤醒一个等待该原子变量的线程
+     */
+    template <typename T>
+    inline void notifyOne(std::atomic<T>& value) {
+#if defined(__cpp_lib_atomic_wait)
+        value.notify_one();
+#else
+        (void)value;
+#endif
+    }
+}
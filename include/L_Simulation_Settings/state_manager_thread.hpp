@@ -1,77 +1,24 @@
 #pragma once
 
-#include <thread>
 #include <atomic>
 #include "../../include/K_Scenario/shared_state.hpp"
 #include "../../include/L_Simulation_Settings/simulation_clock.hpp"
-#include "../../include/K_Scenario/state_update_queue.hpp"
-#include "../../include/L_Simulation_Settings/thread_name_util.hpp"
+#include "../../include/K_Scenario/state_access.hpp"
 #include "logger.hpp"
 
+/**
+ * @brief 状态空间处理：每步在屏障处提交后缓冲、发布快照
+ *
+ * 动力学与控制器在步内把下一步的状态写入 SharedStateSpace::next，本类在所有写者完成之后
+ * 把它们提交到前缓冲。独立线程模式下不再占用线程，而是挂到时钟的步提交回调上，
+ * 在所有参与线程到达屏障后由时钟线程执行；单线程执行器模式下作为一个阶段直接调用 processStep()。
+ */
 class StateManagerThread {
 private:
     SharedStateSpace& state_;
-    StateUpdateQueue& queue_;
     SimulationClock& clock_;
-    std::thread thread_;
     std::atomic<bool> running_{false};
 
-    void run() {
-        ThreadNaming::set_current_thread_name("StateManager");
-        log_detail("[状态空间线程] 线程已启动\n");
-        clock_.registerThread();
-        size_t current_step = 0; // 记录当前线程处理到的步数
-
-        while (running_.load(std::memory_order_acquire)) {
-            
-            // 1. 与仿真时钟同步，等待下一个时间步
-            clock_.waitForNextStep(current_step);
-            current_step = clock_.getStepCount();
-            if (!clock_.isRunning()) {
-                break;
-            }
-
-            // 2. 处理当前队列中的所有消息
-            StateUpdateMessage msg;
-            while (queue_.try_pop(msg)) {
-                process_raw_update(msg);
-            }
-
-            // 3. 在这里执行周期性的二次处理
-            perform_secondary_processing();
-
-            // 4. 每步长输出一次状态
-            state_.printState();
-
-            // 5. 通知时钟本线程已完成当前步骤
-            clock_.notifyStepCompleted();
-        }
-
-        clock_.unregisterThread();
-        log_detail("[状态空间线程] 线程已结束\n");
-    }
-
-    // 处理从队列接收到的原始数据
-    void process_raw_update(const StateUpdateMessage& msg) {
-        switch (msg.type) {
-            case StateUpdateType::Position:
-                state_.position.store(msg.value);
-                break;
-            case StateUpdateType::Velocity:
-                state_.velocity.store(msg.value);
-                break;
-            case StateUpdateType::Acceleration:
-                state_.acceleration.store(msg.value);
-                break;
-            case StateUpdateType::Throttle:
-                state_.throttle.store(msg.value);
-                break;
-            case StateUpdateType::Brake:
-                state_.brake.store(msg.value);
-                break;
-        }
-    }
-
     // 执行二次数据处理（例如单位转换、滤波等）
     void perform_secondary_processing() {
         // 这是一个示例，你可以添加任何你需要的数据处理逻辑
@@ -82,26 +29,67 @@ private:
     }
 
 public:
-    StateManagerThread(SharedStateSpace& state, StateUpdateQueue& queue, SimulationClock& clock)
-        : state_(state), queue_(queue), clock_(clock) {}
+    /**
+     * @brief 执行一个仿真步的状态空间处理
+     *
+     * 提交后缓冲（本步各写者产生的下一步状态），执行二次处理，发布本步快照并输出状态。
+     * 独立线程模式下由时钟在步屏障处调用，单线程执行器模式下由执行器直接调用。
+     */
+    void processStep() {
+        // 1. 提交本步写入后缓冲的所有字段
+        state_.commitStep();
+
+        // 2. 在这里执行周期性的二次处理
+        perform_secondary_processing();
+
+        // 3. 发布本步快照，读者此后无锁读取一致的状态
+        state_.publishSnapshot();
+
+        // 4. 每步长输出一次状态
+        state_.printState();
+    }
+
+    /**
+     * @brief processStep() 每步读写的共享状态字段
+     *
+     * 读取（并清空）各 Next* 字段，写入对应的状态字段；发布快照与 printState() 只服务于并发读者和日志，不计入读集。
+     */
+    static StateAccess stateAccess() {
+        return StateAccess::of(
+            {StateField::NextKinematics, StateField::NextThrottle, StateField::NextBrake, StateField::NextPitchControl},
+            {StateField::NextKinematics, StateField::NextThrottle, StateField::NextBrake, StateField::NextPitchControl,
+             StateField::Position, StateField::Velocity, StateField::Acceleration,
+             StateField::Throttle, StateField::Brake, StateField::Thrust, StateField::DragForce,
+             StateField::BrakeForce, StateField::PitchControlOutput, StateField::SimulationTime});
+    }
+
+    StateManagerThread(SharedStateSpace& state, SimulationClock& clock)
+        : state_(state), clock_(clock) {}
 
     ~StateManagerThread() {
         stop();
     }
 
+    /**
+     * @brief 独立线程模式：把 processStep() 挂到时钟的步提交回调上
+     * @note 须在时钟启动之前调用
+     */
     void start() {
         if (!running_.load()) {
             running_ = true;
-            thread_ = std::thread(&StateManagerThread::run, this);
+            clock_.setStepCommitHook([this]() { processStep(); });
+            log_detail("[状态空间] 已挂到时钟步提交回调\n");
         }
     }
 
+    /**
+     * @brief 取消步提交回调（须在时钟停止之后调用）
+     */
     void stop() {
         if (running_.load()) {
             running_ = false;
-            if (thread_.joinable()) {
-                thread_.join();
-            }
+            clock_.setStepCommitHook(nullptr);
+            log_detail("[状态空间] 已取消时钟步提交回调\n");
         }
     }
-}; 
\ No newline at end of file
+};
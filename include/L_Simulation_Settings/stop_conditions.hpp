@@ -0,0 +1,105 @@
+/*
+ * @file stop_conditions.hpp
+ * @brief 仿真停止条件（停止谓词）头文件
+ *
+ * 每个场景配置一组停止谓词，由 SimulationControlThread::checkStopConditions() 在每步结束时求值：
+ *   - 融合执行器 / 任务图执行器：作为执行器的停止条件，每步调用一次
+ *   - 多线程模式：作为时钟的步结束回调，所有参与线程完成一步后调用一次
+ * 因此仿真恰好在第一个满足条件的步结束，不再依赖轮询间隔。
+ *
+ * 典型用法：
+ *   StopConditionSet conditions;
+ *   conditions.add(StopConditions::positionAbove(AbortTakeoffConfig::STOP_POSITION_LIMIT));
+ *   conditions.add(StopConditions::timeAbove(AbortTakeoffConfig::STOP_TIME_LIMIT));
+ *   conditions.add("停止", [](const SharedStateSpace& s) { return s.isFinalStopEnabled(); }, "飞机已停止");
+ *   simulation_control.setStopConditions(conditions);
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <functional>   // 谓词
+#include <sstream>      // 停止原因格式化
+#include <iomanip>      // 数值精度
+#include <string>       // 名称与原因
+#include <utility>      // std::move
+#include <vector>       // 谓词表
+
+// ParaSAFE系统头文件
+#include "../K_Scenario/shared_state.hpp"   // 共享状态空间
+
+/**
+ * @struct StopCondition
+ * @brief 单个停止谓词
+ */
+struct StopCondition {
+    std::string name;                                          ///< 条件名称
+    std::function<bool(const SharedStateSpace&)> predicate;    ///< 返回 true 时结束仿真
+    std::string reason;                                        ///< 停止原因（写入日志）
+};
+
+/**
+ * @class StopConditionSet
+ * @brief 按加入顺序求值的停止谓词集合，任一成立即停止
+ */
+class StopConditionSet {
+public:
+    void add(StopCondition condition) { conditions_.push_back(std::move(condition)); }
+
+    void add(std::string name, std::function<bool(const SharedStateSpace&)> predicate, std::string reason) {
+        conditions_.push_back({std::move(name), std::move(predicate), std::move(reason)});
+    }
+
+    void clear() { conditions_.clear(); }
+    bool empty() const { return conditions_.empty(); }
+    size_t size() const { return conditions_.size(); }
+    const std::vector<StopCondition>& conditions() const { return conditions_; }
+
+    /**
+     * @brief 求值所有谓词
+     * @return 第一个成立的条件，都不成立返回 nullptr
+     */
+    const StopCondition* evaluate(const SharedStateSpace& state) const {
+        for (const auto& condition : conditions_) {
+            if (condition.predicate && condition.predicate(state)) return &condition;
+        }
+        return nullptr;
+    }
+
+private:
+    std::vector<StopCondition> conditions_;
+};
+
+namespace StopConditions {
+    inline std::string formatLimit(double value) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(0) << value;
+        return oss.str();
+    }
+
+    /**
+     * @brief 位置超过限制（米）
+     */
+    inline StopCondition positionAbove(double limit) {
+        return {"位置上限", [limit](const SharedStateSpace& s) { return s.position.load() > limit; },
+                "位置超过" + formatLimit(limit) + "米限制"};
+    }
+
+    /**
+     * @brief 仿真时间超过限制（秒）
+     */
+    inline StopCondition timeAbove(double limit) {
+        return {"时间上限", [limit](const SharedStateSpace& s) { return s.simulation_time.load() > limit; },
+                "时间超过" + formatLimit(limit) + "秒限制"};
+    }
+
+    /**
+     * @brief 默认停止条件：位置超过 1500 米或时间超过 180 秒
+     */
+    inline StopConditionSet defaults() {
+        StopConditionSet set;
+        set.add(positionAbove(1500.0));
+        set.add(timeAbove(180.0));
+        return set;
+    }
+}
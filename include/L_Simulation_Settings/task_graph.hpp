@@ -0,0 +1,242 @@
+/*
+ * @file task_graph.hpp
+ * @brief 按状态读写集调度的每步任务图执行器头文件
+ *
+ * 每个仿真组件（动力学+力学模型、状态提交、事件检测、每个控制器、数据记录）
+ * 作为一个任务加入任务图，并用 StateAccess 声明自己读写的共享状态字段。
+ * 任务按加入顺序定义语义上的串行顺序；两个任务的读写集冲突时，先加入的任务在前，
+ * 没有冲突的任务可以在工作窃取线程池上并行执行。因此并行执行的结果与按加入顺序
+ * 串行执行（即 FusedStepExecutor）相同，前提是读写集声明完整。
+ *
+ * 依赖图在第一步执行前由静态声明建立一次，之后每步只重置入度计数并重新执行。
+ * 未声明读写集的组件（StateAccess::all()）与所有任务串行，退化为融合执行器的行为。
+ *
+ * 使用要求与 FusedStepExecutor 相同：同步事件总线、控制器外部步进、各组件不调用 start()。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <atomic>       // 入度计数、停止标志
+#include <functional>   // 任务回调
+#include <memory>       // 入度计数数组
+#include <sstream>      // 依赖图描述
+#include <string>       // 任务名称
+#include <vector>       // 任务表、后继表
+#include <exception>    // 任务异常
+
+// ParaSAFE系统头文件
+#include "../K_Scenario/shared_state.hpp"   // 共享状态空间
+#include "../K_Scenario/state_access.hpp"   // 状态读写集声明
+#include "simulation_clock.hpp"             // 仿真时钟
+#include "work_stealing_pool.hpp"           // 工作窃取线程池
+#include "thread_name_util.hpp"             // 线程命名工具
+#include "logger.hpp"                       // 日志系统
+
+/**
+ * @class StepTaskGraph
+ * @brief 由读写集冲突推导依赖关系的每步任务图
+ */
+class StepTaskGraph {
+public:
+    using TaskCallback = std::function<void()>;
+
+    /**
+     * @brief 加入一个任务（必须在第一次 execute() 之前调用）
+     * @param name 任务名称，用于日志
+     * @param access 任务每步读写的共享状态字段
+     * @param callback 任务回调
+     * @return 任务下标
+     */
+    int addTask(std::string name, const StateAccess& access, TaskCallback callback) {
+        tasks_.push_back(Task{std::move(name), access, std::move(callback), {}, 0});
+        built_ = false;
+        return static_cast<int>(tasks_.size()) - 1;
+    }
+
+    /**
+     * @brief 由读写集建立依赖边：后加入的任务依赖所有与之冲突的先加入任务
+     */
+    void build() {
+        for (auto& task : tasks_) {
+            task.successors.clear();
+            task.indegree = 0;
+        }
+        for (size_t j = 0; j < tasks_.size(); ++j) {
+            for (size_t i = 0; i < j; ++i) {
+                if (tasks_[i].access.conflictsWith(tasks_[j].access)) {
+                    tasks_[i].successors.push_back(static_cast<int>(j));
+                    tasks_[j].indegree++;
+                }
+            }
+        }
+        roots_.clear();
+        for (size_t i = 0; i < tasks_.size(); ++i) {
+            if (tasks_[i].indegree == 0) roots_.push_back(static_cast<int>(i));
+        }
+        remaining_.reset(new std::atomic<int>[tasks_.size()]);
+        built_ = true;
+        log_detail("[任务图] " + describe());
+    }
+
+    /**
+     * @brief 在线程池上执行一次任务图（所有任务完成后返回）
+     */
+    void execute(WorkStealingPool& pool) {
+        if (!built_) build();
+        for (size_t i = 0; i < tasks_.size(); ++i) {
+            remaining_[i].store(tasks_[i].indegree, std::memory_order_relaxed);
+        }
+        pool.runRound(roots_, tasks_.size(), [this, &pool](int index, size_t worker) {
+            runTask(index);
+            // 释放后继：最后一个前驱完成时后继就绪，放入当前工作者的队列
+            for (int next : tasks_[index].successors) {
+                if (remaining_[next].fetch_sub(1, std::memory_order_acq_rel) == 1) pool.push(worker, next);
+            }
+        });
+    }
+
+    /**
+     * @brief 任务数
+     */
+    size_t size() const { return tasks_.size(); }
+
+    /**
+     * @brief 依赖图的文字描述（每个任务及其后继）
+     */
+    std::string describe() const {
+        std::ostringstream ss;
+        ss << tasks_.size() << " 个任务, " << roots_.size() << " 个根任务\n";
+        for (const auto& task : tasks_) {
+            ss << "  " << task.name << " ->";
+            if (task.successors.empty()) ss << " (无)";
+            for (int next : task.successors) ss << " " << tasks_[next].name;
+            ss << "\n";
+        }
+        return ss.str();
+    }
+
+private:
+    struct Task {
+        std::string name;
+        StateAccess access;
+        TaskCallback callback;
+        std::vector<int> successors;  ///< 依赖本任务的后加入任务
+        int indegree;                 ///< 前驱数量
+    };
+
+    // 任务异常只记录不传播：传播会使后继永远不就绪，本轮无法结束
+    void runTask(int index) {
+        try {
+            tasks_[index].callback();
+        } catch (const std::exception& e) {
+            log_detail("[任务图] 任务 " + tasks_[index].name + " 异常: " + e.what() + "\n");
+        } catch (...) {
+            log_detail("[任务图] 任务 " + tasks_[index].name + " 发生未知异常\n");
+        }
+    }
+
+    std::vector<Task> tasks_;
+    std::vector<int> roots_;
+    std::unique_ptr<std::atomic<int>[]> remaining_;  ///< 本轮各任务尚未完成的前驱数
+    bool built_ = false;
+};
+
+/**
+ * @class TaskGraphExecutor
+ * @brief 每步推进时钟并在工作窃取线程池上执行任务图的执行器
+ *
+ * 接口与 FusedStepExecutor 一致（run / stop / setStopCondition / getExecutedSteps），
+ * 区别是组件作为带读写集的任务加入，而不是固定的阶段。
+ */
+class TaskGraphExecutor {
+public:
+    using TaskCallback = StepTaskGraph::TaskCallback;
+
+    /**
+     * @brief 构造执行器
+     * @param clock 仿真时钟
+     * @param state 共享状态空间
+     * @param helper_threads 线程池辅助线程数（不含执行器线程），默认硬件线程数减一
+     */
+    TaskGraphExecutor(SimulationClock& clock, SharedStateSpace& state,
+                      size_t helper_threads = WorkStealingPool::defaultHelperThreads())
+        : clock_(clock), state_(state), pool_(helper_threads) {}
+
+    /**
+     * @brief 加入一个任务
+     * @param name 任务名称
+     * @param access 任务每步读写的共享状态字段
+     * @param callback 任务回调
+     * @param rate_divisor 速率分频，任务只在步数为其整数倍时执行回调（依赖关系不变）
+     */
+    void addTask(std::string name, const StateAccess& access, TaskCallback callback, int rate_divisor = 1) {
+        if (rate_divisor > 1) {
+            callback = [this, rate_divisor, cb = std::move(callback)]() {
+                if (SimulationClock::isStepDue(static_cast<uint64_t>(clock_.getStepCount()), rate_divisor)) cb();
+            };
+        }
+        graph_.addTask(std::move(name), access, std::move(callback));
+    }
+
+    /**
+     * @brief 设置每步结束时检查的停止条件（语义同 FusedStepExecutor::setStopCondition）
+     */
+    void setStopCondition(std::function<bool()> condition) {
+        stop_condition_ = std::move(condition);
+    }
+
+    /**
+     * @brief 推进时钟并执行一次任务图
+     */
+    void stepOnce() {
+        clock_.advanceStep();
+        graph_.execute(pool_);
+        executed_steps_++;
+        if (stop_condition_ && stop_condition_()) stop();
+    }
+
+    /**
+     * @brief 在当前线程运行仿真（当前线程同时是线程池的0号工作者），直到时钟停止或仿真结束
+     */
+    void run() {
+        ThreadNaming::set_current_thread_name("TaskGraphExecutor");
+        stop_requested_ = false;
+        graph_.build();
+        clock_.startExternalStepping();
+        log_detail("[任务图执行器] 开始运行，" + std::to_string(pool_.getWorkerCount()) + " 个工作者\n");
+        while (!stop_requested_.load(std::memory_order_acquire) &&
+               state_.simulation_running.load(std::memory_order_acquire)) {
+            if (!clock_.waitWhilePaused()) break;
+            stepOnce();
+        }
+        clock_.stop();
+        log_detail("[任务图执行器] 运行结束，共执行 " + std::to_string(executed_steps_) + " 步\n");
+    }
+
+    /**
+     * @brief 请求停止（可从其他线程调用）
+     */
+    void stop() {
+        stop_requested_ = true;
+    }
+
+    /**
+     * @brief 已执行的步数
+     */
+    size_t getExecutedSteps() const { return executed_steps_; }
+
+    /**
+     * @brief 任务图（用于查看依赖关系）
+     */
+    const StepTaskGraph& graph() const { return graph_; }
+
+private:
+    SimulationClock& clock_;
+    SharedStateSpace& state_;
+    WorkStealingPool pool_;
+    StepTaskGraph graph_;
+    std::function<bool()> stop_condition_;
+    std::atomic<bool> stop_requested_{false};
+    size_t executed_steps_ = 0;
+};
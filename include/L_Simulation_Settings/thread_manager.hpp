@@ -6,11 +6,13 @@
 #include <functional>
 #include <vector>
 #include <chrono>
-#include <windows.h>
 #include <unordered_map>
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include "logger.hpp"
+#include "thread_name_util.hpp"
+#include "thread_policy.hpp"
 
 class ThreadManager {
 private:
@@ -45,13 +47,13 @@ public:
         log_detail("[ThreadManager] 已关闭\n");
     }
 
-    // 启动受管理的线程
+    // 启动受管理的线程，线程名对应的亲和性与调度策略见 ThreadPolicy
     template<typename Func>
-    void startThread(Func&& func, const std::string& name, int priority = THREAD_PRIORITY_NORMAL) {
-        std::thread t([this, func = std::forward<Func>(func), name, priority]() {
+    void startThread(Func&& func, const std::string& name) {
+        std::thread t([this, func = std::forward<Func>(func), name]() {
             try {
-                // 设置线程优先级
-                SetThreadPriority(GetCurrentThread(), priority);
+                // 设置线程名并应用该线程名配置的策略
+                ThreadNaming::set_current_thread_name(name);
                 
                 // 记录线程开始时间
                 auto start_time = std::chrono::steady_clock::now();
@@ -83,6 +85,13 @@ public:
         t.detach();
     }
 
+    // 启动受管理的线程，并为其指定策略（覆盖配置文件中同名线程的策略）
+    template<typename Func>
+    void startThread(Func&& func, const std::string& name, const ThreadPolicySpec& policy) {
+        ThreadPolicy::setPolicy(name, policy);
+        startThread(std::forward<Func>(func), name);
+    }
+
     // 等待所有线程就绪
     void waitForReady() {
         std::unique_lock<std::mutex> lock(mtx);
@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <mutex>
 #include <sstream>
+#include "thread_policy.hpp"
 
 namespace ThreadNaming {
     // 使用inline变量，避免多重定义问题 (C++17+)
@@ -14,10 +15,15 @@ namespace ThreadNaming {
     /**
      * @brief 为当前线程设置一个名字
      * @param name 要设置的名字
+     *
+     * 同时设置系统线程名，并应用 ThreadPolicy 中为该名字配置的亲和性与调度策略。
      */
     inline void set_current_thread_name(const std::string& name) {
-        std::lock_guard<std::mutex> lock(name_map_mutex);
-        thread_names[std::this_thread::get_id()] = name;
+        {
+            std::lock_guard<std::mutex> lock(name_map_mutex);
+            thread_names[std::this_thread::get_id()] = name;
+        }
+        ThreadPolicy::applyToCurrentThread(name);
     }
 
     /**
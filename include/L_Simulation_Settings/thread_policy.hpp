@@ -0,0 +1,279 @@
+/*
+ * @file thread_policy.hpp
+ * @brief 线程策略（CPU 亲和性、实时优先级、系统线程名）头文件
+ *
+ * 按线程名配置线程策略：绑定到指定 CPU 核心、使用 SCHED_FIFO 实时调度及其优先级。
+ * 线程名即 ThreadNaming 中使用的名字（SimulationClock、DynamicsModel、DataRecorder 等），
+ * 线程调用 ThreadNaming::set_current_thread_name() 时自动设置系统线程名并应用已配置的策略，
+ * 各组件无需改动。
+ *
+ * 配置文件格式（与场景配置文件一致，# 开头为注释）：
+ *   线程名 = cpu:核心列表 fifo:优先级
+ * 例如：
+ *   SimulationClock = cpu:2 fifo:80
+ *   DynamicsModel   = cpu:3 fifo:70
+ *   DataRecorder    = cpu:4-5
+ *
+ * 平台实现：
+ *   - Linux：pthread_setaffinity_np / pthread_setschedparam(SCHED_FIFO) / pthread_setname_np
+ *   - Windows：SetThreadAffinityMask / SetThreadPriority（fifo 优先级映射为 HIGHEST / TIME_CRITICAL）
+ * 策略应用失败（如没有 CAP_SYS_NICE 权限）只记录日志，线程按默认策略继续运行。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <string>          // 线程名
+#include <vector>          // 核心列表
+#include <unordered_map>   // 线程名到策略的映射
+#include <mutex>           // 策略表互斥锁
+#include <fstream>         // 配置文件读取
+#include <sstream>         // 配置解析
+#include <iostream>        // 配置加载提示
+#include <cstring>         // strerror
+#include <thread>          // hardware_concurrency
+#include <algorithm>       // 核心编号上限
+
+// ParaSAFE系统头文件
+#include "logger.hpp"      // 日志系统
+
+// 平台头文件
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>       // 亲和性、调度策略、线程名
+#include <sched.h>         // CPU_SET、SCHED_FIFO
+#endif
+
+/**
+ * @struct ThreadPolicySpec
+ * @brief 单个线程的策略
+ */
+struct ThreadPolicySpec {
+    std::vector<int> cpus;   ///< 绑定的 CPU 核心，空表示不绑定
+    int fifo_priority = 0;   ///< SCHED_FIFO 优先级（1-99），0 表示不使用实时调度
+
+    bool empty() const { return cpus.empty() && fifo_priority == 0; }
+};
+
+namespace ThreadPolicy {
+    inline std::mutex policy_mutex;
+    inline std::unordered_map<std::string, ThreadPolicySpec> policies;
+
+    /**
+     * @brief 为指定线程名设置策略（须在线程启动前设置）
+     */
+    inline void setPolicy(const std::string& thread_name, const ThreadPolicySpec& spec) {
+        std::lock_guard<std::mutex> lock(policy_mutex);
+        policies[thread_name] = spec;
+    }
+
+    /**
+     * @brief 清除所有策略
+     */
+    inline void clear() {
+        std::lock_guard<std::mutex> lock(policy_mutex);
+        policies.clear();
+    }
+
+    /**
+     * @brief 可绑定的核心编号上限（不含）：本机逻辑核心数，且不超过平台掩码位数
+     *        （Linux 为 CPU_SETSIZE，Windows 亲和性掩码为 DWORD_PTR 的位数）
+     */
+    inline int cpuLimit() {
+#if defined(_WIN32)
+        const int platform_limit = static_cast<int>(sizeof(DWORD_PTR) * 8);
+#else
+        const int platform_limit = CPU_SETSIZE;
+#endif
+        const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        return hardware > 0 ? std::min(hardware, platform_limit) : platform_limit;
+    }
+
+    /**
+     * @brief 解析策略文本，如 "cpu:2,4-5 fifo:80"
+     * @return 解析成功返回 true，失败时 error 为错误描述
+     */
+    inline bool parseSpec(const std::string& text, ThreadPolicySpec& spec, std::string& error) {
+        spec = ThreadPolicySpec{};
+        std::istringstream tokens(text);
+        std::string token;
+        while (tokens >> token) {
+            const size_t colon = token.find(':');
+            if (colon == std::string::npos) {
+                error = "缺少冒号: " + token;
+                return false;
+            }
+            const std::string key = token.substr(0, colon);
+            const std::string value = token.substr(colon + 1);
+            try {
+                if (key == "cpu") {
+                    std::istringstream ranges(value);
+                    std::string range;
+                    while (std::getline(ranges, range, ',')) {
+                        const size_t dash = range.find('-');
+                        const int first = std::stoi(range.substr(0, dash));
+                        const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                        if (first < 0 || last < first || last >= cpuLimit()) {
+                            error = "cpu 核心范围无效（须为 0-" + std::to_string(cpuLimit() - 1) + " 且起始不大于结束）: " + range;
+                            return false;
+                        }
+                        for (int cpu = first; cpu <= last; ++cpu) spec.cpus.push_back(cpu);
+                    }
+                } else if (key == "fifo") {
+                    spec.fifo_priority = std::stoi(value);
+                    if (spec.fifo_priority < 0 || spec.fifo_priority > 99) {
+                        error = "fifo 优先级超出 0-99: " + value;
+                        return false;
+                    }
+                } else {
+                    error = "未知的策略项: " + key;
+                    return false;
+                }
+            } catch (const std::exception&) {
+                error = "数值格式错误: " + token;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 从配置文件加载线程策略
+     * @param filename 配置文件名，文件不存在时不设置任何策略
+     * @return 加载的策略条数
+     */
+    inline size_t loadConfig(const std::string& filename = "thread_policy_config.txt") {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cout << "[ThreadPolicy] 配置文件不存在，所有线程使用默认调度策略" << std::endl;
+            return 0;
+        }
+
+        size_t loaded = 0;
+        std::string line;
+        int line_count = 0;
+        while (std::getline(file, line)) {
+            line_count++;
+            if (line.empty() || line[0] == '#') continue;
+
+            const size_t equal_pos = line.find('=');
+            if (equal_pos == std::string::npos) {
+                std::cout << "[ThreadPolicy] 警告：第" << line_count << "行格式错误，缺少等号: " << line << std::endl;
+                continue;
+            }
+            std::string name = line.substr(0, equal_pos);
+            name.erase(0, name.find_first_not_of(" \t"));
+            name.erase(name.find_last_not_of(" \t") + 1);
+
+            ThreadPolicySpec spec;
+            std::string error;
+            if (!parseSpec(line.substr(equal_pos + 1), spec, error)) {
+                std::cout << "[ThreadPolicy] 警告：第" << line_count << "行" << error << std::endl;
+                continue;
+            }
+            setPolicy(name, spec);
+            loaded++;
+        }
+        std::cout << "[ThreadPolicy] 已加载 " << loaded << " 条线程策略" << std::endl;
+        return loaded;
+    }
+
+    /**
+     * @brief 设置当前线程的系统线程名（调试器、top -H、perf 中可见）
+     *
+     * Linux 限制为 15 字节，超出部分截断。
+     */
+    inline void setOsThreadName(const std::string& name) {
+#if defined(_WIN32)
+        (void)name; // SetThreadDescription 需要 Windows 10 1607+ 的宽字符接口，此处不强制依赖
+#else
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
+    }
+
+    /**
+     * @brief 把策略应用到当前线程
+     * @return 所有策略项都应用成功返回 true，失败原因写入 error
+     */
+    inline bool applySpec(const ThreadPolicySpec& spec, std::string& error) {
+        // setPolicy 可绕过 parseSpec 直接设置，越界的核心编号会使掩码移位或 CPU_SET 越界
+        for (int cpu : spec.cpus) {
+            if (cpu < 0 || cpu >= cpuLimit()) {
+                error += "cpu 核心编号越界: " + std::to_string(cpu) + "; ";
+                return false;
+            }
+        }
+        bool ok = true;
+#if defined(_WIN32)
+        if (!spec.cpus.empty()) {
+            DWORD_PTR mask = 0;
+            for (int cpu : spec.cpus) mask |= (DWORD_PTR{1} << cpu);
+            if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+                error += "SetThreadAffinityMask 失败; ";
+                ok = false;
+            }
+        }
+        if (spec.fifo_priority > 0) {
+            const int priority = spec.fifo_priority >= 50 ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST;
+            if (!SetThreadPriority(GetCurrentThread(), priority)) {
+                error += "SetThreadPriority 失败; ";
+                ok = false;
+            }
+        }
+#else
+        if (!spec.cpus.empty()) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : spec.cpus) CPU_SET(cpu, &set);
+            const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if (rc != 0) {
+                error += std::string("绑定 CPU 失败: ") + std::strerror(rc) + "; ";
+                ok = false;
+            }
+        }
+        if (spec.fifo_priority > 0) {
+            sched_param param{};
+            param.sched_priority = spec.fifo_priority;
+            const int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+            if (rc != 0) {
+                error += std::string("设置 SCHED_FIFO 失败（需要 CAP_SYS_NICE 或 rtprio 限额）: ") + std::strerror(rc) + "; ";
+                ok = false;
+            }
+        }
+#endif
+        return ok;
+    }
+
+    /**
+     * @brief 设置当前线程的系统线程名，并应用为该线程名配置的策略
+     *
+     * 由 ThreadNaming::set_current_thread_name() 调用。
+     */
+    inline void applyToCurrentThread(const std::string& name) {
+        setOsThreadName(name);
+
+        ThreadPolicySpec spec;
+        {
+            std::lock_guard<std::mutex> lock(policy_mutex);
+            auto it = policies.find(name);
+            if (it == policies.end()) return;
+            spec = it->second;
+        }
+        if (spec.empty()) return;
+
+        std::string error;
+        if (applySpec(spec, error)) {
+            std::ostringstream ss;
+            ss << "[ThreadPolicy] 线程 " << name << " 已应用策略:";
+            if (!spec.cpus.empty()) {
+                ss << " cpu";
+                for (size_t i = 0; i < spec.cpus.size(); ++i) ss << (i == 0 ? ":" : ",") << spec.cpus[i];
+            }
+            if (spec.fifo_priority > 0) ss << " fifo:" << spec.fifo_priority;
+            log_brief(ss.str() + "\n");
+        } else {
+            log_brief("[ThreadPolicy] 警告：线程 " + name + " 策略应用失败，按默认策略运行: " + error + "\n");
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * @file what_if_branching.hpp
+ * @brief 假设分析（what-if）分支头文件
+ *
+ * 参数扫描中各变体往往在某一时刻之前完全相同（如中止起飞在达到中止速度之前）。
+ * 分支方式只仿真一次公共前缀，在分支时刻保存整个仿真的检查点（见 simulation_checkpoint.hpp），
+ * 然后每个变体在自己的 SimulationContext 中恢复该检查点、施加参数覆盖、只仿真后缀，
+ * 扫描代价由 O(N·T) 降为 O(T_前缀 + N·T_后缀)。
+ *
+ * 写时复制：分支点的检查点是只读的共享数据（shared_ptr<const std::string>），所有变体共用一份，
+ * 变体恢复时才把状态复制到自己的上下文中，之后的修改互不影响。
+ * 采用进程内克隆而不是 fork()，Windows 和 Linux 行为一致，变体可在同一个 BatchRunner 线程池上并发运行。
+ *
+ * 典型用法：
+ *   BranchPoint point = WhatIfBranching::makeBranchPoint(prefix.capture(), t, steps, "output/data_prefix.csv");
+ *   std::vector<WhatIfVariant> variants = {
+ *       {"abort_30", [](SharedStateSpace& s) { s.abort_speed_threshold.store(30.0); }},
+ *       {"abort_35", [](SharedStateSpace& s) { s.abort_speed_threshold.store(35.0); }},
+ *   };
+ *   auto results = WhatIfBranching::fork<Result>(runner, point, variants,
+ *       [](const BranchPoint& p, const WhatIfVariant& v) { ... 恢复 *p.snapshot，v.overlay(state)，运行 ... });
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <filesystem>   // 前缀数据文件复制
+#include <functional>   // 参数覆盖与分支函数
+#include <memory>       // 共享检查点
+#include <string>       // 检查点数据与名称
+#include <vector>       // 变体与结果
+
+// ParaSAFE系统头文件
+#include "../K_Scenario/shared_state.hpp"   // 共享状态空间
+#include "batch_runner.hpp"                 // 批量仿真运行器
+#include "logger.hpp"                       // 日志系统
+
+/**
+ * @struct WhatIfVariant
+ * @brief 一个假设分析变体
+ */
+struct WhatIfVariant {
+    std::string name;                                  ///< 变体名称（日志与输出文件名）
+    std::function<void(SharedStateSpace&)> overlay;    ///< 恢复检查点后施加到状态空间的参数覆盖
+};
+
+/**
+ * @struct BranchPoint
+ * @brief 公共前缀结束处的分支点，所有变体只读共享
+ */
+struct BranchPoint {
+    std::shared_ptr<const std::string> snapshot;   ///< 整个仿真的检查点
+    double time = 0.0;                             ///< 分支时刻（s）
+    size_t steps = 0;                              ///< 前缀执行的步数
+    std::string data_path;                         ///< 前缀数据文件，变体的数据文件以它开头（可为空）
+
+    bool valid() const { return snapshot && !snapshot->empty(); }
+};
+
+namespace WhatIfBranching {
+
+    /**
+     * @brief 由前缀仿真的检查点构造分支点
+     */
+    inline BranchPoint makeBranchPoint(std::string snapshot, double time, size_t steps, std::string data_path = {}) {
+        BranchPoint point;
+        point.snapshot = std::make_shared<const std::string>(std::move(snapshot));
+        point.time = time;
+        point.steps = steps;
+        point.data_path = std::move(data_path);
+        return point;
+    }
+
+    /**
+     * @brief 把前缀数据文件复制为变体数据文件的开头
+     * @note 须在变体的 FileLogger 构造之后（构造会清空文件）、恢复检查点之前调用
+     */
+    inline bool seedDataFile(const BranchPoint& point, const std::string& variant_path) {
+        if (point.data_path.empty()) return true;
+        std::error_code ec;
+        std::filesystem::copy_file(point.data_path, variant_path,
+                                   std::filesystem::copy_options::overwrite_existing, ec);
+        if (ec) {
+            log_detail("[分支] 复制前缀数据文件失败: " + point.data_path + " -> " + variant_path + " (" +
+                       ec.message() + ")\n");
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 在线程池上并发运行各变体的后缀
+     * @param branch 运行一个变体：在自己的上下文中恢复 *point.snapshot、施加 variant.overlay 后继续仿真
+     * @return 按变体顺序排列的结果
+     */
+    template <typename Result>
+    std::vector<Result> fork(BatchRunner& runner, const BranchPoint& point, const std::vector<WhatIfVariant>& variants,
+                             const std::function<Result(const BranchPoint&, const WhatIfVariant&)>& branch) {
+        std::vector<Result> results(variants.size());
+        for (size_t i = 0; i < variants.size(); ++i) {
+            runner.submit([&results, &point, &variants, &branch, i]() { results[i] = branch(point, variants[i]); });
+        }
+        runner.wait();
+        log_detail("[分支] 在 t=" + std::to_string(point.time) + "s 分支出 " + std::to_string(variants.size()) +
+                   " 个变体，共享前缀 " + std::to_string(point.steps) + " 步\n");
+        return results;
+    }
+}
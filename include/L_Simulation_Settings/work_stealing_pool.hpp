@@ -0,0 +1,192 @@
+/*
+ * @file work_stealing_pool.hpp
+ * @brief 工作窃取线程池头文件
+ *
+ * 为每步任务图执行提供的工作窃取线程池。每个工作者有自己的双端队列：
+ * 本线程从尾部取任务（后进先出，缓存友好），空闲线程从其他队列头部窃取（先进先出）。
+ *
+ * 线程池以"轮"为单位执行：调用线程（工作者0）提交一轮的根任务并亲自参与执行，
+ * 辅助线程在轮次纪元上等待（SpinWait，先自旋再 futex 休眠），本轮全部任务完成、且每个辅助线程
+ * 都确认了本轮纪元后返回，因此辅助线程不会读到下一轮的执行回调和任务总数。
+ * 任务执行中产生的新就绪任务通过 push() 放入执行者自己的队列。
+ */
+
+#pragma once
+
+// C++系统头文件
+#include <atomic>       // 轮次纪元、完成计数
+#include <deque>        // 任务队列
+#include <functional>   // 任务执行回调
+#include <memory>       // 工作者队列
+#include <mutex>        // 队列锁
+#include <string>       // 线程名称
+#include <thread>       // 辅助线程
+#include <vector>       // 队列表
+
+// ParaSAFE系统头文件
+#include "spin_wait.hpp"         // 自旋-休眠等待
+#include "thread_name_util.hpp"  // 线程命名工具
+
+/**
+ * @class WorkStealingPool
+ * @brief 按轮执行任务下标的工作窃取线程池
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief 任务执行回调
+     * @param task 任务下标
+     * @param worker 执行该任务的工作者编号，新就绪任务应 push 到该工作者
+     */
+    using Executor = std::function<void(int task, size_t worker)>;
+
+    /**
+     * @brief 构造线程池
+     * @param helper_threads 辅助线程数（不含调用线程），0 表示只在调用线程上执行
+     */
+    explicit WorkStealingPool(size_t helper_threads = defaultHelperThreads()) {
+        queues_.reserve(helper_threads + 1);
+        for (size_t i = 0; i < helper_threads + 1; ++i) {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+        helpers_.reserve(helper_threads);
+        // 起始纪元在启动辅助线程之前取得：构造后立即 runRound 时，辅助线程即使还没运行，
+        // 也会把那一轮的纪元视为新的一轮
+        const uint32_t start_epoch = round_epoch_.load(std::memory_order_relaxed);
+        for (size_t i = 1; i <= helper_threads; ++i) {
+            helpers_.emplace_back(&WorkStealingPool::helperLoop, this, i, start_epoch);
+        }
+    }
+
+    ~WorkStealingPool() {
+        shutdown_.store(true, std::memory_order_release);
+        round_epoch_.fetch_add(1, std::memory_order_release);
+        SpinWait::notifyAll(round_epoch_);
+        for (auto& helper : helpers_) {
+            if (helper.joinable()) helper.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief 默认辅助线程数：硬件线程数减去调用线程
+     */
+    static size_t defaultHelperThreads() {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 0;
+    }
+
+    /**
+     * @brief 工作者总数（含调用线程）
+     */
+    size_t getWorkerCount() const { return queues_.size(); }
+
+    /**
+     * @brief 执行一轮任务，直到 total_tasks 个任务全部完成才返回
+     * @param roots 本轮初始就绪的任务
+     * @param total_tasks 本轮任务总数（含执行中产生的任务）
+     * @param executor 任务执行回调
+     */
+    void runRound(const std::vector<int>& roots, size_t total_tasks, Executor executor) {
+        if (total_tasks == 0) return;
+        executor_ = std::move(executor);
+        total_ = total_tasks;
+        completed_.store(0, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(queues_[0]->mtx);
+            for (int task : roots) queues_[0]->tasks.push_back(task);
+        }
+
+        if (!helpers_.empty()) {
+            // 所有辅助线程都已确认上一轮，此时在纪元上等待，清零确认计数不会与其竞争
+            finished_helpers_.store(0, std::memory_order_relaxed);
+            round_epoch_.fetch_add(1, std::memory_order_release);
+            SpinWait::notifyAll(round_epoch_);
+        }
+        workUntilRoundDone(0);
+
+        // 等待每个辅助线程都确认本轮（包括被唤醒较晚、尚未开始执行的线程），
+        // 之后才能安全地为下一轮改写 executor_ 和 total_
+        const size_t helpers = helpers_.size();
+        while (finished_helpers_.load(std::memory_order_acquire) != helpers) {
+            SpinWait::cpuRelax();
+            if (SpinWait::defaultSpinLimit() == 0) std::this_thread::yield();   // 单核：让出时间片给辅助线程
+        }
+    }
+
+    /**
+     * @brief 把新就绪的任务放入指定工作者的队列（在任务执行回调内调用）
+     */
+    void push(size_t worker, int task) {
+        std::lock_guard<std::mutex> lock(queues_[worker]->mtx);
+        queues_[worker]->tasks.push_back(task);
+    }
+
+private:
+    // 每个工作者的任务队列，按缓存行对齐避免伪共享
+    struct alignas(64) WorkerQueue {
+        std::mutex mtx;
+        std::deque<int> tasks;
+    };
+
+    void helperLoop(size_t index, uint32_t seen) {
+        ThreadNaming::set_current_thread_name("TaskGraphWorker" + std::to_string(index));
+        while (true) {
+            SpinWait::waitWhileEqual(round_epoch_, seen);
+            const uint32_t now = round_epoch_.load(std::memory_order_acquire);
+            if (now == seen) continue; // 虚假唤醒
+            seen = now;
+            if (shutdown_.load(std::memory_order_acquire)) return;
+
+            workUntilRoundDone(index);
+            finished_helpers_.fetch_add(1, std::memory_order_acq_rel);   // 确认本轮，此后不再读取本轮状态
+        }
+    }
+
+    // 执行本地任务或窃取任务，直到本轮全部完成
+    void workUntilRoundDone(size_t self) {
+        while (completed_.load(std::memory_order_acquire) < total_) {
+            int task;
+            if (popLocal(self, task) || steal(self, task)) {
+                executor_(task, self);
+                completed_.fetch_add(1, std::memory_order_acq_rel);
+            } else {
+                SpinWait::cpuRelax();
+                if (queues_.size() > 1 && SpinWait::defaultSpinLimit() == 0) std::this_thread::yield();
+            }
+        }
+    }
+
+    bool popLocal(size_t self, int& task) {
+        WorkerQueue& q = *queues_[self];
+        std::lock_guard<std::mutex> lock(q.mtx);
+        if (q.tasks.empty()) return false;
+        task = q.tasks.back();
+        q.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t self, int& task) {
+        const size_t n = queues_.size();
+        for (size_t k = 1; k < n; ++k) {
+            WorkerQueue& q = *queues_[(self + k) % n];
+            std::unique_lock<std::mutex> lock(q.mtx, std::try_to_lock);
+            if (!lock.owns_lock() || q.tasks.empty()) continue;
+            task = q.tasks.front();
+            q.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;  ///< 工作者队列，下标0为调用线程
+    std::vector<std::thread> helpers_;                  ///< 辅助线程
+    Executor executor_;                                 ///< 本轮任务执行回调
+    size_t total_ = 0;                                  ///< 本轮任务总数
+    std::atomic<size_t> completed_{0};                  ///< 本轮已完成任务数
+    std::atomic<uint32_t> round_epoch_{0};              ///< 每轮开始时翻转，辅助线程在其上等待
+    std::atomic<size_t> finished_helpers_{0};           ///< 已确认本轮的辅助线程数（每轮每个辅助线程恰好一次）
+    std::atomic<bool> shutdown_{false};
+};